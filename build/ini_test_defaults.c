@@ -0,0 +1,133 @@
+// Generated by ini2c from tests/defaults.ini. Do not edit.
+
+#include "ini_test_defaults.h"
+
+#ifdef INI_COMPACT_STRINGS
+    #define INI2C_PAIR_(k, v) { .key = k, .value = v, .key_length = sizeof(k) - 1, .value_length = sizeof(v) - 1 }
+    #define INI2C_NAME_(n) .name = n, .name_length = sizeof(n) - 1
+#else
+    #define INI2C_PAIR_(k, v) { .key = k, .value = v }
+    #define INI2C_NAME_(n) .name = n
+#endif
+#define INI2C_SECTION_(n, p, v, c) { INI2C_NAME_(n), .data = (INIData_t *)&ini_test_defaults, .pairs = (INIPair_t *)(p), .cache = (INICachedValue_t *)(v), .pair_count = c, .pair_allocation = c }
+#define INI2C_CACHED_(k, s, m, v) { .kind = INI_CACHED_##k, .status = INI_##s, .value.m = v }
+
+static const INIPair_t ini_test_defaults_pairs_0_[] =
+{
+    INI2C_PAIR_("device", "default"),
+    INI2C_PAIR_("volume", "0.75"),
+};
+
+static const INICachedValue_t ini_test_defaults_cache_0_[] =
+{
+    { .kind = INI_CACHED_BUSY },
+    INI2C_CACHED_(FLOAT, CONVERTED, f, 0xcp-4L),
+};
+
+static const INIPair_t ini_test_defaults_pairs_2_[] =
+{
+    INI2C_PAIR_("huge", "-99999999999999999999"),
+    INI2C_PAIR_("min", "-9223372036854775808"),
+    INI2C_PAIR_("zero", "-0"),
+};
+
+static const INICachedValue_t ini_test_defaults_cache_2_[] =
+{
+    INI2C_CACHED_(SIGNED, CONVERT_OVERFLOW, s, -9223372036854775807LL - 1),
+    INI2C_CACHED_(SIGNED, CONVERTED, s, -9223372036854775807LL - 1),
+    INI2C_CACHED_(SIGNED, CONVERTED, s, 0LL),
+};
+
+static const INIPair_t ini_test_defaults_pairs_3_[] =
+{
+    INI2C_PAIR_("fullscreen", "false"),
+    INI2C_PAIR_("height", "720"),
+    INI2C_PAIR_("title", "Hello, world\?"),
+    INI2C_PAIR_("width", "1280"),
+};
+
+static const INICachedValue_t ini_test_defaults_cache_3_[] =
+{
+    INI2C_CACHED_(BOOL, CONVERTED, b, false),
+    INI2C_CACHED_(SIGNED, CONVERTED, s, 720LL),
+    { .kind = INI_CACHED_BUSY },
+    INI2C_CACHED_(SIGNED, CONVERTED, s, 1280LL),
+};
+
+static const INISection_t ini_test_defaults_sections_[] =
+{
+    INI2C_SECTION_("audio", ini_test_defaults_pairs_0_, ini_test_defaults_cache_0_, 2),
+    INI2C_SECTION_("empty", NULL, NULL, 0),
+    INI2C_SECTION_("numbers", ini_test_defaults_pairs_2_, ini_test_defaults_cache_2_, 3),
+    INI2C_SECTION_("window", ini_test_defaults_pairs_3_, ini_test_defaults_cache_3_, 4),
+};
+
+static const INIIndexSlot_t ini_test_defaults_section_slots_[] =
+{
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0xed4dde8cf0d45559ull, 1, 0 },
+    { 0xcb4c21dc0c924ac9ull, 3, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x71f304ea62c01cbdull, 4, 0 },
+    { 0x904fefb3d01cb2aeull, 2, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+};
+
+static const INIIndexSlot_t ini_test_defaults_pair_slots_[] =
+{
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0xed1176715ae4d383ull, 1, 1 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x3747d0986d3162c5ull, 4, 3 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x7dd1fac35aba3027ull, 4, 2 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x8a6f7058567c774cull, 3, 2 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x498334e33367eeb6ull, 3, 1 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0xe0533c7f769f8519ull, 4, 4 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0xb6e47bae266aeedbull, 1, 2 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x0000000000000000ull, 0, 0 },
+    { 0x649e4c1f4060e91eull, 3, 3 },
+    { 0xae5e822099793f3eull, 4, 1 },
+};
+
+static const INIIndex_t ini_test_defaults_index_ =
+{
+    (INIIndexSlot_t *)ini_test_defaults_section_slots_, 16, 4,
+    (INIIndexSlot_t *)ini_test_defaults_pair_slots_, 32, 9,
+};
+
+const INIData_t ini_test_defaults =
+{
+    .sections = (INISection_t *)ini_test_defaults_sections_,
+    .section_count = 4,
+    .section_allocation = 4,
+    .index = (INIIndex_t *)&ini_test_defaults_index_,
+};
@@ -0,0 +1,11 @@
+// Generated by ini2c from tests/defaults.ini. Do not edit.
+
+#ifndef INI2C_ini_test_defaults_H
+#define INI2C_ini_test_defaults_H
+
+#include "ini.h"
+
+// Only for the query functions, never to be modified or free'd
+extern const INIData_t ini_test_defaults;
+
+#endif
@@ -24,16 +24,68 @@
 
 
 
+// For memfd_create() and file sealing
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+#endif
+
+
+
 #include "ini.h"
 
 
 
-#include <ctype.h>
+#include <errno.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+    #define INI_HAS_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(INI_HAS_MMAP) && defined(__linux__) && defined(MFD_ALLOW_SEALING)
+    #define INI_HAS_MEMFD
+#endif
+
+// Converted values are claimed and published with atomics
+#if defined(__GNUC__) || defined(__clang__)
+    #define INI_HAS_VALUE_CACHE
+#endif
+
+// Long doubles of more than 64 bits are rounded in a 128 bit integer
+#if LDBL_MANT_DIG > 64 && defined(__SIZEOF_INT128__)
+    #define INI_HAS_WIDE_MANTISSA
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define INI_HAS_DIRENT
+    #include <dirent.h>
+    #include <fnmatch.h>
+#endif
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(INI_NO_THREADS)
+    #define INI_HAS_THREADS
+    #include <pthread.h>
+#endif
+
+#if defined(__SSE2__) && !defined(INI_NO_SIMD)
+    #define INI_HAS_SSE2
+    #include <emmintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        #define INI_HAS_AVX2
+        #include <immintrin.h>
+    #endif
+#endif
+
 
 
 static void *(*ini_malloc_) (size_t) = INI_DEFAULT_ALLOC;
@@ -42,16 +94,497 @@ static void *(*ini_realloc_) (void *, size_t) = INI_DEFAULT_REALLOC;
 
 
 
+// Parser state for the readers that fill an INIData_t
+typedef struct
+{
+    INIData_t *data;
+    INIError_t *error;
+    uint64_t flags;
+    INISection_t *current_section;
+} INIReadState_t;
+
+
+
+// Contents kept alive for sections read with INI_LAZY_SECTIONS
+typedef struct INISource_t
+{
+    struct INISource_t *next;
+    const char *contents;
+    size_t length;
+    bool mapped;
+} INISource_t;
+
+
+
+// A piece of the memory an arena, or the strings of a database with
+// INI_COMPACT_STRINGS, are carved from
+typedef struct INIBlock_t
+{
+    struct INIBlock_t *next;
+    size_t used;
+    size_t size;
+    max_align_t bytes[];
+} INIBlock_t;
+
+
+
+// A pair of a frozen database. Strings are offsets into its string table
+// and null-terminated.
+typedef struct
+{
+    uint32_t section;
+    uint32_t section_length;
+    uint32_t key;
+    uint32_t key_length;
+    uint32_t value;
+} INIFrozenPair_t;
+
+// Frozen databases are a single allocation: this header, then the
+// displacements of the perfect hash, then the pairs in hash order, then
+// the strings. Opened compiled images keep those in the image instead.
+struct INIFrozen_t
+{
+    INIAllocator_t allocator;
+    uint64_t seed;
+    uint32_t pair_count;
+    const int32_t *displacements;
+    const INIFrozenPair_t *pairs;
+    const char *strings;
+    size_t strings_size;
+
+    // Mapping or allocation of the compiled image, NULL if frozen
+    void *image;
+    size_t image_length;
+    bool mapped;
+};
+
+
+
+// Start of a compiled image. Offsets are from the start of the image,
+// and the checksum covers everything following the header, which is
+// laid out like a frozen database.
+typedef struct
+{
+    char magic[4];
+    uint32_t byte_order;
+    uint32_t version;
+    uint32_t pair_count;
+    uint64_t seed;
+    uint64_t displacements;
+    uint64_t pairs;
+    uint64_t strings;
+    uint64_t size;
+    uint64_t checksum;
+} INICompiledHeader_t;
+
+
+
+// A line read from a file. Starts out in buffer and moves to the heap of
+// allocator once a line doesn't fit.
+typedef struct
+{
+    char *data;
+    size_t capacity;
+    const INIAllocator_t *allocator;
+    char buffer[INI_MAX_LINE_SIZE];
+} INIFileLine_t;
+
+
+
+// A decimal number on its way to binary, as its digits with the decimal
+// point before digit point, after the exact path of Go's strconv. Set if
+// nonzero digits past DECIMAL_DIGITS_ were dropped, making the number a
+// little more than its digits. The extra room is for the carries of a
+// left shift.
+#define DECIMAL_DIGITS_ 800
+typedef struct
+{
+    unsigned char digits[DECIMAL_DIGITS_ + 19];
+    int count;
+    int point;
+    bool truncated;
+} INIDecimal_t;
+
+// Set by decimal_to_binary_() and read_hex_float_() for numbers that only
+// round to zero. parse_float_() reports them as out of range.
+#define CONVERT_UNDERFLOW_ (INI_CONVERT_MISSING + 1)
+
+
+
+// A binary floating point type, with its exponents for values in [1, 2)
+typedef struct
+{
+    int mantissa_bits;
+    int min_exponent;
+    int max_exponent;
+} INIFloatFormat_t;
+
+// Holds the mantissa of any format parse_float_() rounds to
+#ifdef INI_HAS_WIDE_MANTISSA
+__extension__ typedef unsigned __int128 INIMantissa_t;
+#else
+typedef unsigned long long INIMantissa_t;
+#endif
+#define MANTISSA_BITS_ ((int)sizeof(INIMantissa_t) * CHAR_BIT)
+
+
+
+// Parser state for the callback-driven readers
+typedef struct
+{
+    const INICallbacks_t *callbacks;
+    void *user;
+    INIError_t *error;
+    uint64_t flags;
+    bool failed;
+    bool in_section;
+    INIView_t section;
+
+    // Where to keep the section name when lines don't outlive the
+    // next read, NULL if they do
+    char *section_buffer;
+
+    // Longest name, key or value accepted
+    size_t max_length;
+} INIStreamState_t;
+
+
+
+// Pairs counted under one section name by ini_measure_* functions, for
+// flags that merge sections appearing more than once. Names are only
+// kept as hashes, and ones that collide just count together.
+typedef struct
+{
+    uint64_t hash;
+    unsigned pairs;
+} INIMeasuredSection_t;
+
+
+
+// Where ini_measure_* functions are counting
+typedef struct
+{
+    INIMeasure_t *measure;
+    unsigned pairs;
+
+    // Hash table of every section so far when sections are merged, with
+    // the current one. It starts out in local and moves to the heap as it
+    // grows. If it can't, max_pairs falls back to total_pairs.
+    bool merge;
+    bool untracked;
+    INIMeasuredSection_t *sections;
+    INIMeasuredSection_t *current;
+    unsigned section_capacity;
+    unsigned section_count;
+    INIMeasuredSection_t local[32];
+} INIMeasureState_t;
+
+
+
+// A piece of a buffer being read on its own thread, into a database
+// made with allocator. Indexed when the database it's merged into is, as
+// the sections of a large chunk are otherwise checked for duplicates one
+// by one.
+typedef struct
+{
+    const char *begin;
+    const char *end;
+    uint64_t flags;
+    const INIAllocator_t *allocator;
+    bool indexed;
+    INIData_t *data;
+    bool failed;
+} INIChunk_t;
+
+
+
+// Files of a directory handed out to the threads reading them. Thread t
+// reads every stride-th file starting at t.
+typedef struct
+{
+    char **paths;
+    INIChunk_t *chunks;
+    unsigned count;
+    unsigned first;
+    unsigned stride;
+} INIFileWork_t;
+
+
+
+#ifdef INI_HAS_THREADS
+// The allocator of a database's own, shared by the threads reading into
+// it. They take turns, as it needn't be thread-safe.
+typedef struct
+{
+    const INIAllocator_t *allocator;
+    pthread_mutex_t lock;
+} INISharedAllocator_t;
+#endif
+
+
+
+// Hands out the lines of a buffer in order. Newlines are found 64 bytes
+// at a time where SSE2 is there, so short lines don't each pay for a call
+// to memchr().
+typedef struct
+{
+    const char *block;      // where the bits of newlines start
+    const char *end;
+    uint64_t newlines;      // those not handed out yet
+} INILines_t;
+
+
+
+// What a single line turned out to be
+typedef enum
+{
+    LINE_BLANK_,
+    LINE_SECTION_,
+    LINE_PAIR_,
+    LINE_INVALID_,
+} INILineType_t;
+
+typedef struct
+{
+    INILineType_t type;
+    INIView_t name;         // LINE_SECTION_
+    INIView_t key;          // LINE_PAIR_
+    INIView_t value;        // LINE_PAIR_
+    ptrdiff_t discrepancy;
+    const char *msg;        // LINE_INVALID_
+    bool header;            // LINE_INVALID_, meant as a section header
+} INILine_t;
+
+
+
+// Character classes, fixed to the C locale so parsing never depends on
+// setlocale(). The table is built entirely at compile time.
+enum
+{
+    CHAR_SPACE_       = 1 << 0, // isspace()
+    CHAR_NAME_START_  = 1 << 1, // first character of a key or section name
+    CHAR_KEY_         = 1 << 2,
+    CHAR_SECTION_     = 1 << 3,
+    CHAR_PLAIN_VALUE_ = 1 << 4, // value character other than a space
+};
+
+#define IS_ALPHA_(c) (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z'))
+#define IS_ALNUM_(c) (IS_ALPHA_(c) || ((c) >= '0' && (c) <= '9'))
+#define IS_SPACE_(c) ((c) == ' ' || ((c) >= '\t' && (c) <= '\r'))
+#define IS_VALUE_(c) ((c) >= 0x20 && (c) != 0x7f && (c) != '[' && (c) != ']' \
+                      && (c) != ';' && (c) != '#' && (c) != '"')
+
+#define CLASS_(c) (unsigned char)(                                        \
+    (IS_SPACE_(c)                             ? CHAR_SPACE_       : 0)  \
+  | (IS_ALPHA_(c) || (c) == '_'               ? CHAR_NAME_START_  : 0)  \
+  | (IS_ALNUM_(c) || (c) == '_'               ? CHAR_KEY_         : 0)  \
+  | (IS_ALNUM_(c) || (c) == '_' || (c) == ' ' ? CHAR_SECTION_     : 0)  \
+  | (IS_VALUE_(c) && (c) != ' '               ? CHAR_PLAIN_VALUE_ : 0))
+
+#define CLASS4_(c)  CLASS_(c), CLASS_((c) + 1), CLASS_((c) + 2), CLASS_((c) + 3)
+#define CLASS16_(c) CLASS4_(c), CLASS4_((c) + 4), CLASS4_((c) + 8), CLASS4_((c) + 12)
+#define CLASS64_(c) CLASS16_(c), CLASS16_((c) + 16), CLASS16_((c) + 32), CLASS16_((c) + 48)
+
+static const unsigned char char_classes_[256] = {
+    CLASS64_(0), CLASS64_(64), CLASS64_(128), CLASS64_(192)
+};
+
+#undef CLASS64_
+#undef CLASS16_
+#undef CLASS4_
+#undef CLASS_
+#undef IS_VALUE_
+#undef IS_SPACE_
+#undef IS_ALNUM_
+#undef IS_ALPHA_
+
+
+
 // Static helpers
-static void set_parse_error_(INIError_t *error, const char *line, ptrdiff_t offset, const char *msg);
+static INILineType_t lex_line_(const char *line, const char *end, size_t max_length, INILine_t *lexed);
+static bool read_line_(INIReadState_t *state, const char *line, size_t length);
+static bool read_lexed_line_(INIReadState_t *state, const char *line, size_t length, const INILine_t *lexed);
+static bool index_buffer_(INIReadState_t *state, const char *buffer, size_t length);
+static void load_section_(const INIData_t *data, INISection_t *section);
+static INISource_t *read_source_(const INIAllocator_t *allocator, FILE *file);
+static bool read_section_(INIReadState_t *state, const char *line, size_t length, const INILine_t *lexed);
+static bool read_pair_(INIReadState_t *state, const char *line, size_t length, const INILine_t *lexed);
+static const char *add_failure_(const INIData_t *data, uint64_t flags);
+static void init_line_(INIFileLine_t *line, const INIAllocator_t *allocator);
+static bool grow_line_(INIFileLine_t *line, size_t capacity);
+static size_t get_line_(FILE *file, INIFileLine_t *line);
+static void free_line_(INIFileLine_t *line);
+static bool stream_file_(FILE *file, const INICallbacks_t *callbacks, void *user, INIError_t *error, uint64_t flags, size_t max_length);
+static bool stream_buffer_(const char *buffer, size_t length, const INICallbacks_t *callbacks, void *user, INIError_t *error, uint64_t flags, size_t max_length);
+static bool stream_line_(INIStreamState_t *state, const char *line, size_t length);
+static bool measure_section_(void *user, INIView_t name);
+static INIMeasuredSection_t *find_measured_section_(INIMeasureState_t *state, uint64_t hash);
+static bool measure_pair_(void *user, INIView_t section, INIView_t key, INIView_t value);
+static void push_line_(INIParser_t *parser, const char *line, size_t length);
+#ifdef INI_HAS_THREADS
+static const char *find_chunk_split_(const char *begin, const char *c, const char *end);
+static void *read_chunk_(void *arg);
+static void *read_files_(void *arg);
+static bool read_files_parallel_(INIData_t *data, char **paths, unsigned count, unsigned nthreads, INIError_t *error, uint64_t flags, bool *failed);
+static int compare_names_(const void *a, const void *b);
+static bool chunks_share_sections_(const INIData_t *data, const INIChunk_t *chunks, unsigned count, bool *shared);
+static bool merge_chunks_(INIData_t *data, const INIChunk_t *chunks, unsigned count, INIError_t *error, uint64_t flags, bool *failed);
+static const INIAllocator_t *share_allocator_(const INIData_t *data, INISharedAllocator_t *shared, INIAllocator_t *locked);
+static void unshare_allocator_(const INIAllocator_t *locked, INISharedAllocator_t *shared);
+static void *shared_alloc_(void *ctx, size_t size);
+static void *shared_realloc_(void *ctx, void *ptr, size_t size);
+static void shared_free_(void *ctx, void *ptr);
+#endif
+static INISection_t *append_section_(INIData_t *data, INIView_t name, bool borrow);
+static INISection_t *find_section_(const INIData_t *data, INIView_t name);
+static INISection_t *find_hashed_section_(const INIData_t *data, INIView_t name, uint64_t hash);
+static bool set_key_(INISection_t *section, INIPair_t *pair, INIView_t key, bool borrow);
+static bool set_value_(INISection_t *section, INIPair_t *pair, INIView_t value, bool borrow);
+static bool name_equals_(const INISection_t *section, INIView_t name);
+static bool key_equals_(const INIPair_t *pair, INIView_t key);
+#ifdef INI_COMPACT_STRINGS
+static const char *keep_string_(INIData_t *data, INIView_t view, bool borrow);
+static const char *store_string_(INIData_t *data, INIView_t view);
+#endif
+static INIData_t *create_data_(const INIAllocator_t *allocator, unsigned sections, unsigned pairs_per_section);
+static uint64_t first_generation_(void);
+static void init_sections_(INIData_t *data, unsigned begin, unsigned end);
+static INIData_t *init_arena_(void *buffer, size_t size, bool fixed);
+static void *carve_(INIData_t *data, size_t size, size_t alignment);
+static void *grow_array_(INIData_t *data, void *array, size_t old_size, size_t new_size);
+#if defined(INI_HAS_THREADS) && defined(INI_COMPACT_STRINGS)
+static void adopt_blocks_(INIData_t *data, INIData_t *from);
+#endif
+static size_t align_up_(size_t n, size_t alignment);
+static void *allocate_(const INIAllocator_t *allocator, size_t size);
+static void *reallocate_(const INIAllocator_t *allocator, void *ptr, size_t size);
+static void deallocate_(const INIAllocator_t *allocator, void *ptr);
+static bool has_heap_(const INIAllocator_t *allocator);
+static bool reserve_pairs_(INISection_t *section, unsigned count);
+static bool grow_pooled_pairs_(INISection_t *section, unsigned count);
+#ifdef INI_HAS_VALUE_CACHE
+static void grow_cache_(INISection_t *section, unsigned count);
+#endif
+static void forget_value_(INISection_t *section, unsigned pair);
+static INIPair_t *lookup_pair_(const INIData_t *data, const char *section, const char *key, INISection_t **found_section);
+static int get_converted_(const INIData_t *data, const char *section, const char *key, unsigned char kind, INICachedValue_t *converted);
+static INIPair_t *lookup_keyed_(const INIData_t *data, const INIKey_t *key, INISection_t **found_section);
+static int get_keyed_(const INIData_t *data, const INIKey_t *key, unsigned char kind, INICachedValue_t *converted);
+static const INIPair_t *handle_pair_(const INIData_t *data, INIHandle_t *handle);
+static int get_handled_(const INIData_t *data, INIHandle_t *handle, unsigned char kind, INICachedValue_t *converted);
+static int convert_pair_(INISection_t *section, const INIPair_t *pair, unsigned char kind, INICachedValue_t *converted);
+#ifdef INI_HAS_VALUE_CACHE
+static bool derive_cached_(const INICachedValue_t *cache, unsigned char kind, INICachedValue_t *converted);
+#endif
+static int convert_stored_(const INIData_t *data, const INIPair_t *pair, unsigned char kind, INICachedValue_t *converted);
+static int convert_value_(const char *str, unsigned char kind, INICachedValue_t *converted);
+static int parse_integer_(const char *str, int base, bool is_signed, INICachedValue_t *converted);
+static bool binds_section_(const INIBinding_t *schema, unsigned count, const unsigned *slots, size_t capacity, INIView_t section, uint64_t seed);
+static const INIBinding_t *find_binding_(const INIBinding_t *schema, unsigned count, const unsigned *slots, size_t capacity, INIView_t section, INIView_t key, uint64_t seed);
+static int store_binding_(const INIBinding_t *binding, const INIData_t *data, const INIPair_t *pair, void *target);
+static void report_binding_(INIError_t *error, INIView_t section, INIView_t key, int status);
+static int parse_double_(const char *str, double *value);
+static int parse_long_double_(const char *str, long double *value);
+static int parse_float_(const char *str, const INIFloatFormat_t *format, long double *value);
+static const char *read_decimal_(const char *c, INIDecimal_t *decimal);
+static const char *read_hex_float_(const char *c, const INIFloatFormat_t *format, INIMantissa_t *mantissa, int *exponent, int *status);
+static INIMantissa_t take_bits_(unsigned long long high, unsigned long long low, long bit);
+static int decimal_to_binary_(INIDecimal_t *decimal, const INIFloatFormat_t *format, INIMantissa_t *mantissa, int *exponent);
+static void shift_decimal_(INIDecimal_t *decimal, int bits);
+static void shift_decimal_left_(INIDecimal_t *decimal, unsigned bits);
+static void shift_decimal_right_(INIDecimal_t *decimal, unsigned bits);
+static void trim_decimal_(INIDecimal_t *decimal);
+static INIMantissa_t round_decimal_(const INIDecimal_t *decimal, bool *carried);
+static bool eisel_lemire_(unsigned long long mantissa, long exponent, double *value);
+static unsigned long long multiply_(unsigned long long a, unsigned long long b, unsigned long long *low);
+static int leading_zeros_(unsigned long long n);
+static const unsigned long long *power_of_five_(int exponent);
+static bool starts_with_word_(const char *c, const char *word);
+static unsigned digit_value_(char c);
+static bool is_space_(char c);
+static void commit_pair_(INISection_t *section);
+static void index_section_(INIData_t *data, unsigned section);
+static void index_pair_(INIData_t *data, unsigned section, unsigned pair);
+static bool insert_slot_(const INIAllocator_t *allocator, INIIndexSlot_t **slots, size_t *capacity, size_t *count, INIIndexSlot_t slot);
+static uint64_t hash_name_(INIView_t name);
+static uint64_t hash_key_(unsigned section, uint64_t key_hash);
+static uint64_t hash_bytes_(const char *bytes, size_t length, uint64_t hash);
+static uint64_t hash_pair_(uint64_t seed, INIView_t section, INIView_t key);
+static uint64_t mix_(uint64_t hash);
+static unsigned drop_duplicates_(const INIData_t *data, INIIndexSlot_t *entries, unsigned count, bool *retry);
+static int compare_entries_(const void *a, const void *b);
+static INIFrozen_t *build_frozen_(const INIData_t *data, const INIIndexSlot_t *entries, unsigned count, uint64_t seed, bool *retry);
+static bool place_bucket_(const INIIndexSlot_t *entries, const uint32_t *members, uint32_t size, uint32_t count, uint32_t *owners, int32_t *displacement);
+static uint32_t frozen_slot_(uint64_t hash, const int32_t *displacements, uint32_t count);
+static uint32_t displace_(uint64_t hash, int32_t displacement, uint32_t count);
+static INIFrozen_t *freeze_image_(const INIData_t *data, INICompiledHeader_t *header, const char **body);
+static bool write_image_(const INIData_t *data, FILE *file);
+#ifdef INI_HAS_MMAP
+static INIFrozen_t *map_image_(int fd, bool shared);
+#endif
+static INIFrozen_t *open_image_(const char *contents, void *image, size_t length, bool mapped);
+static bool is_valid_image_(const INICompiledHeader_t *header, const char *image, size_t length);
+static uint64_t checksum_(const char *bytes, size_t length);
+static INIView_t name_view_(const INISection_t *section);
+static INIView_t key_view_(const INIPair_t *pair);
+static INIView_t value_view_(const INIPair_t *pair);
+static const char *terminated_value_(const INIData_t *data, const INIPair_t *pair);
+static unsigned long long to_unsigned_(const char *str, int base, unsigned long long default_value);
+static long long to_signed_(const char *str, long long default_value);
+static long double to_float_(const char *str, long double default_value);
+static bool to_bool_(const char *str, bool default_value);
+#ifdef INI_HAS_DIRENT
+static char **list_directory_(const INIAllocator_t *allocator, const char *dir, const char *pattern, unsigned *count);
+static void free_paths_(const INIAllocator_t *allocator, char **paths, unsigned count);
+static int compare_paths_(const void *a, const void *b);
+#endif
+static bool fail_line_(INIError_t *error, uint64_t flags, const char *line, size_t length, ptrdiff_t offset, const char *msg);
+static bool parse_section_(const char *line, const char *c, const char *end, size_t max_length, ptrdiff_t *discrepancy, INIView_t *name);
+static bool parse_key_(const char *line, const char *c, const char *end, size_t max_length, ptrdiff_t *discrepancy, INIView_t *key, const char **delimiter);
+static bool parse_value_(const char *line, const char *c, const char *end, size_t max_length, ptrdiff_t *discrepancy, INIView_t *value);
+static INIPair_t *reserve_pair_(INISection_t *section);
+static INIPair_t *find_pair_(const INISection_t *section, INIView_t key);
+static INIPair_t *find_hashed_pair_(const INISection_t *section, INIView_t key, uint64_t key_hash);
+static void copy_view_(char *dest, INIView_t view);
+static void set_parse_error_(INIError_t *error, const char *line, size_t length, ptrdiff_t offset, const char *msg);
 static void clear_parse_error_(INIError_t *error);
-static bool contains_consecutive_spaces_(const char *str);
-static const char *skip_ignored_characters_(const char *c);
+static bool contains_consecutive_spaces_(INIView_t str);
+static char peek_(const char *c, const char *end);
+static const char *scan_value_(const char *c, const char *end, bool quoted);
+static const char *scan_key_(const char *c, const char *end);
+static const char *scan_value_scalar_(const char *c, const char *end, bool quoted);
+static const char *scan_key_scalar_(const char *c, const char *end);
+#ifdef INI_HAS_SSE2
+static __m128i in_range_sse2_(__m128i v, char low, char high);
+static const char *scan_value_sse2_(const char *c, const char *end, bool quoted);
+static const char *scan_key_sse2_(const char *c, const char *end);
+#endif
+#ifdef INI_HAS_AVX2
+static __m256i in_range_avx2_(__m256i v, char low, char high);
+static const char *scan_value_avx2_(const char *c, const char *end, bool quoted);
+static const char *scan_key_avx2_(const char *c, const char *end);
+static void resolve_scanners_(void);
+#endif
+static bool is_plain_value_character_(char c);
+static bool has_class_(char c, unsigned char_class);
+static const char *skip_ignored_characters_(const char *c, const char *end);
+static void init_lines_(INILines_t *lines, const char *buffer, const char *end);
+static const char *next_line_(INILines_t *lines, const char *c);
+#ifdef INI_HAS_SSE2
+static uint64_t find_newlines_(const char *c, const char *end);
+#endif
 static bool is_valid_section_starting_character_(char c);
 static bool is_valid_section_character_(char c);
 static bool is_valid_key_starting_value_(char c);
 static bool is_valid_key_character_(char c);
-static bool is_valid_value_character_(char c);
+
+
+
+// The widest scanners the CPU has, for runs of 32 bytes and more
+#ifdef INI_HAS_SSE2
+static const char *(*scan_value_wide_)(const char *, const char *, bool) = scan_value_sse2_;
+static const char *(*scan_key_wide_)(const char *, const char *) = scan_key_sse2_;
+#endif
 
 
 
@@ -88,12 +621,61 @@ void ini_set_reallocator(void *(*reallocator) (void *,size_t))
 #ifdef INI_TEST
     #undef INI_INITIAL_ALLOCATED_SECTIONS
     #undef INI_INITIAL_ALLOCATED_PAIRS
+    #undef INI_MIN_PARALLEL_CHUNK
     #define INI_INITIAL_ALLOCATED_SECTIONS 1
     #define INI_INITIAL_ALLOCATED_PAIRS 1
+    #define INI_MIN_PARALLEL_CHUNK 1
+    #undef INI_STRING_BLOCK_SIZE
+    #define INI_STRING_BLOCK_SIZE 32
+    #undef INI_ARENA_BLOCK_SIZE
+    #define INI_ARENA_BLOCK_SIZE 1024
+#endif
+
+
+
+// Seeds ini_freeze() tries, and displacements it tries per bucket of the
+// perfect hash
+#define FROZEN_ATTEMPTS_ 16
+#define FROZEN_DISPLACEMENTS_ (1 << 16)
+
+// Bump the version whenever the layout of compiled images changes
+#define COMPILED_MAGIC_ "INIC"
+#define COMPILED_BYTE_ORDER_ 0x01020304u
+#define COMPILED_VERSION_ 1
+
+
+
+// Where the first block of an arena starts, following its INIData_t
+#define ARENA_BLOCK_OFFSET_ align_up_(sizeof(INIData_t), _Alignof(max_align_t))
+
+
+
+// Flags that leave a database pointing into the contents it was read
+// from, which the file readers then keep alive for it
+#ifdef INI_COMPACT_STRINGS
+    #define KEEPS_CONTENTS_ (INI_LAZY_SECTIONS | INI_BORROW_STRINGS)
+#else
+    #define KEEPS_CONTENTS_ INI_LAZY_SECTIONS
+#endif
+
+
+
+// Longest name, key or value the parser accepts
+#ifdef INI_COMPACT_STRINGS
+    #define STRING_LIMIT_ SIZE_MAX
+#else
+    #define STRING_LIMIT_ (INI_MAX_STRING_SIZE - 1)
 #endif
 
 
 
+// What ini_bind() reports keys its schema doesn't name, and borrowed
+// values bound as strings, as, past the INI_CONVERT_* outcomes
+#define UNKNOWN_KEY_  (INI_CONVERT_MISSING + 1)
+#define UNTERMINATED_ (INI_CONVERT_MISSING + 2)
+
+
+
 INIData_t *ini_read_file_path(const char *path, INIData_t *data, INIError_t *error, uint64_t flags){
     if (!path || !data) return NULL;
     clear_parse_error_(error);
@@ -101,7 +683,7 @@ INIData_t *ini_read_file_path(const char *path, INIData_t *data, INIError_t *err
     FILE *file = fopen(path,"r");
     if(!file)
     {
-        set_parse_error_(error, path, 0, "Could not open file");
+        set_parse_error_(error, path, strlen(path), 0, "Could not open file");
         return NULL;
     }
     data = ini_read_file_pointer(file, data, error, flags);
@@ -111,663 +693,5397 @@ INIData_t *ini_read_file_path(const char *path, INIData_t *data, INIError_t *err
 
 
 
-INIData_t *ini_read_file_pointer(FILE *file, INIData_t *data, INIError_t *error, uint64_t flags)
+INIData_t *ini_map_file_path(const char *path, INIData_t *data, INIError_t *error, const uint64_t flags)
 {
-    if (!file || !data) return NULL;
+#ifdef INI_HAS_MMAP
+    if (!path || !data) return NULL;
     clear_parse_error_(error);
 
-    char line[INI_MAX_LINE_SIZE];
-    INISection_t *current_section = NULL;
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        set_parse_error_(error, path, strlen(path), 0, "Could not open file");
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        set_parse_error_(error, path, strlen(path), 0, "Could not stat file");
+        return NULL;
+    }
 
-    while (fgets(line, INI_MAX_LINE_SIZE, file))
+    // Pipes, devices and files like those in /proc report no size or
+    // can't be mapped at all, so they're read through stdio
+    if (!S_ISREG(info.st_mode))
     {
+        FILE *file = fdopen(fd, "r");
+        if (!file)
+        {
+            close(fd);
+            set_parse_error_(error, path, strlen(path), 0, "Could not open file");
+            return NULL;
+        }
+        data = ini_read_file_pointer(file, data, error, flags);
+        fclose(file);
+        return data;
+    }
 
-        ptrdiff_t discrepancy_offset = 0;
-        INIPair_t pair;
-        INISection_t dest_section;
+    // Zero-length mappings are an error, but an empty file is a valid ini
+    const size_t length = (size_t)info.st_size;
+    if (length == 0)
+    {
+        close(fd);
+        return data;
+    }
 
-        if (ini_is_blank_line(line)) continue;
+    void *contents = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (contents == MAP_FAILED)
+    {
+        set_parse_error_(error, path, strlen(path), 0, "Could not map file");
+        return NULL;
+    }
+    madvise(contents, length, MADV_SEQUENTIAL);
 
-        if (ini_parse_pair(line, &pair, &discrepancy_offset))
-        {
-            if (!current_section)
-            {
-                if (flags & INI_CONTINUE_PAST_ERROR) continue;
-                set_parse_error_(error, line, discrepancy_offset, "Pairs must reside within a section.");
-                return NULL;
-            }
+    // Lazily read sections and borrowed strings point into the mapping,
+    // so it's kept until the database is freed
+    INISource_t *source = (flags & KEEPS_CONTENTS_) && has_heap_(&data->allocator) ? allocate_(&data->allocator, sizeof(INISource_t)) : NULL;
+    if (source)
+    {
+        *source = (INISource_t){ data->sources, contents, length, true };
+        data->sources = source;
+        return ini_read_buffer(contents, length, data, error, flags);
+    }
 
-            for (size_t i = 0; i < current_section->pair_count; i++)
-                if (strcmp(current_section->pairs[i].key, pair.key) == 0)
-                {
-                    if (flags & INI_DUPLICATE_KEYS_OVERWRITE)
-                        current_section->pairs[i] = pair;
-                    else if (flags & INI_CONTINUE_PAST_ERROR)
-                        continue;
-                    else
-                    {
-                        set_parse_error_(error, line, 0, "Duplicate key in section.");
-                        return NULL;
-                    }
-                }
+    data = ini_read_buffer(contents, length, data, error, flags & ~(INI_LAZY_SECTIONS | INI_BORROW_STRINGS));
+    munmap(contents, length);
+    return data;
+#else
+    return ini_read_file_path(path, data, error, flags);
+#endif
+}
 
-            if (!ini_add_pair_to_section(current_section, pair))
-            {
-                if (flags & INI_CONTINUE_PAST_ERROR) continue;
 
-                char buffer[INI_MAX_LINE_SIZE];
-                snprintf(buffer,
-                    INI_MAX_LINE_SIZE,
-                    "Failed to add pair '%s=%s' to section '%s'. Possibly insufficient allocation space.",
-                    pair.key, pair.value, current_section->name);
-                set_parse_error_(error, line, discrepancy_offset, buffer);
 
-                return NULL;
-            }
-        }
+INIData_t *ini_read_file_pointer(FILE *file, INIData_t *data, INIError_t *error, uint64_t flags)
+{
+    if (!file || !data) return NULL;
+    clear_parse_error_(error);
 
-        else if (line[discrepancy_offset] != '[')
+    if ((flags & KEEPS_CONTENTS_) && has_heap_(&data->allocator))
+    {
+        INISource_t *source = read_source_(&data->allocator, file);
+        if (!source)
         {
-            if (flags & INI_CONTINUE_PAST_ERROR) continue;
-            set_parse_error_(error, line, discrepancy_offset, "Failed to parse pair.");
+            set_parse_error_(error, "", 0, 0, "Could not read file");
             return NULL;
         }
+        source->next = data->sources;
+        data->sources = source;
+        return ini_read_buffer(source->contents, source->length, data, error, flags);
+    }
+
+    // Lines don't outlive the next read, so nothing can point into them
+    INIReadState_t state = { data, error, flags & ~(INI_LAZY_SECTIONS | INI_BORROW_STRINGS), NULL };
+    INIFileLine_t line;
+    init_line_(&line, &data->allocator);
 
-        else if (ini_parse_section(line, &dest_section, &discrepancy_offset))
+    INIData_t *result = data;
+    size_t length;
+    while ((length = get_line_(file, &line)) != 0)
+    {
+        if (length == SIZE_MAX)
         {
-            INISection_t *existing_section = ini_has_section(data, dest_section.name);
-            if (existing_section)
-            {
-                if (flags & (INI_ALLOW_DUPLICATE_SECTIONS | INI_CONTINUE_PAST_ERROR))
-                    current_section = existing_section;
-                else
-                {
-                    char buffer[INI_MAX_LINE_SIZE];
-                    snprintf(buffer, INI_MAX_LINE_SIZE, "Duplicate section '%s'.", dest_section.name);
-                    set_parse_error_(error, line, discrepancy_offset, buffer);
-                    return NULL;
-                }
-            }
-            else
-            {
-                current_section = ini_add_section(data, dest_section.name);
-                if (!current_section)
-                {
-                    char buffer[INI_MAX_LINE_SIZE];
-                    snprintf(buffer,
-                        INI_MAX_LINE_SIZE,
-                        "Failed to add section '%s' to database. Possibly insufficient allocation space.",
-                        dest_section.name);
-                    set_parse_error_(error, line, discrepancy_offset, buffer);
-                    return NULL;
-                }
-            }
+            set_parse_error_(error, line.data, line.capacity - 1, (ptrdiff_t)line.capacity - 1, "Line too long.");
+            result = NULL;
+            break;
         }
-
-        else
+        if (!read_line_(&state, line.data, length))
         {
-            set_parse_error_(error, line, discrepancy_offset, "Failed to parse section.");
-            return NULL;
+            result = NULL;
+            break;
         }
     }
+
+    free_line_(&line);
+    return result;
+}
+
+
+
+INIData_t *ini_read_buffer(const char *buffer, const size_t length, INIData_t *data, INIError_t *error, const uint64_t flags)
+{
+    if (!buffer || !data) return NULL;
+    clear_parse_error_(error);
+
+    INIReadState_t state = { data, error, flags, NULL };
+#ifdef INI_COMPACT_STRINGS
+    if (flags & INI_BORROW_STRINGS)
+        data->borrowed = true;
+#endif
+
+    if (flags & INI_LAZY_SECTIONS)
+    {
+        data->flags = flags;
+        return index_buffer_(&state, buffer, length) ? data : NULL;
+    }
+
+    const char *c = buffer;
+    const char *end = buffer + length;
+    INILines_t lines;
+    init_lines_(&lines, buffer, end);
+
+    while (c < end)
+    {
+        const char *next = next_line_(&lines, c);
+        if (!read_line_(&state, c, (size_t)(next - c)))
+            return NULL;
+        c = next;
+    }
+
     return data;
 }
 
 
 
-void ini_write_file_path(const char *path, const INIData_t *data)
+INIData_t *ini_read_buffer_parallel(const char *buffer, const size_t length, unsigned nthreads, INIData_t *data, INIError_t *error, const uint64_t flags)
 {
-    if (!path || !data) return;
-    
-    FILE *file = fopen(path,"w");
-    if (!file) return;
-    ini_write_file_pointer(file, data);
-    fclose(file);
+    if (!buffer || !data) return NULL;
+
+    // Don't bother splitting up small contents
+    if (nthreads > length / INI_MIN_PARALLEL_CHUNK)
+        nthreads = (unsigned)(length / INI_MIN_PARALLEL_CHUNK);
+    if (nthreads > INI_MAX_PARALLEL_THREADS)
+        nthreads = INI_MAX_PARALLEL_THREADS;
+
+#ifdef INI_HAS_THREADS
+    if (nthreads < 2 || !has_heap_(&data->allocator) || (flags & INI_LAZY_SECTIONS) || data->fixed)
+        return ini_read_buffer(buffer, length, data, error, flags);
+    clear_parse_error_(error);
+
+    INISharedAllocator_t shared;
+    INIAllocator_t locked;
+    const INIAllocator_t *allocator = share_allocator_(data, &shared, &locked);
+
+    INIChunk_t chunks[INI_MAX_PARALLEL_THREADS];
+    pthread_t threads[INI_MAX_PARALLEL_THREADS];
+    bool joinable[INI_MAX_PARALLEL_THREADS] = { false };
+
+    const char *end = buffer + length;
+    const char *begin = buffer;
+    for (unsigned i = 0; i < nthreads; i++)
+    {
+        const char *split = i + 1 < nthreads ? find_chunk_split_(begin, buffer + length / nthreads * (i + 1), end) : end;
+        chunks[i] = (INIChunk_t){ begin, split, flags, allocator, data->index != NULL, NULL, false };
+        begin = split;
+    }
+
+    // The calling thread takes the first chunk itself
+    for (unsigned i = 1; i < nthreads; i++)
+        joinable[i] = pthread_create(&threads[i], NULL, read_chunk_, &chunks[i]) == 0;
+    read_chunk_(&chunks[0]);
+    for (unsigned i = 1; i < nthreads; i++)
+    {
+        if (joinable[i]) pthread_join(threads[i], NULL);
+        else read_chunk_(&chunks[i]);
+    }
+
+    bool failed = false;
+#ifdef INI_COMPACT_STRINGS
+    if (flags & INI_BORROW_STRINGS)
+        data->borrowed = true;
+#endif
+    const bool merged = merge_chunks_(data, chunks, nthreads, error, flags, &failed);
+    for (unsigned i = 0; i < nthreads; i++)
+        ini_free_data(chunks[i].data);
+    unshare_allocator_(allocator, &shared);
+
+    if (merged) return failed ? NULL : data;
+
+    // Anything that could end in an error is left to the sequential reader
+    // so the error and the state data is left in are exactly the same
+    return ini_read_buffer(buffer, length, data, error, flags);
+#else
+    (void)nthreads;
+    return ini_read_buffer(buffer, length, data, error, flags);
+#endif
 }
 
 
 
-void ini_write_file_pointer(FILE *file, const INIData_t *data)
+INIData_t *ini_read_directory(const char *dir, const char *pattern, unsigned nthreads, INIData_t *data, INIError_t *error, const uint64_t flags)
 {
-    if (!file || !data) return;
+#ifdef INI_HAS_DIRENT
+    if (!dir || !data) return NULL;
+    clear_parse_error_(error);
 
-    for (unsigned i = 0; i < data->section_count; i++)
+    unsigned count = 0;
+    char **paths = list_directory_(&data->allocator, dir, pattern ? pattern : "*", &count);
+    if (!paths)
     {
-        const INISection_t *section = &data->sections[i];
-        fprintf(file, "[%s]\n", section->name);
-        for (unsigned j = 0; j < section->pair_count; j++)
+        set_parse_error_(error, dir, strlen(dir), 0, "Could not read directory");
+        return NULL;
+    }
+
+    if (nthreads > count)
+        nthreads = count;
+    if (nthreads > INI_MAX_PARALLEL_THREADS)
+        nthreads = INI_MAX_PARALLEL_THREADS;
+
+#ifdef INI_HAS_THREADS
+    // Lazily read sections and borrowed strings would point into the
+    // contents of the per-file databases, so those are read straight into
+    // data. A fixed arena couldn't take the blocks of the per-file
+    // databases over.
+    if (nthreads > 1 && !(flags & KEEPS_CONTENTS_) && !data->fixed)
+    {
+        bool failed = false;
+        if (read_files_parallel_(data, paths, count, nthreads, error, flags, &failed))
         {
-            if (contains_consecutive_spaces_(section->pairs[j].value))
-                fprintf(file, "%s=\"%s\"\n", section->pairs[j].key, section->pairs[j].value);
-            else
-                fprintf(file, "%s=%s\n", section->pairs[j].key, section->pairs[j].value);
+            free_paths_(&data->allocator, paths, count);
+            return failed ? NULL : data;
         }
     }
+#endif
+
+    // Reading one after the other is what merging the files in parallel
+    // mimics, errors included
+    INIData_t *result = data;
+    for (unsigned i = 0; i < count && result; i++)
+        result = ini_read_file_path(paths[i], data, error, flags);
+
+    free_paths_(&data->allocator, paths, count);
+    return result;
+#else
+    (void)pattern;
+    (void)flags;
+    (void)nthreads;
+    if (!dir || !data) return NULL;
+    set_parse_error_(error, dir, strlen(dir), 0, "Reading directories isn't supported on this platform");
+    return NULL;
+#endif
 }
 
 
 
-INISection_t *ini_add_section(INIData_t *data, const char *name)
+bool ini_stream_file_path(const char *path, const INICallbacks_t *callbacks, void *user, INIError_t *error, const uint64_t flags)
 {
-    if (!data || !name) return NULL;
-    if (ini_has_section(data, name)) return NULL;
+    if (!path || !callbacks) return false;
+    clear_parse_error_(error);
 
-    if (data->section_count >= data->section_allocation)
+    FILE *file = fopen(path, "r");
+    if (!file)
     {
-        if (!ini_realloc_) return NULL;
-        data->section_allocation *= 2;
-        INISection_t *re = ini_realloc_(data->sections, sizeof(INISection_t) * data->section_allocation);
-        if (!re) return NULL;
-        data->sections = re;
-        for (unsigned i = data->section_count; i < data->section_allocation; i++)
-        {
-            if (ini_malloc_)
-                data->sections[i].pairs = ini_malloc_(sizeof(INIPair_t) * INI_INITIAL_ALLOCATED_PAIRS);
-            data->sections[i].pair_allocation = INI_INITIAL_ALLOCATED_PAIRS;
-
-        }
+        set_parse_error_(error, path, strlen(path), 0, "Could not open file");
+        return false;
     }
-    INISection_t *section = &data->sections[data->section_count++];
-    section->pair_count = 0;
-    memset(section->name, 0, INI_MAX_STRING_SIZE);
-    strncpy(section->name, name, INI_MAX_STRING_SIZE - 1);
-    return section;
+    const bool parsed = ini_stream_file_pointer(file, callbacks, user, error, flags);
+    fclose(file);
+    return parsed;
 }
 
 
 
-INIPair_t *ini_add_pair(const INIData_t *data, const char *section, const INIPair_t pair)
+bool ini_stream_file_pointer(FILE *file, const INICallbacks_t *callbacks, void *user, INIError_t *error, const uint64_t flags)
 {
-    INISection_t *existing_section = ini_has_section(data, section);
-    if (!existing_section) return NULL;
-    return ini_add_pair_to_section(existing_section, pair);
+    if (!file || !callbacks) return false;
+    clear_parse_error_(error);
+    return stream_file_(file, callbacks, user, error, flags, SIZE_MAX);
 }
 
 
 
-INIPair_t *ini_add_pair_to_section(INISection_t *section, const INIPair_t pair)
+bool ini_stream_buffer(const char *buffer, const size_t length, const INICallbacks_t *callbacks, void *user, INIError_t *error, const uint64_t flags)
+{
+    if (!buffer || !callbacks) return false;
+    clear_parse_error_(error);
+    return stream_buffer_(buffer, length, callbacks, user, error, flags, SIZE_MAX);
+}
+
+
+
+bool ini_measure_file_path(const char *path, INIMeasure_t *measure, INIError_t *error, const uint64_t flags)
+{
+    if (!path || !measure) return false;
+    clear_parse_error_(error);
+
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        set_parse_error_(error, path, strlen(path), 0, "Could not open file");
+        return false;
+    }
+    const bool measured = ini_measure_file_pointer(file, measure, error, flags);
+    fclose(file);
+    return measured;
+}
+
+
+
+bool ini_measure_file_pointer(FILE *file, INIMeasure_t *measure, INIError_t *error, const uint64_t flags)
+{
+    if (!file || !measure) return false;
+    clear_parse_error_(error);
+
+    const INICallbacks_t callbacks = { measure_section_, measure_pair_ };
+    INIMeasureState_t state = { .measure = measure, .merge = (flags & (INI_ALLOW_DUPLICATE_SECTIONS | INI_CONTINUE_PAST_ERROR)) != 0 };
+    state.sections = state.local;
+    state.section_capacity = sizeof(state.local) / sizeof(*state.local);
+    *measure = (INIMeasure_t){ 0, 0, 0, 0 };
+    const bool measured = stream_file_(file, &callbacks, &state, error, flags, STRING_LIMIT_);
+    if (state.sections != state.local) deallocate_(NULL, state.sections);
+    return measured;
+}
+
+
+
+bool ini_measure_buffer(const char *buffer, const size_t length, INIMeasure_t *measure, INIError_t *error, const uint64_t flags)
+{
+    if (!buffer || !measure) return false;
+    clear_parse_error_(error);
+
+    const INICallbacks_t callbacks = { measure_section_, measure_pair_ };
+    INIMeasureState_t state = { .measure = measure, .merge = (flags & (INI_ALLOW_DUPLICATE_SECTIONS | INI_CONTINUE_PAST_ERROR)) != 0 };
+    state.sections = state.local;
+    state.section_capacity = sizeof(state.local) / sizeof(*state.local);
+    *measure = (INIMeasure_t){ 0, 0, 0, 0 };
+    const bool measured = stream_buffer_(buffer, length, &callbacks, &state, error, flags, STRING_LIMIT_);
+    if (state.sections != state.local) deallocate_(NULL, state.sections);
+    return measured;
+}
+
+
+
+INIParser_t *ini_parser_create(INIData_t *data, const INICallbacks_t *callbacks, void *user, INIError_t *error, const uint64_t flags)
+{
+    const INIAllocator_t *allocator = data ? &data->allocator : NULL;
+    INIParser_t *parser = allocate_(allocator, sizeof(INIParser_t));
+    if (!parser) return NULL;
+
+    parser->allocator = allocator ? *allocator : (INIAllocator_t){ NULL, NULL, NULL, NULL };
+    if (!ini_parser_init(parser, data, callbacks, user, error, flags))
+    {
+        ini_parser_free(parser);
+        return NULL;
+    }
+    return parser;
+}
+
+
+
+void ini_parser_free(INIParser_t *parser)
+{
+    if (parser) deallocate_(&parser->allocator, parser);
+}
+
+
+
+bool ini_parser_init(INIParser_t *parser, INIData_t *data, const INICallbacks_t *callbacks, void *user, INIError_t *error, const uint64_t flags)
+{
+    if (!parser || (!data == !callbacks)) return false;
+    clear_parse_error_(error);
+
+    parser->data = data;
+    parser->callbacks = callbacks;
+    parser->user = user;
+    parser->error = error;
+    parser->flags = flags;
+    parser->current_section = NULL;
+    parser->in_section = false;
+    parser->section_length = 0;
+    parser->line_length = 0;
+    parser->done = false;
+    parser->failed = false;
+    return true;
+}
+
+
+
+bool ini_parser_feed(INIParser_t *parser, const char *bytes, const size_t n)
+{
+    if (!parser || (!bytes && n)) return false;
+
+    const char *c = bytes;
+    const char *end = bytes + n;
+
+    while (!parser->done && c < end)
+    {
+        const char *newline = memchr(c, '\n', (size_t)(end - c));
+        const char *next = newline ? newline + 1 : end;
+
+        // Lines that arrive whole are parsed where they are, only lines
+        // split across chunks are collected in the parser
+        if (!parser->line_length && newline)
+            push_line_(parser, c, (size_t)(next - c));
+        else
+        {
+            // Past the end of the buffer the line is only counted so
+            // it can be reported as too long once it's complete
+            const size_t taken = (size_t)(next - c);
+            if (parser->line_length < INI_MAX_LINE_SIZE)
+            {
+                const size_t room = INI_MAX_LINE_SIZE - parser->line_length;
+                memcpy(parser->line + parser->line_length, c, taken < room ? taken : room);
+            }
+            parser->line_length += taken;
+
+            if (newline)
+            {
+                push_line_(parser, parser->line, parser->line_length);
+                parser->line_length = 0;
+            }
+        }
+
+        c = next;
+    }
+
+    return !parser->failed;
+}
+
+
+
+bool ini_parser_finish(INIParser_t *parser)
+{
+    if (!parser) return false;
+
+    if (!parser->done && parser->line_length)
+        push_line_(parser, parser->line, parser->line_length);
+
+    parser->line_length = 0;
+    parser->done = true;
+    return !parser->failed;
+}
+
+
+
+void ini_write_file_path(const char *path, const INIData_t *data)
+{
+    if (!path || !data) return;
+    
+    FILE *file = fopen(path,"w");
+    if (!file) return;
+    ini_write_file_pointer(file, data);
+    fclose(file);
+}
+
+
+
+void ini_write_file_pointer(FILE *file, const INIData_t *data)
+{
+    if (!file || !data) return;
+
+    for (unsigned i = 0; i < data->section_count; i++)
+    {
+        INISection_t *section = &data->sections[i];
+        load_section_(data, section);
+        const INIView_t name = name_view_(section);
+        fprintf(file, "[%.*s]\n", (int)name.length, name.data);
+        for (unsigned j = 0; j < section->pair_count; j++)
+        {
+            const INIView_t key = key_view_(&section->pairs[j]);
+            const INIView_t value = value_view_(&section->pairs[j]);
+            if (contains_consecutive_spaces_(value))
+                fprintf(file, "%.*s=\"%.*s\"\n", (int)key.length, key.data, (int)value.length, value.data);
+            else
+                fprintf(file, "%.*s=%.*s\n", (int)key.length, key.data, (int)value.length, value.data);
+        }
+    }
+}
+
+
+
+INISection_t *ini_add_section(INIData_t *data, const char *name)
+{
+    if (!data || !name) return NULL;
+    if (ini_has_section(data, name)) return NULL;
+    return append_section_(data, (INIView_t){ name, strlen(name) }, false);
+}
+
+
+
+INIPair_t *ini_add_pair(const INIData_t *data, const char *section, const INIPair_t pair)
+{
+    INISection_t *existing_section = ini_has_section(data, section);
+    if (!existing_section) return NULL;
+    return ini_add_pair_to_section(existing_section, pair);
+}
+
+
+
+INIPair_t *ini_add_pair_to_section(INISection_t *section, const INIPair_t pair)
+{
+    INIPair_t *new_pair = reserve_pair_(section);
+    if (!new_pair) return NULL;
+
+#ifdef INI_COMPACT_STRINGS
+    // Pairs from ini_parse_pair() are views delimited by their lengths
+    if (!pair.key || !pair.value) return NULL;
+    const size_t key_length = pair.key_length ? pair.key_length : strlen(pair.key);
+    const size_t value_length = pair.value_length ? pair.value_length : strlen(pair.value);
+    if (!set_key_(section, new_pair, (INIView_t){ pair.key, key_length }, false)
+    ||  !set_value_(section, new_pair, (INIView_t){ pair.value, value_length }, false))
+        return NULL;
+#else
+    *new_pair = pair;
+#endif
+    commit_pair_(section);
+    return new_pair;
+}
+
+
+
+bool ini_enable_index(INIData_t *data)
+{
+    if (!data) return false;
+    if (data->index) return true;
+
+    data->index = allocate_(&data->allocator, sizeof(INIIndex_t));
+    if (!data->index) return false;
+    *data->index = (INIIndex_t){ NULL, 0, 0, NULL, 0, 0 };
+
+    // Pairs of sections that haven't been loaded yet are indexed once
+    // they are
+    for (unsigned i = 0; i < data->section_count && data->index; i++)
+    {
+        index_section_(data, i);
+        for (unsigned j = 0; j < data->sections[i].pair_count && data->index; j++)
+            index_pair_(data, i, j);
+    }
+    return data->index != NULL;
+}
+
+
+
+void ini_disable_index(INIData_t *data)
+{
+    if (!data || !data->index) return;
+
+    deallocate_(&data->allocator, data->index->sections);
+    deallocate_(&data->allocator, data->index->pairs);
+    deallocate_(&data->allocator, data->index);
+    data->index = NULL;
+}
+
+
+
+INISection_t *ini_has_section(const INIData_t *data, const char *section)
+{
+    if (!data || !section || !data->sections) return NULL;
+    return find_section_(data, (INIView_t){ section, strlen(section) });
+}
+
+
+
+const char *ini_get_value(const INIData_t *data, const char *section, const char *key)
+{
+    INISection_t *found_section;
+    return terminated_value_(data, lookup_pair_(data, section, key, &found_section));
+}
+
+
+
+INIView_t ini_get_view(const INIData_t *data, const char *section, const char *key)
+{
+    INISection_t *found_section;
+    const INIPair_t *pair = lookup_pair_(data, section, key, &found_section);
+    return pair ? value_view_(pair) : (INIView_t){ NULL, 0 };
+}
+
+
+
+const char *ini_get_string(const INIData_t *data, const char *section, const char *key, const char *default_value)
+{
+    const char *str = ini_get_value(data, section, key);
+    if (!str) return default_value;
+    return str;
+}
+
+
+
+unsigned long long ini_get_unsigned(const INIData_t *data, const char *section, const char *key, const unsigned long long default_value)
+{
+    INICachedValue_t converted;
+    return get_converted_(data, section, key, INI_CACHED_UNSIGNED, &converted) < INI_CONVERT_INVALID ? converted.value.u : default_value;
+}
+
+
+
+long long ini_get_signed(const INIData_t *data, const char *section, const char *key, const long long default_value)
+{
+    INICachedValue_t converted;
+    return get_converted_(data, section, key, INI_CACHED_SIGNED, &converted) < INI_CONVERT_INVALID ? converted.value.s : default_value;
+}
+
+
+
+unsigned long long ini_get_hex(const INIData_t *data, const char *section, const char *key, const unsigned long long default_value)
+{
+    INICachedValue_t converted;
+    return get_converted_(data, section, key, INI_CACHED_HEX, &converted) < INI_CONVERT_INVALID ? converted.value.u : default_value;
+}
+
+
+
+long double ini_get_float(const INIData_t *data, const char *section, const char *key, const long double default_value)
+{
+    INICachedValue_t converted;
+    return get_converted_(data, section, key, INI_CACHED_FLOAT, &converted) < INI_CONVERT_INVALID ? converted.value.f : default_value;
+}
+
+
+
+bool ini_get_bool(const INIData_t *data, const char *section, const char *key, const bool default_value)
+{
+    INICachedValue_t converted;
+    return get_converted_(data, section, key, INI_CACHED_BOOL, &converted) < INI_CONVERT_INVALID ? converted.value.b : default_value;
+}
+
+
+
+double ini_get_double(const INIData_t *data, const char *section, const char *key, const double default_value, int *status)
+{
+    INICachedValue_t converted;
+    const int result = get_converted_(data, section, key, INI_CACHED_DOUBLE, &converted);
+    if (status) *status = result;
+    return result < INI_CONVERT_INVALID ? converted.value.d : default_value;
+}
+
+
+
+int64_t ini_get_int64(const INIData_t *data, const char *section, const char *key, const int64_t default_value, int *status)
+{
+    INICachedValue_t converted;
+    const int result = get_converted_(data, section, key, INI_CACHED_SIGNED, &converted);
+    if (status) *status = result;
+    return result < INI_CONVERT_INVALID ? converted.value.s : default_value;
+}
+
+
+
+INIKey_t ini_key(const char *section, const char *key)
+{
+    INIKey_t descriptor = { section, key, section ? strlen(section) : 0, key ? strlen(key) : 0, 0, 0 };
+    if (section) descriptor.section_hash = hash_name_((INIView_t){ section, descriptor.section_length });
+    if (key) descriptor.key_hash = hash_name_((INIView_t){ key, descriptor.key_length });
+    return descriptor;
+}
+
+
+
+const char *ini_get_value_k(const INIData_t *data, const INIKey_t *key)
+{
+    INISection_t *found_section;
+    return terminated_value_(data, lookup_keyed_(data, key, &found_section));
+}
+
+
+
+INIView_t ini_get_view_k(const INIData_t *data, const INIKey_t *key)
+{
+    INISection_t *found_section;
+    const INIPair_t *pair = lookup_keyed_(data, key, &found_section);
+    return pair ? value_view_(pair) : (INIView_t){ NULL, 0 };
+}
+
+
+
+const char *ini_get_string_k(const INIData_t *data, const INIKey_t *key, const char *default_value)
+{
+    const char *str = ini_get_value_k(data, key);
+    if (!str) return default_value;
+    return str;
+}
+
+
+
+unsigned long long ini_get_unsigned_k(const INIData_t *data, const INIKey_t *key, const unsigned long long default_value)
+{
+    INICachedValue_t converted;
+    return get_keyed_(data, key, INI_CACHED_UNSIGNED, &converted) < INI_CONVERT_INVALID ? converted.value.u : default_value;
+}
+
+
+
+long long ini_get_signed_k(const INIData_t *data, const INIKey_t *key, const long long default_value)
+{
+    INICachedValue_t converted;
+    return get_keyed_(data, key, INI_CACHED_SIGNED, &converted) < INI_CONVERT_INVALID ? converted.value.s : default_value;
+}
+
+
+
+unsigned long long ini_get_hex_k(const INIData_t *data, const INIKey_t *key, const unsigned long long default_value)
+{
+    INICachedValue_t converted;
+    return get_keyed_(data, key, INI_CACHED_HEX, &converted) < INI_CONVERT_INVALID ? converted.value.u : default_value;
+}
+
+
+
+long double ini_get_float_k(const INIData_t *data, const INIKey_t *key, const long double default_value)
+{
+    INICachedValue_t converted;
+    return get_keyed_(data, key, INI_CACHED_FLOAT, &converted) < INI_CONVERT_INVALID ? converted.value.f : default_value;
+}
+
+
+
+bool ini_get_bool_k(const INIData_t *data, const INIKey_t *key, const bool default_value)
+{
+    INICachedValue_t converted;
+    return get_keyed_(data, key, INI_CACHED_BOOL, &converted) < INI_CONVERT_INVALID ? converted.value.b : default_value;
+}
+
+
+
+double ini_get_double_k(const INIData_t *data, const INIKey_t *key, const double default_value, int *status)
+{
+    INICachedValue_t converted;
+    const int result = get_keyed_(data, key, INI_CACHED_DOUBLE, &converted);
+    if (status) *status = result;
+    return result < INI_CONVERT_INVALID ? converted.value.d : default_value;
+}
+
+
+
+int64_t ini_get_int64_k(const INIData_t *data, const INIKey_t *key, const int64_t default_value, int *status)
+{
+    INICachedValue_t converted;
+    const int result = get_keyed_(data, key, INI_CACHED_SIGNED, &converted);
+    if (status) *status = result;
+    return result < INI_CONVERT_INVALID ? converted.value.s : default_value;
+}
+
+
+
+INIHandle_t ini_resolve(const INIData_t *data, const char *section, const char *key)
+{
+    INIHandle_t handle = { ini_key(section, key), NULL, 0, NULL, NULL };
+    handle_pair_(data, &handle);
+    return handle;
+}
+
+
+
+const char *ini_handle_get_value(const INIData_t *data, INIHandle_t *handle)
+{
+    return terminated_value_(data, handle_pair_(data, handle));
+}
+
+
+
+INIView_t ini_handle_get_view(const INIData_t *data, INIHandle_t *handle)
+{
+    const INIPair_t *pair = handle_pair_(data, handle);
+    return pair ? value_view_(pair) : (INIView_t){ NULL, 0 };
+}
+
+
+
+const char *ini_handle_get_string(const INIData_t *data, INIHandle_t *handle, const char *default_value)
+{
+    const char *str = ini_handle_get_value(data, handle);
+    if (!str) return default_value;
+    return str;
+}
+
+
+
+unsigned long long ini_handle_get_unsigned(const INIData_t *data, INIHandle_t *handle, const unsigned long long default_value)
+{
+    INICachedValue_t converted;
+    return get_handled_(data, handle, INI_CACHED_UNSIGNED, &converted) < INI_CONVERT_INVALID ? converted.value.u : default_value;
+}
+
+
+
+long long ini_handle_get_signed(const INIData_t *data, INIHandle_t *handle, const long long default_value)
+{
+    INICachedValue_t converted;
+    return get_handled_(data, handle, INI_CACHED_SIGNED, &converted) < INI_CONVERT_INVALID ? converted.value.s : default_value;
+}
+
+
+
+unsigned long long ini_handle_get_hex(const INIData_t *data, INIHandle_t *handle, const unsigned long long default_value)
+{
+    INICachedValue_t converted;
+    return get_handled_(data, handle, INI_CACHED_HEX, &converted) < INI_CONVERT_INVALID ? converted.value.u : default_value;
+}
+
+
+
+long double ini_handle_get_float(const INIData_t *data, INIHandle_t *handle, const long double default_value)
+{
+    INICachedValue_t converted;
+    return get_handled_(data, handle, INI_CACHED_FLOAT, &converted) < INI_CONVERT_INVALID ? converted.value.f : default_value;
+}
+
+
+
+bool ini_handle_get_bool(const INIData_t *data, INIHandle_t *handle, const bool default_value)
+{
+    INICachedValue_t converted;
+    return get_handled_(data, handle, INI_CACHED_BOOL, &converted) < INI_CONVERT_INVALID ? converted.value.b : default_value;
+}
+
+
+
+double ini_handle_get_double(const INIData_t *data, INIHandle_t *handle, const double default_value, int *status)
+{
+    INICachedValue_t converted;
+    const int result = get_handled_(data, handle, INI_CACHED_DOUBLE, &converted);
+    if (status) *status = result;
+    return result < INI_CONVERT_INVALID ? converted.value.d : default_value;
+}
+
+
+
+int64_t ini_handle_get_int64(const INIData_t *data, INIHandle_t *handle, const int64_t default_value, int *status)
+{
+    INICachedValue_t converted;
+    const int result = get_handled_(data, handle, INI_CACHED_SIGNED, &converted);
+    if (status) *status = result;
+    return result < INI_CONVERT_INVALID ? converted.value.s : default_value;
+}
+
+
+
+unsigned ini_bind(const INIData_t *data, const INIBinding_t *schema, const unsigned count, void *target, INIError_t *error)
+{
+    clear_parse_error_(error);
+    if (!schema || !target) return 0;
+
+    // Open addressing tables of pairs and of sections, hashed the way the
+    // walk below hashes them, followed by which entries were found.
+    // Without them every lookup falls back to scanning the schema.
+    size_t capacity = 1;
+    while (capacity < (size_t)count * 2) capacity <<= 1;
+    const size_t size = sizeof(unsigned) * capacity * 2 + count;
+    const INIAllocator_t *allocator = data ? &data->allocator : NULL;
+    unsigned *slots = count ? allocate_(allocator, size) : NULL;
+    bool *found = slots ? (bool *)(slots + capacity * 2) : NULL;
+    if (slots)
+    {
+        memset(slots, 0, size);
+        for (unsigned i = 0; i < count; i++)
+        {
+            const INIView_t section = { schema[i].section, strlen(schema[i].section) };
+            const INIView_t key = { schema[i].key, strlen(schema[i].key) };
+            const uint64_t seed = mix_(hash_bytes_(section.data, section.length, 0));
+
+            size_t slot = mix_(hash_bytes_(key.data, key.length, seed)) & (capacity - 1);
+            while (slots[slot]) slot = (slot + 1) & (capacity - 1);
+            slots[slot] = i + 1;
+
+            unsigned *sections = slots + capacity;
+            for (slot = seed & (capacity - 1); sections[slot]; slot = (slot + 1) & (capacity - 1))
+                if (strcmp(schema[sections[slot] - 1].section, schema[i].section) == 0) break;
+            sections[slot] = i + 1;
+        }
+    }
+
+    unsigned problems = 0;
+    for (unsigned i = 0; data && i < data->section_count; i++)
+    {
+        INISection_t *section = &data->sections[i];
+        const INIView_t name = name_view_(section);
+        const uint64_t seed = mix_(hash_bytes_(name.data, name.length, 0));
+
+        // Sections the schema doesn't name belong to someone else
+        if (!binds_section_(schema, count, slots, capacity, name, seed)) continue;
+        load_section_(data, section);
+
+        for (unsigned j = 0; j < section->pair_count; j++)
+        {
+            const INIPair_t *pair = &section->pairs[j];
+            const INIView_t key = key_view_(pair);
+            const INIBinding_t *binding = find_binding_(schema, count, slots, capacity, name, key, seed);
+            if (!binding)
+            {
+                problems++;
+                report_binding_(error, name, key, UNKNOWN_KEY_);
+                continue;
+            }
+
+            const int status = store_binding_(binding, data, pair, target);
+            if (found) found[binding - schema] = true;
+            if (status != INI_CONVERTED)
+            {
+                problems++;
+                report_binding_(error, name, key, status);
+            }
+        }
+    }
+
+    // What the walk didn't find takes its default
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (found ? found[i] : ini_get_view(data, schema[i].section, schema[i].key).data != NULL) continue;
+
+        store_binding_(&schema[i], data, NULL, target);
+        problems++;
+        report_binding_(error, (INIView_t){ schema[i].section, strlen(schema[i].section) },
+                        (INIView_t){ schema[i].key, strlen(schema[i].key) }, INI_CONVERT_MISSING);
+    }
+
+    if (slots) deallocate_(allocator, slots);
+    return problems;
+}
+
+
+
+INIFrozen_t *ini_freeze(const INIData_t *data)
+{
+    if (!data) return NULL;
+
+    unsigned total = 0;
+    for (unsigned i = 0; i < data->section_count; i++)
+    {
+        load_section_(data, &data->sections[i]);
+        total += data->sections[i].pair_count;
+    }
+
+    const INIAllocator_t *allocator = &data->allocator;
+    INIIndexSlot_t *entries = allocate_(allocator, sizeof(INIIndexSlot_t) * (total ? total : 1));
+    if (!entries) return NULL;
+
+    // Different pairs with the same hash, or a perfect hash that can't be
+    // built, are left to the next seed
+    INIFrozen_t *frozen = NULL;
+    for (unsigned attempt = 0; attempt < FROZEN_ATTEMPTS_ && !frozen; attempt++)
+    {
+        const uint64_t seed = 14695981039346656037ull + attempt * 0x9e3779b97f4a7c15ull;
+        unsigned count = 0;
+        for (unsigned i = 0; i < data->section_count; i++)
+        {
+            const INISection_t *section = &data->sections[i];
+            for (unsigned j = 0; j < section->pair_count; j++)
+                entries[count++] = (INIIndexSlot_t){ hash_pair_(seed, name_view_(section), key_view_(&section->pairs[j])), i, j };
+        }
+
+        bool retry = false;
+        count = drop_duplicates_(data, entries, count, &retry);
+        if (!retry)
+            frozen = build_frozen_(data, entries, count, seed, &retry);
+        if (!frozen && !retry) break;
+    }
+
+    deallocate_(allocator, entries);
+    return frozen;
+}
+
+
+
+void ini_free_frozen(INIFrozen_t *frozen)
+{
+    if (!frozen) return;
+
+#ifdef INI_HAS_MMAP
+    if (frozen->mapped)
+        munmap(frozen->image, frozen->image_length);
+#endif
+    if (frozen->image && !frozen->mapped)
+        deallocate_(&frozen->allocator, frozen->image);
+    deallocate_(&frozen->allocator, frozen);
+}
+
+
+
+bool ini_compile(const INIData_t *data, const char *path)
+{
+    if (!data || !path) return false;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    bool written = write_image_(data, file);
+    if (fclose(file) != 0) written = false;
+    if (!written) remove(path);
+    return written;
+}
+
+
+
+INIFrozen_t *ini_open_compiled(const char *path)
+{
+    if (!path) return NULL;
+
+#ifdef INI_HAS_MMAP
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    INIFrozen_t *frozen = map_image_(fd, false);
+    close(fd);
+    return frozen;
+#else
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+    INISource_t *source = read_source_(NULL, file);
+    fclose(file);
+    if (!source) return NULL;
+
+    INIFrozen_t *frozen = open_image_(source->contents, source, source->length, false);
+    if (!frozen) deallocate_(NULL, source);
+    return frozen;
+#endif
+}
+
+
+
+int ini_export_shared(const INIData_t *data)
+{
+#ifdef INI_HAS_MMAP
+    if (!data) return -1;
+
+#ifdef INI_HAS_MEMFD
+    const int fd = memfd_create("ini", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+    // Without memfd, an unlinked shared memory object is the closest
+    // thing, but it can't be sealed
+    static unsigned counter = 0;
+    char name[64];
+    snprintf(name, sizeof(name), "/ini-%ld-%u", (long)getpid(), counter++);
+    const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) shm_unlink(name);
+#endif
+    if (fd < 0) return -1;
+
+    // Shared memory objects can't be written to on every system, e.g.
+    // macOS, but can be sized and written through a mapping everywhere
+    INICompiledHeader_t header;
+    const char *body;
+    INIFrozen_t *frozen = freeze_image_(data, &header, &body);
+    void *image = MAP_FAILED;
+    if (frozen && ftruncate(fd, (off_t)header.size) == 0)
+        image = mmap(NULL, (size_t)header.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    bool written = image != MAP_FAILED;
+    if (written)
+    {
+        memcpy(image, &header, sizeof(header));
+        memcpy((char *)image + sizeof(header), body, (size_t)header.size - sizeof(header));
+        munmap(image, (size_t)header.size);
+    }
+    ini_free_frozen(frozen);
+#ifdef INI_HAS_MEMFD
+    if (written)
+        written = fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) == 0;
+#endif
+
+    if (!written)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+#else
+    (void)data;
+    return -1;
+#endif
+}
+
+
+
+INIFrozen_t *ini_attach_shared(const int fd)
+{
+#ifdef INI_HAS_MMAP
+    if (fd < 0) return NULL;
+
+#ifdef INI_HAS_MEMFD
+    // Memory that can be sealed has to be, or it could shrink under the
+    // mapping or change after the checksum was verified
+    const int seals = fcntl(fd, F_GET_SEALS);
+    const int required = F_SEAL_SHRINK | F_SEAL_WRITE;
+    if (seals >= 0 && (seals & required) != required) return NULL;
+#endif
+
+    return map_image_(fd, true);
+#else
+    (void)fd;
+    return NULL;
+#endif
+}
+
+
+
+const char *ini_frozen_get_value(const INIFrozen_t *frozen, const char *section, const char *key)
+{
+    if (!frozen || !section || !key || !frozen->pair_count) return NULL;
+
+    const INIView_t name = { section, strlen(section) };
+    const INIView_t key_view = { key, strlen(key) };
+    const uint64_t hash = hash_pair_(frozen->seed, name, key_view);
+    const INIFrozenPair_t *pair = &frozen->pairs[frozen_slot_(hash, frozen->displacements, frozen->pair_count)];
+
+    if (pair->section_length != name.length || pair->key_length != key_view.length
+    ||  memcmp(frozen->strings + pair->section, name.data, name.length) != 0
+    ||  memcmp(frozen->strings + pair->key, key_view.data, key_view.length) != 0)
+        return NULL;
+    return frozen->strings + pair->value;
+}
+
+
+
+const char *ini_frozen_get_string(const INIFrozen_t *frozen, const char *section, const char *key, const char *default_value)
+{
+    const char *str = ini_frozen_get_value(frozen, section, key);
+    if (!str) return default_value;
+    return str;
+}
+
+
+
+unsigned long long ini_frozen_get_unsigned(const INIFrozen_t *frozen, const char *section, const char *key, const unsigned long long default_value)
+{
+    return to_unsigned_(ini_frozen_get_value(frozen, section, key), 10, default_value);
+}
+
+
+
+long long ini_frozen_get_signed(const INIFrozen_t *frozen, const char *section, const char *key, const long long default_value)
+{
+    return to_signed_(ini_frozen_get_value(frozen, section, key), default_value);
+}
+
+
+
+unsigned long long ini_frozen_get_hex(const INIFrozen_t *frozen, const char *section, const char *key, const unsigned long long default_value)
+{
+    return to_unsigned_(ini_frozen_get_value(frozen, section, key), 16, default_value);
+}
+
+
+
+long double ini_frozen_get_float(const INIFrozen_t *frozen, const char *section, const char *key, const long double default_value)
+{
+    return to_float_(ini_frozen_get_value(frozen, section, key), default_value);
+}
+
+
+
+bool ini_frozen_get_bool(const INIFrozen_t *frozen, const char *section, const char *key, const bool default_value)
+{
+    return to_bool_(ini_frozen_get_value(frozen, section, key), default_value);
+}
+
+
+
+// Assumes line is null-terminated.
+bool ini_is_blank_line(const char *line)
+{
+    if (!line) return false;
+    const char *end = line + strlen(line);
+    return skip_ignored_characters_(line, end) == end;
+}
+
+
+
+bool ini_parse_section(const char *line, INISection_t *section, ptrdiff_t *discrepancy)
+{
+    if (!line) return false;
+
+    INIView_t name;
+    const size_t max_length = section ? STRING_LIMIT_ : SIZE_MAX;
+    const bool parsed = parse_section_(line, line, line + strlen(line), max_length, discrepancy, &name);
+
+    if (section)
+    {
+#ifdef INI_COMPACT_STRINGS
+        // Empty views are made "" so a length of 0 always means null-terminated
+        section->name = name.length ? name.data : "";
+        section->name_length = name.length;
+#else
+        memset(section->name, 0, sizeof(section->name));
+        memcpy(section->name, name.data, name.length);
+#endif
+    }
+
+    return parsed;
+}
+
+
+
+bool ini_parse_pair(const char *line, INIPair_t *pair, ptrdiff_t *discrepancy)
+{
+    if (!line) return false;
+
+    if (discrepancy) *discrepancy = 0;
+
+#ifndef INI_COMPACT_STRINGS
+    if (pair)
+        memset(pair->key, 0, sizeof(pair->key));
+#endif
+
+    const char *end = line + strlen(line);
+    const size_t max_length = pair ? STRING_LIMIT_ : SIZE_MAX;
+    const char *delimiter = NULL;
+    INIView_t key, value;
+    if (parse_key_(line, line, end, max_length, discrepancy, &key, &delimiter)
+    &&  parse_value_(line, delimiter + 1, end, max_length, discrepancy, &value))
+    {
+        if (pair)
+        {
+#ifdef INI_COMPACT_STRINGS
+            *pair = (INIPair_t){ key.data, value.length ? value.data : "", key.length, value.length };
+#else
+            copy_view_(pair->key, key);
+            copy_view_(pair->value, value);
+#endif
+        }
+        return true;
+    }
+
+    if (pair)
+    {
+#ifdef INI_COMPACT_STRINGS
+        *pair = (INIPair_t){ "", "", 0, 0 };
+#else
+        pair->key[0] = '\0';
+        pair->value[0] = '\0';
+#endif
+    }
+    return false;
+}
+
+
+
+bool ini_parse_key(const char *line, char *dest, const unsigned n, ptrdiff_t *discrepancy)
+{
+    if (!line) return false;
+
+    INIView_t key;
+    if (!parse_key_(line, line, line + strlen(line), dest ? (size_t)n - 1 : SIZE_MAX, discrepancy, &key, NULL))
+        return false;
+
+    if (dest) copy_view_(dest, key);
+    return true;
+}
+
+
+
+bool ini_parse_value(const char *line, char *dest, const unsigned n, ptrdiff_t *discrepancy)
+{
+    if (!line) return false;
+
+    if (discrepancy) *discrepancy = 0;
+
+    const char *c = line;
+    while (*c != '=' && *c != ':' && *c != '\0') c++;
+    if (*c == '\0')
+    {
+        if (discrepancy) *discrepancy = c - line;
+        return false;
+    }
+
+    INIView_t value;
+    if (!parse_value_(line, c + 1, c + 1 + strlen(c + 1), dest ? (size_t)n - 1 : SIZE_MAX, discrepancy, &value))
+        return false;
+
+    if (dest) copy_view_(dest, value);
+    return true;
+}
+
+
+
+void ini_free_data(INIData_t *data)
+{
+    if (!data || (!data->allocator.free && !ini_free_)) return;
+
+    ini_disable_index(data);
+
+    const INIAllocator_t *allocator = &data->allocator;
+    if (!data->arena && data->sections)
+    {
+        for (unsigned i = 0; i < data->section_allocation; i++)
+        {
+            if (data->sections[i].pairs)
+                deallocate_(allocator, data->sections[i].pairs);
+            if (data->sections[i].cache)
+                deallocate_(allocator, data->sections[i].cache);
+        }
+        deallocate_(allocator, data->sections);
+    }
+    while (data->sources)
+    {
+        INISource_t *source = data->sources;
+        data->sources = source->next;
+#ifdef INI_HAS_MMAP
+        if (source->mapped)
+            munmap((void *)source->contents, source->length);
+#endif
+        deallocate_(allocator, source);
+    }
+
+    // The first block of an arena shares the allocation of data
+    const INIBlock_t *first = data->arena ? (INIBlock_t *)((char *)data + ARENA_BLOCK_OFFSET_) : NULL;
+    while (data->blocks)
+    {
+        INIBlock_t *block = data->blocks;
+        data->blocks = block->next;
+        if (block != first && !data->fixed)
+            deallocate_(allocator, block);
+    }
+    if (!data->fixed)
+        deallocate_(allocator, data);
+}
+
+
+
+INIData_t *ini_create_data()
+{
+    return ini_create_data_with(NULL);
+}
+
+
+
+INIData_t *ini_create_data_with(const INIAllocator_t *allocator)
+{
+    return create_data_(allocator, 0, 0);
+}
+
+
+
+INIData_t *ini_create_data_reserve(const unsigned sections, const unsigned pairs_per_section)
+{
+    return create_data_(NULL, sections, pairs_per_section);
+}
+
+
+
+INIData_t *ini_create_data_reserve_with(const INIAllocator_t *allocator, const unsigned sections, const unsigned pairs_per_section)
+{
+    return create_data_(allocator, sections, pairs_per_section);
+}
+
+
+
+void ini_init_data(INIData_t* data, INISection_t* sections, INIPair_t** pairs, const unsigned num_sections, const unsigned num_pairs)
+{
+    if (!data || !sections || !pairs) return;
+
+    data->sections = sections;
+    data->section_count = 0;
+    data->section_allocation = num_sections;
+    data->pair_reservation = 0;
+    data->pool = NULL;
+    data->pool_size = 0;
+    data->pool_used = 0;
+    data->flags = 0;
+    data->sources = NULL;
+    data->arena = false;
+    data->borrowed = false;
+    data->blocks = NULL;
+    data->allocator = (INIAllocator_t){ NULL, NULL, NULL, NULL };
+    data->index = NULL;
+    data->generation = first_generation_();
+
+    // Strings only go where ini_init_strings() says. Blocks taken from
+    // the heap could never be given back, as ini_free_data() would free
+    // the caller's arrays along with them.
+#ifdef INI_COMPACT_STRINGS
+    data->fixed = true;
+#else
+    data->fixed = false;
+#endif
+
+    for (unsigned i = 0; i < num_sections; i++)
+    {
+        sections[i].data = data;
+        sections[i].pairs = pairs[i];
+        sections[i].cache = NULL;
+        sections[i].pair_count = 0;
+        sections[i].pair_allocation = num_pairs;
+        sections[i].body = NULL;
+    }
+}
+
+
+
+void ini_init_pooled_data(INIData_t *data, INISection_t *sections, const unsigned num_sections, INIPair_t *pool, const unsigned num_pairs)
+{
+    if (!data || !sections || !pool) return;
+
+    // Everything but the sections is set up the same
+    ini_init_data(data, sections, &pool, 0, 0);
+    data->section_allocation = num_sections;
+    data->pool = pool;
+    data->pool_size = num_pairs;
+    init_sections_(data, 0, num_sections);
+}
+
+
+
+bool ini_init_strings(INIData_t *data, void *buffer, const size_t size)
+{
+    if (!data || !buffer) return false;
+
+#ifdef INI_COMPACT_STRINGS
+    _Static_assert(sizeof(INIBlock_t) + _Alignof(INIBlock_t) - 1 <= INI_STRING_BUFFER_SIZE(0),
+                   "INI_STRING_BUFFER_SIZE() must leave room for a block");
+
+    const size_t padding = align_up_((uintptr_t)buffer, _Alignof(INIBlock_t)) - (uintptr_t)buffer;
+    if (size < padding + sizeof(INIBlock_t)) return false;
+
+    INIBlock_t *block = (INIBlock_t *)((char *)buffer + padding);
+    block->next = NULL;
+    block->used = 0;
+    block->size = size - padding - sizeof(INIBlock_t);
+
+    // Fixed keeps the strings to this block and data from being free'd
+    data->blocks = block;
+    data->fixed = true;
+#else
+    (void)size;
+#endif
+    return true;
+}
+
+
+
+INIData_t *ini_create_arena_data()
+{
+    const size_t size = ARENA_BLOCK_OFFSET_ + sizeof(INIBlock_t) + INI_ARENA_BLOCK_SIZE;
+    void *buffer = allocate_(NULL, size);
+    if (!buffer) return NULL;
+
+    INIData_t *data = init_arena_(buffer, size, false);
+    if (!data) deallocate_(NULL, buffer);
+    return data;
+}
+
+
+
+INIData_t *ini_init_arena_data(void *buffer, const size_t size)
+{
+    if (!buffer) return NULL;
+    return init_arena_(buffer, size, true);
+}
+
+
+
+// Every character of a well-formed line is looked at once: leading blanks
+// and comments are skipped a single time, the first significant character
+// picks the section or pair path, and the value continues from the key's
+// delimiter. Keys, values and names longer than max_length are rejected.
+static INILineType_t lex_line_(const char *line, const char *end, const size_t max_length, INILine_t *lexed)
+{
+    lexed->discrepancy = 0;
+
+    const char *start = skip_ignored_characters_(line, end);
+    if (start == end) return lexed->type = LINE_BLANK_;
+
+    if (*start != '[')
+    {
+        const char *delimiter = NULL;
+        if (parse_key_(line, start, end, max_length, &lexed->discrepancy, &lexed->key, &delimiter)
+        &&  parse_value_(line, delimiter + 1, end, max_length, &lexed->discrepancy, &lexed->value))
+            return lexed->type = LINE_PAIR_;
+
+        if (peek_(line + lexed->discrepancy, end) != '[')
+        {
+            lexed->msg = "Failed to parse pair.";
+            lexed->header = false;
+            return lexed->type = LINE_INVALID_;
+        }
+        start = line;
+    }
+
+    if (parse_section_(line, start, end, max_length, &lexed->discrepancy, &lexed->name))
+        return lexed->type = LINE_SECTION_;
+
+    lexed->msg = "Failed to parse section.";
+    lexed->header = true;
+    return lexed->type = LINE_INVALID_;
+}
+
+
+
+static bool read_line_(INIReadState_t *state, const char *line, const size_t length)
+{
+    INILine_t lexed;
+    lex_line_(line, line + length, STRING_LIMIT_, &lexed);
+    return read_lexed_line_(state, line, length, &lexed);
+}
+
+
+
+static bool read_lexed_line_(INIReadState_t *state, const char *line, const size_t length, const INILine_t *lexed)
+{
+    switch (lexed->type)
+    {
+        case LINE_BLANK_:   return true;
+        case LINE_SECTION_: return read_section_(state, line, length, lexed);
+        case LINE_PAIR_:    return read_pair_(state, line, length, lexed);
+        case LINE_INVALID_: break;
+    }
+
+    // Pairs under a broken header don't belong to the section before it
+    if (lexed->header) state->current_section = NULL;
+    return fail_line_(state->error, state->flags, line, length, lexed->discrepancy, lexed->msg);
+}
+
+
+
+// Reads a buffer for INI_LAZY_SECTIONS. Lines are only looked at closely
+// if they start with '[', everything following the header of a new
+// section up to the next header is left for load_section_(). Sections
+// that already exist are loaded and read into as usual.
+static bool index_buffer_(INIReadState_t *state, const char *buffer, const size_t length)
+{
+    INISection_t *lazy = NULL;
+    const char *c = buffer;
+    const char *end = buffer + length;
+    INILines_t lines;
+    init_lines_(&lines, buffer, end);
+
+    while (c < end)
+    {
+        const char *next = next_line_(&lines, c);
+        const char *start = skip_ignored_characters_(c, next);
+
+        if (lazy && (start == next || *start != '['))
+        {
+            c = next;
+            continue;
+        }
+
+        INILine_t lexed;
+        lex_line_(c, next, STRING_LIMIT_, &lexed);
+
+        // A broken header ends the section before it too
+        if (lazy)
+        {
+            lazy->body_length = (size_t)(c - lazy->body);
+            lazy = NULL;
+        }
+
+        const unsigned section_count = state->data->section_count;
+        if (!read_lexed_line_(state, c, (size_t)(next - c), &lexed))
+            return false;
+        if (state->data->section_count > section_count)
+        {
+            lazy = state->current_section;
+            lazy->body = next;
+        }
+        c = next;
+    }
+
+    if (lazy) lazy->body_length = (size_t)(end - lazy->body);
+    return true;
+}
+
+
+
+// Parses the pairs index_buffer_() left behind. There's nobody to report
+// errors to by now, so offending lines are skipped.
+static void load_section_(const INIData_t *data, INISection_t *section)
+{
+    if (!section->body) return;
+
+    // The body never holds a valid header, so there's no need for data
+    INIReadState_t state = { NULL, NULL, data->flags | INI_CONTINUE_PAST_ERROR, section };
+    const char *c = section->body;
+    const char *end = section->body + section->body_length;
+    section->body = NULL;
+    INILines_t lines;
+    init_lines_(&lines, c, end);
+
+    while (c < end)
+    {
+        const char *next = next_line_(&lines, c);
+        read_line_(&state, c, (size_t)(next - c));
+        c = next;
+    }
+}
+
+
+
+// Reads the rest of a file into a heap-allocated source.
+static INISource_t *read_source_(const INIAllocator_t *allocator, FILE *file)
+{
+    size_t allocation = INI_MAX_LINE_SIZE;
+    size_t length = 0;
+    INISource_t *source = allocate_(allocator, sizeof(INISource_t) + allocation);
+    if (!source) return NULL;
+
+    size_t n;
+    while ((n = fread((char *)(source + 1) + length, 1, allocation - length, file)) > 0)
+    {
+        length += n;
+        if (length < allocation) continue;
+
+        allocation *= 2;
+        INISource_t *re = reallocate_(allocator, source, sizeof(INISource_t) + allocation);
+        if (!re)
+        {
+            deallocate_(allocator, source);
+            return NULL;
+        }
+        source = re;
+    }
+
+    if (ferror(file))
+    {
+        deallocate_(allocator, source);
+        return NULL;
+    }
+
+    *source = (INISource_t){ NULL, (const char *)(source + 1), length, false };
+    return source;
+}
+
+
+
+static bool read_section_(INIReadState_t *state, const char *line, const size_t length, const INILine_t *lexed)
+{
+    const INIView_t name = lexed->name;
+
+    INISection_t *existing_section = find_section_(state->data, name);
+    if (existing_section)
+    {
+        if (!(state->flags & (INI_ALLOW_DUPLICATE_SECTIONS | INI_CONTINUE_PAST_ERROR)))
+        {
+            char buffer[INI_MAX_LINE_SIZE];
+            snprintf(buffer, INI_MAX_LINE_SIZE, "Duplicate section '%.*s'.", (int)name.length, name.data);
+            return fail_line_(state->error, state->flags, line, length, lexed->discrepancy, buffer);
+        }
+        state->current_section = existing_section;
+        return true;
+    }
+
+    state->current_section = append_section_(state->data, name, state->flags & INI_BORROW_STRINGS);
+    if (!state->current_section)
+    {
+        char buffer[INI_MAX_LINE_SIZE];
+        snprintf(buffer,
+            INI_MAX_LINE_SIZE,
+            "Failed to add section '%.*s' to database. %s",
+            (int)name.length, name.data, add_failure_(state->data, state->flags));
+        return fail_line_(state->error, state->flags, line, length, lexed->discrepancy, buffer);
+    }
+    return true;
+}
+
+
+
+static bool read_pair_(INIReadState_t *state, const char *line, const size_t length, const INILine_t *lexed)
+{
+    INISection_t *section = state->current_section;
+    if (!section)
+        return fail_line_(state->error, state->flags, line, length, lexed->discrepancy, "Pairs must reside within a section.");
+
+    const bool borrow = state->flags & INI_BORROW_STRINGS;
+
+    INIPair_t *existing_pair = find_pair_(section, lexed->key);
+    if (existing_pair)
+    {
+        if (!(state->flags & INI_DUPLICATE_KEYS_OVERWRITE))
+            return fail_line_(state->error, state->flags, line, length, 0, "Duplicate key in section.");
+        if (set_value_(section, existing_pair, lexed->value, borrow))
+            return true;
+    }
+    else
+    {
+        INIPair_t *pair = reserve_pair_(section);
+        if (pair && set_key_(section, pair, lexed->key, borrow) && set_value_(section, pair, lexed->value, borrow))
+        {
+            commit_pair_(section);
+            return true;
+        }
+    }
+
+    const INIView_t name = name_view_(section);
+    char buffer[INI_MAX_LINE_SIZE];
+    snprintf(buffer,
+        INI_MAX_LINE_SIZE,
+        "Failed to add pair '%.*s=%.*s' to section '%.*s'. %s",
+        (int)lexed->key.length, lexed->key.data,
+        (int)lexed->value.length, lexed->value.data,
+        (int)name.length, name.data, add_failure_(state->data, state->flags));
+    return fail_line_(state->error, state->flags, line, length, lexed->discrepancy, buffer);
+}
+
+
+
+// Why a section or pair couldn't be added to data while reading with
+// flags, as far as can be told.
+static const char *add_failure_(const INIData_t *data, const uint64_t flags)
+{
+#ifdef INI_COMPACT_STRINGS
+    if (data->fixed && !data->blocks && !(flags & INI_BORROW_STRINGS))
+        return "No buffer for strings, see ini_init_strings().";
+#else
+    (void)data;
+    (void)flags;
+#endif
+    return "Possibly insufficient allocation space.";
+}
+
+
+
+static bool stream_file_(FILE *file, const INICallbacks_t *callbacks, void *user, INIError_t *error, const uint64_t flags, const size_t max_length)
+{
+    INIFileLine_t line, section;
+    init_line_(&line, NULL);
+    init_line_(&section, NULL);
+    INIStreamState_t state = { callbacks, user, error, flags, false, false, { NULL, 0 }, section.data, max_length };
+
+    size_t length;
+    while ((length = get_line_(file, &line)) != 0)
+    {
+        // The name of a section is kept in a buffer as long as its line
+        if (length == SIZE_MAX || (section.capacity < line.capacity && !grow_line_(&section, line.capacity)))
+        {
+            set_parse_error_(error, line.data, line.capacity - 1, (ptrdiff_t)line.capacity - 1, "Line too long.");
+            state.failed = true;
+            break;
+        }
+        state.section_buffer = section.data;
+        if (state.in_section) state.section.data = section.data;
+
+        if (!stream_line_(&state, line.data, length))
+            break;
+    }
+
+    free_line_(&line);
+    free_line_(&section);
+    return !state.failed;
+}
+
+
+
+static void init_line_(INIFileLine_t *line, const INIAllocator_t *allocator)
+{
+    line->data = line->buffer;
+    line->capacity = sizeof(line->buffer);
+    line->allocator = allocator;
+}
+
+
+
+// Keeps what's in the line.
+static bool grow_line_(INIFileLine_t *line, const size_t capacity)
+{
+    if (!has_heap_(line->allocator) || capacity > INT_MAX) return false;
+
+    char *grown = line->data == line->buffer
+        ? allocate_(line->allocator, capacity)
+        : reallocate_(line->allocator, line->data, capacity);
+    if (!grown) return false;
+
+    if (line->data == line->buffer) memcpy(grown, line->buffer, line->capacity);
+    line->data = grown;
+    line->capacity = capacity;
+    return true;
+}
+
+
+
+// Reads the next line of file into line, newline included, growing it
+// until the whole line fits. Returns its length, 0 at the end of the
+// file, or SIZE_MAX if it can't be grown.
+static size_t get_line_(FILE *file, INIFileLine_t *line)
+{
+    if (!fgets(line->data, (int)line->capacity, file)) return 0;
+
+    size_t length = strlen(line->data);
+    while (length == line->capacity - 1 && line->data[length - 1] != '\n')
+    {
+        if (!grow_line_(line, line->capacity * 2)) return SIZE_MAX;
+        if (!fgets(line->data + length, (int)(line->capacity - length), file)) break;
+        length += strlen(line->data + length);
+    }
+    return length;
+}
+
+
+
+static void free_line_(INIFileLine_t *line)
+{
+    if (line->data != line->buffer)
+        deallocate_(line->allocator, line->data);
+}
+
+
+
+static bool stream_buffer_(const char *buffer, const size_t length, const INICallbacks_t *callbacks, void *user, INIError_t *error, const uint64_t flags, const size_t max_length)
+{
+    INIStreamState_t state = { callbacks, user, error, flags, false, false, { NULL, 0 }, NULL, max_length };
+    const char *c = buffer;
+    const char *end = buffer + length;
+    INILines_t lines;
+    init_lines_(&lines, buffer, end);
+
+    while (c < end)
+    {
+        const char *next = next_line_(&lines, c);
+        if (!stream_line_(&state, c, (size_t)(next - c)))
+            break;
+        c = next;
+    }
+
+    return !state.failed;
+}
+
+
+
+static bool stream_line_(INIStreamState_t *state, const char *line, const size_t length)
+{
+    const INICallbacks_t *callbacks = state->callbacks;
+    INILine_t lexed;
+    switch (lex_line_(line, line + length, state->max_length, &lexed))
+    {
+        case LINE_BLANK_:
+            return true;
+
+        case LINE_SECTION_:
+            state->in_section = true;
+            state->section = lexed.name;
+            if (state->section_buffer)
+            {
+                // The line is about to be overwritten by the next one
+                memcpy(state->section_buffer, lexed.name.data, lexed.name.length);
+                state->section.data = state->section_buffer;
+            }
+            return !callbacks->on_section || callbacks->on_section(state->user, state->section);
+
+        case LINE_PAIR_:
+            if (!state->in_section)
+            {
+                lexed.msg = "Pairs must reside within a section.";
+                break;
+            }
+            return !callbacks->on_pair || callbacks->on_pair(state->user, state->section, lexed.key, lexed.value);
+
+        case LINE_INVALID_:
+            if (lexed.header) state->in_section = false;
+            break;
+    }
+
+    if (fail_line_(state->error, state->flags, line, length, lexed.discrepancy, lexed.msg)) return true;
+    state->failed = true;
+    return false;
+}
+
+
+
+// Each header starts a new count, so sections that appear more than once
+// are counted once for every appearance. Their pairs add up, though, when
+// the flags have them merged.
+static bool measure_section_(void *user, const INIView_t name)
+{
+    INIMeasureState_t *state = user;
+    state->measure->sections++;
+    state->measure->string_bytes += name.length + 1;
+    state->pairs = 0;
+
+    if (state->merge && !state->untracked)
+    {
+        state->current = find_measured_section_(state, hash_name_(name) | 1);
+        state->untracked = !state->current;
+    }
+    return true;
+}
+
+
+
+// Finds the count of the section with hash in state, adding it if it's
+// new. Returns NULL if the table is full and can't grow.
+static INIMeasuredSection_t *find_measured_section_(INIMeasureState_t *state, const uint64_t hash)
+{
+    if (state->section_count * 2 >= state->section_capacity)
+    {
+        const unsigned capacity = state->section_capacity * 2;
+        if (capacity <= state->section_capacity) return NULL;
+        INIMeasuredSection_t *sections = allocate_(NULL, capacity * sizeof(INIMeasuredSection_t));
+        if (!sections) return NULL;
+        memset(sections, 0, capacity * sizeof(INIMeasuredSection_t));
+
+        for (unsigned i = 0; i < state->section_capacity; i++)
+        {
+            if (!state->sections[i].hash) continue;
+            unsigned slot = (unsigned)state->sections[i].hash & (capacity - 1);
+            while (sections[slot].hash) slot = (slot + 1) & (capacity - 1);
+            sections[slot] = state->sections[i];
+        }
+        if (state->sections != state->local) deallocate_(NULL, state->sections);
+        state->sections = sections;
+        state->section_capacity = capacity;
+    }
+
+    unsigned slot = (unsigned)hash & (state->section_capacity - 1);
+    while (state->sections[slot].hash && state->sections[slot].hash != hash)
+        slot = (slot + 1) & (state->section_capacity - 1);
+    if (!state->sections[slot].hash)
+    {
+        state->sections[slot].hash = hash;
+        state->section_count++;
+    }
+    return &state->sections[slot];
+}
+
+
+
+static bool measure_pair_(void *user, const INIView_t section, const INIView_t key, const INIView_t value)
+{
+    (void)section;
+    INIMeasureState_t *state = user;
+    INIMeasure_t *measure = state->measure;
+    measure->total_pairs++;
+    measure->string_bytes += key.length + value.length + 2;
+
+    if (state->untracked)
+    {
+        measure->max_pairs = measure->total_pairs;
+        return true;
+    }
+    unsigned *pairs = state->current ? &state->current->pairs : &state->pairs;
+    if (++*pairs > measure->max_pairs)
+        measure->max_pairs = *pairs;
+    return true;
+}
+
+
+
+#ifdef INI_HAS_THREADS
+// Finds the start of the first line at or after c that is a valid section
+// header. Splitting only there means no chunk starts without a section, so
+// every chunk parses exactly as it would have in one pass.
+static const char *find_chunk_split_(const char *begin, const char *c, const char *end)
+{
+    if (c <= begin) return begin;
+
+    const char *newline = memchr(c - 1, '\n', (size_t)(end - c + 1));
+    while (newline)
+    {
+        const char *line = newline + 1;
+        newline = memchr(line, '\n', (size_t)(end - line));
+        const char *next = newline ? newline + 1 : end;
+
+        INILine_t lexed;
+        if (lex_line_(line, next, STRING_LIMIT_, &lexed) == LINE_SECTION_)
+            return line;
+    }
+    return end;
+}
+
+
+
+static void *read_chunk_(void *arg)
+{
+    INIChunk_t *chunk = arg;
+    chunk->data = ini_create_data_with(chunk->allocator);
+    if (chunk->data && chunk->indexed) ini_enable_index(chunk->data);
+    chunk->failed = !chunk->data
+                 || !ini_read_buffer(chunk->begin, (size_t)(chunk->end - chunk->begin), chunk->data, NULL, chunk->flags);
+    return NULL;
+}
+
+
+
+static void *read_files_(void *arg)
+{
+    const INIFileWork_t *work = arg;
+    for (unsigned i = work->first; i < work->count; i += work->stride)
+    {
+        INIChunk_t *chunk = &work->chunks[i];
+        chunk->data = ini_create_data_with(chunk->allocator);
+        if (chunk->data && chunk->indexed) ini_enable_index(chunk->data);
+        chunk->failed = !chunk->data || !ini_read_file_path(work->paths[i], chunk->data, NULL, chunk->flags);
+    }
+    return NULL;
+}
+
+
+
+// Reads every file into its own database across nthreads threads and
+// merges them in order. Returns false without touching data if that
+// isn't possible or wouldn't match reading the files one by one.
+static bool read_files_parallel_(INIData_t *data, char **paths, const unsigned count, const unsigned nthreads, INIError_t *error, const uint64_t flags, bool *failed)
+{
+    if (!has_heap_(&data->allocator)) return false;
+
+    INIChunk_t *chunks = allocate_(&data->allocator, sizeof(INIChunk_t) * count);
+    if (!chunks) return false;
+
+    INISharedAllocator_t shared;
+    INIAllocator_t locked;
+    const INIAllocator_t *allocator = share_allocator_(data, &shared, &locked);
+    for (unsigned i = 0; i < count; i++)
+        chunks[i] = (INIChunk_t){ NULL, NULL, flags, allocator, data->index != NULL, NULL, true };
+
+    INIFileWork_t work[INI_MAX_PARALLEL_THREADS];
+    pthread_t threads[INI_MAX_PARALLEL_THREADS];
+    bool joinable[INI_MAX_PARALLEL_THREADS] = { false };
+
+    for (unsigned i = 0; i < nthreads; i++)
+        work[i] = (INIFileWork_t){ paths, chunks, count, i, nthreads };
+
+    // The calling thread takes the first share itself
+    for (unsigned i = 1; i < nthreads; i++)
+        joinable[i] = pthread_create(&threads[i], NULL, read_files_, &work[i]) == 0;
+    read_files_(&work[0]);
+    for (unsigned i = 1; i < nthreads; i++)
+    {
+        if (joinable[i]) pthread_join(threads[i], NULL);
+        else read_files_(&work[i]);
+    }
+
+    const bool merged = merge_chunks_(data, chunks, count, error, flags, failed);
+    for (unsigned i = 0; i < count; i++)
+        ini_free_data(chunks[i].data);
+    unshare_allocator_(allocator, &shared);
+    deallocate_(&data->allocator, chunks);
+    return merged;
+}
+
+
+
+static int compare_names_(const void *a, const void *b)
+{
+    const INIView_t *x = a;
+    const INIView_t *y = b;
+    const int order = memcmp(x->data, y->data, x->length < y->length ? x->length : y->length);
+    if (order) return order;
+    return (x->length > y->length) - (x->length < y->length);
+}
+
+
+
+// Returns whether a section name appears in more than one of data and the
+// chunks. Each of those holds a name at most once.
+static bool chunks_share_sections_(const INIData_t *data, const INIChunk_t *chunks, const unsigned count, bool *shared)
+{
+    size_t total = data->section_count;
+    for (unsigned i = 0; i < count; i++)
+        total += chunks[i].data->section_count;
+
+    INIView_t *names = allocate_(&data->allocator, sizeof(INIView_t) * (total ? total : 1));
+    if (!names) return false;
+
+    size_t n = 0;
+    for (unsigned i = 0; i < data->section_count; i++)
+        names[n++] = name_view_(&data->sections[i]);
+    for (unsigned i = 0; i < count; i++)
+        for (unsigned j = 0; j < chunks[i].data->section_count; j++)
+            names[n++] = name_view_(&chunks[i].data->sections[j]);
+
+    qsort(names, n, sizeof(INIView_t), compare_names_);
+    *shared = false;
+    for (size_t i = 1; i < n && !*shared; i++)
+        *shared = compare_names_(&names[i - 1], &names[i]) == 0;
+
+    deallocate_(&data->allocator, names);
+    return true;
+}
+
+
+
+// Moves the chunks into data in file order. Returns false without touching
+// data if the chunks can't be merged exactly as one pass would have read
+// them, i.e. when reading them would have failed. Running out of memory
+// part way through sets failed.
+static bool merge_chunks_(INIData_t *data, const INIChunk_t *chunks, const unsigned count, INIError_t *error, const uint64_t flags, bool *failed)
+{
+    *failed = false;
+    for (unsigned i = 0; i < count; i++)
+        if (chunks[i].failed) return false;
+
+    bool shared = false;
+    if (!chunks_share_sections_(data, chunks, count, &shared)) return false;
+
+    // Sections spread across chunks are only merged when neither the
+    // duplicate section nor any duplicate key in it can be an error
+    if (shared && !(flags & INI_CONTINUE_PAST_ERROR)
+    && (!(flags & INI_ALLOW_DUPLICATE_SECTIONS) || !(flags & INI_DUPLICATE_KEYS_OVERWRITE)))
+        return false;
+
+#ifdef INI_COMPACT_STRINGS
+    // Names and pairs are moved over as they are, still pointing into the
+    // strings of their chunk or the contents they were borrowed from
+    for (unsigned i = 0; i < count; i++)
+        adopt_blocks_(data, chunks[i].data);
+#endif
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        const INIData_t *chunk = chunks[i].data;
+        for (unsigned j = 0; j < chunk->section_count; j++)
+        {
+            const INISection_t *source = &chunk->sections[j];
+            const INIView_t name = name_view_(source);
+            INISection_t *section = shared ? find_section_(data, name) : NULL;
+
+            if (!section)
+            {
+                section = append_section_(data, name, true);
+                if (!section || !reserve_pairs_(section, source->pair_count))
+                {
+                    char buffer[INI_MAX_LINE_SIZE];
+                    snprintf(buffer,
+                        INI_MAX_LINE_SIZE,
+                        "Failed to add section '%.*s' to database. Possibly insufficient allocation space.",
+                        (int)name.length, name.data);
+                    set_parse_error_(error, name.data, name.length, 0, buffer);
+                    *failed = true;
+                    return true;
+                }
+                memcpy(section->pairs, source->pairs, sizeof(INIPair_t) * source->pair_count);
+                for (unsigned k = 0; k < source->pair_count; k++)
+                    commit_pair_(section);
+                continue;
+            }
+
+            for (unsigned k = 0; k < source->pair_count; k++)
+            {
+                const INIPair_t *pair = &source->pairs[k];
+                const INIView_t key = key_view_(pair);
+                INIPair_t *existing_pair = find_pair_(section, key);
+                if (existing_pair)
+                {
+                    if (flags & INI_DUPLICATE_KEYS_OVERWRITE)
+                    {
+                        *existing_pair = *pair;
+                        forget_value_(section, (unsigned)(existing_pair - section->pairs));
+                    }
+                }
+                else if (!ini_add_pair_to_section(section, *pair) && !(flags & INI_CONTINUE_PAST_ERROR))
+                {
+                    set_parse_error_(error, key.data, key.length, 0, "Failed to add pair. Possibly insufficient allocation space.");
+                    *failed = true;
+                    return true;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+
+// Returns the allocator the per-thread databases of data are made with:
+// the process-wide one if data has none of its own, or else one locking
+// shared around it. Whatever they allocate is data's to free later.
+static const INIAllocator_t *share_allocator_(const INIData_t *data, INISharedAllocator_t *shared, INIAllocator_t *locked)
+{
+    if (!data->allocator.alloc) return NULL;
+
+    shared->allocator = &data->allocator;
+    pthread_mutex_init(&shared->lock, NULL);
+    *locked = (INIAllocator_t){ shared_alloc_, shared_realloc_, shared_free_, shared };
+    return locked;
+}
+
+
+
+static void unshare_allocator_(const INIAllocator_t *locked, INISharedAllocator_t *shared)
+{
+    if (locked) pthread_mutex_destroy(&shared->lock);
+}
+
+
+
+static void *shared_alloc_(void *ctx, const size_t size)
+{
+    INISharedAllocator_t *shared = ctx;
+    pthread_mutex_lock(&shared->lock);
+    void *ptr = shared->allocator->alloc(shared->allocator->ctx, size);
+    pthread_mutex_unlock(&shared->lock);
+    return ptr;
+}
+
+
+
+static void *shared_realloc_(void *ctx, void *ptr, const size_t size)
+{
+    INISharedAllocator_t *shared = ctx;
+    pthread_mutex_lock(&shared->lock);
+    void *re = shared->allocator->realloc(shared->allocator->ctx, ptr, size);
+    pthread_mutex_unlock(&shared->lock);
+    return re;
+}
+
+
+
+static void shared_free_(void *ctx, void *ptr)
+{
+    INISharedAllocator_t *shared = ctx;
+    pthread_mutex_lock(&shared->lock);
+    shared->allocator->free(shared->allocator->ctx, ptr);
+    pthread_mutex_unlock(&shared->lock);
+}
+#endif
+
+
+
+// Hands a complete line to whichever consumer the parser was set up with,
+// carrying the consumer's state over from the previous line. length may
+// exceed what was actually kept of an overlong line.
+static void push_line_(INIParser_t *parser, const char *line, const size_t length)
+{
+    bool keep_going = true;
+
+    if (length > INI_MAX_LINE_SIZE)
+    {
+        keep_going = fail_line_(parser->error, parser->flags, line, INI_MAX_LINE_SIZE, INI_MAX_LINE_SIZE - 1, "Line too long.");
+        parser->failed = !keep_going;
+    }
+
+    else if (parser->data)
+    {
+        // Nothing can point into lines that are gone by the next feed
+        INIReadState_t state = { parser->data, parser->error, parser->flags & ~INI_BORROW_STRINGS, parser->current_section };
+        keep_going = read_line_(&state, line, length);
+        parser->current_section = state.current_section;
+        parser->failed = !keep_going;
+    }
+
+    else
+    {
+        INIStreamState_t state = {
+            parser->callbacks, parser->user, parser->error, parser->flags, false,
+            parser->in_section, { parser->section, parser->section_length }, parser->section, SIZE_MAX
+        };
+        keep_going = stream_line_(&state, line, length);
+        parser->in_section = state.in_section;
+        parser->section_length = state.section.length;
+        parser->failed = state.failed;
+    }
+
+    if (!keep_going) parser->done = true;
+}
+
+
+
+// Returns whether the reader should keep going.
+static bool fail_line_(INIError_t *error, const uint64_t flags, const char *line, const size_t length, const ptrdiff_t offset, const char *msg)
+{
+    if (flags & INI_CONTINUE_PAST_ERROR) return true;
+    set_parse_error_(error, line, length, offset, msg);
+    return false;
+}
+
+
+
+// c is where parsing starts, offsets are reported relative to line. Names
+// longer than max_length fail with no discrepancy and are truncated.
+static bool parse_section_(const char *line, const char *c, const char *end, const size_t max_length, ptrdiff_t *discrepancy, INIView_t *name)
+{
+    if (discrepancy) *discrepancy = 0;
+
+    c = skip_ignored_characters_(c, end);
+    if (peek_(c, end) != '[') goto is_not_section;
+    c++;
+    c = skip_ignored_characters_(c, end);
+
+    if (!is_valid_section_starting_character_(peek_(c, end))) goto is_not_section;
+
+    const char *beginning = c;
+    const char *last_space = NULL;
+    while (is_valid_section_character_(peek_(c, end)))
+    {
+        if (*c == ' ')
+        {
+            if (last_space && c - last_space == 1)
+                break;
+            last_space = c;
+        }
+        c++;
+    }
+
+    name->data = beginning;
+    if ((size_t)(c - beginning) > max_length)
+    {
+        name->length = max_length;
+        return false;
+    }
+
+    name->length = (size_t)(c - beginning);
+    if (last_space && c - last_space == 1)
+        name->length--;
+
+    c = skip_ignored_characters_(c, end);
+    if (peek_(c, end) != ']') goto is_not_section;
+    c++;
+
+    c = skip_ignored_characters_(c, end);
+    if (c != end) goto is_not_section;
+
+    return true;
+
+    is_not_section:
+    if (discrepancy) *discrepancy = c - line;
+    name->data = line;
+    name->length = 0;
+    return false;
+}
+
+
+
+// c is where parsing starts, offsets are reported relative to line. On
+// success, delimiter (if given) is pointed at the '=' or ':' following
+// the key so the value can be parsed without rescanning.
+static bool parse_key_(const char *line, const char *c, const char *end, const size_t max_length, ptrdiff_t *discrepancy, INIView_t *key, const char **delimiter)
+{
+    if (discrepancy) *discrepancy = 0;
+
+    c = skip_ignored_characters_(c, end);
+    const char *beginning = c;
+    if (!is_valid_key_starting_value_(peek_(c, end))) goto is_not_key;
+
+    c = scan_key_(c, end);
+
+    if ((size_t)(c - beginning) > max_length)
+    {
+        c = beginning + max_length;
+        goto is_not_key;
+    }
+    key->data = beginning;
+    key->length = (size_t)(c - beginning);
+
+    c = skip_ignored_characters_(c, end);
+    if (peek_(c, end) == '=' || peek_(c, end) == ':')
+    {
+        if (delimiter) *delimiter = c;
+        return true;
+    }
+
+    is_not_key:
+    if (discrepancy) *discrepancy = c - line;
+    return false;
+}
+
+
+
+// c points just past the delimiter, offsets are reported relative to line.
+static bool parse_value_(const char *line, const char *c, const char *end, const size_t max_length, ptrdiff_t *discrepancy, INIView_t *value)
+{
+    if (discrepancy) *discrepancy = 0;
+
+    c = skip_ignored_characters_(c, end);
+    const char *beginning = c;
+
+    const bool quoted = (peek_(c, end) == '"');
+    if (quoted) c++;
+    const char *contents = c;
+
+    c = scan_value_(c, end, quoted);
+
+    // Limits count the opening quote
+    if (c > contents && (size_t)(c - 1 - beginning) >= max_length)
+    {
+        c = (size_t)(contents - beginning) > max_length ? contents : beginning + max_length;
+        goto is_not_value;
+    }
+    value->data = contents;
+    value->length = (size_t)(c - contents);
+    if (!quoted && c > contents && c[-1] == ' ')
+        value->length--;
+
+    if (quoted)
+    {
+        if (peek_(c, end) != '"') goto is_not_value;
+        c++;
+    }
+
+    else
+        if (peek_(c, end) == '"') goto is_not_value;
+
+    c = skip_ignored_characters_(c, end);
+    if (c == end) return true;
+
+    is_not_value:
+    if (discrepancy) *discrepancy = c - line;
+    return false;
+}
+
+
+
+// Adds a section without checking whether it exists.
+static INISection_t *append_section_(INIData_t *data, INIView_t name, const bool borrow)
+{
+    if (data->section_count >= data->section_allocation)
+    {
+        // Pooled databases only ever have the sections they were given
+        if (data->pool) return NULL;
+
+        const unsigned allocation = data->section_allocation ? data->section_allocation * 2 : INI_INITIAL_ALLOCATED_SECTIONS;
+        INISection_t *re = grow_array_(data, data->sections,
+            sizeof(INISection_t) * data->section_allocation,
+            sizeof(INISection_t) * allocation);
+        if (!re) return NULL;
+        data->sections = re;
+        init_sections_(data, data->section_allocation, allocation);
+        data->section_allocation = allocation;
+    }
+
+    INISection_t *section = &data->sections[data->section_count];
+    section->data = data;
+    section->pair_count = 0;
+    section->body = NULL;
+#ifdef INI_COMPACT_STRINGS
+    section->name = keep_string_(data, name, borrow);
+    if (!section->name) return NULL;
+    section->name_length = name.length;
+#else
+    (void)borrow;
+    if (name.length > INI_MAX_STRING_SIZE - 1)
+        name.length = INI_MAX_STRING_SIZE - 1;
+    memset(section->name, 0, INI_MAX_STRING_SIZE);
+    memcpy(section->name, name.data, name.length);
+#endif
+    data->section_count++;
+    data->generation++;
+    if (data->index) index_section_(data, data->section_count - 1);
+    return section;
+}
+
+
+
+// Looks a section up by name, loading it first if it was read lazily.
+static INISection_t *find_section_(const INIData_t *data, const INIView_t name)
+{
+    return find_hashed_section_(data, name, data->index ? hash_name_(name) : 0);
+}
+
+
+
+// find_section_() with the hash of name already known, which is only
+// used with an index.
+static INISection_t *find_hashed_section_(const INIData_t *data, const INIView_t name, const uint64_t hash)
+{
+    if (data->index)
+    {
+        const INIIndex_t *index = data->index;
+        if (!index->section_count) return NULL;
+
+        for (size_t i = hash & (index->section_capacity - 1); index->sections[i].section; i = (i + 1) & (index->section_capacity - 1))
+        {
+            INISection_t *section = &data->sections[index->sections[i].section - 1];
+            if (index->sections[i].hash == hash && name_equals_(section, name))
+            {
+                load_section_(data, section);
+                return section;
+            }
+        }
+        return NULL;
+    }
+
+    for (unsigned i = 0; i < data->section_count; i++)
+    {
+        INISection_t *section = &data->sections[i];
+        if (name_equals_(section, name))
+        {
+            load_section_(data, section);
+            return section;
+        }
+    }
+    return NULL;
+}
+
+
+
+#ifdef INI_HAS_DIRENT
+// Returns the paths of the regular files in dir whose names match pattern,
+// sorted by name, or NULL on failure.
+static char **list_directory_(const INIAllocator_t *allocator, const char *dir, const char *pattern, unsigned *count)
+{
+    if (!has_heap_(allocator)) return NULL;
+
+    DIR *stream = opendir(dir);
+    if (!stream) return NULL;
+
+    unsigned allocation = 16;
+    char **paths = allocate_(allocator, sizeof(char *) * allocation);
+    *count = 0;
+
+    const size_t dir_length = strlen(dir);
+    const struct dirent *entry;
+    while (paths && (entry = readdir(stream)))
+    {
+        // Like a shell glob, wildcards don't match a leading '.'
+        if (fnmatch(pattern, entry->d_name, FNM_PERIOD) != 0) continue;
+
+        const size_t length = dir_length + 1 + strlen(entry->d_name) + 1;
+        char *path = allocate_(allocator, length);
+        if (!path) goto failed;
+        snprintf(path, length, "%s/%s", dir, entry->d_name);
+
+        struct stat info;
+        if (stat(path, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            deallocate_(allocator, path);
+            continue;
+        }
+
+        if (*count >= allocation)
+        {
+            allocation *= 2;
+            char **re = reallocate_(allocator, paths, sizeof(char *) * allocation);
+            if (!re)
+            {
+                deallocate_(allocator, path);
+                goto failed;
+            }
+            paths = re;
+        }
+        paths[(*count)++] = path;
+    }
+    closedir(stream);
+
+    if (paths) qsort(paths, *count, sizeof(char *), compare_paths_);
+    return paths;
+
+    failed:
+    closedir(stream);
+    free_paths_(allocator, paths, *count);
+    return NULL;
+}
+
+
+
+static void free_paths_(const INIAllocator_t *allocator, char **paths, const unsigned count)
+{
+    for (unsigned i = 0; i < count; i++)
+        deallocate_(allocator, paths[i]);
+    deallocate_(allocator, paths);
+}
+
+
+
+// Every path starts with the same directory, so this orders them by name.
+static int compare_paths_(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+#endif
+
+
+
+// Grows a section so it can hold at least count pairs.
+static bool reserve_pairs_(INISection_t *section, const unsigned count)
+{
+    if (count <= section->pair_allocation) return true;
+
+    // Pairs may move either way
+    INIData_t *data = section->data;
+    if (data) data->generation++;
+    if (data && data->pool) return grow_pooled_pairs_(section, count);
+
+    INIPair_t *re = grow_array_(data, section->pairs,
+        sizeof(INIPair_t) * section->pair_allocation,
+        sizeof(INIPair_t) * count);
+    if (!re) return false;
+    section->pairs = re;
+#ifdef INI_HAS_VALUE_CACHE
+    grow_cache_(section, count);
+#endif
+    section->pair_allocation = count;
+    return true;
+}
+
+
+
+#ifdef INI_HAS_VALUE_CACHE
+// Grows the converted values of a section along with its pairs, dropping
+// them if they can't grow. Values are then converted on every call.
+static void grow_cache_(INISection_t *section, const unsigned count)
+{
+    INIData_t *data = section->data;
+    const unsigned kept = section->cache ? section->pair_allocation : 0;
+    INICachedValue_t *re = grow_array_(data, section->cache,
+        sizeof(INICachedValue_t) * kept,
+        sizeof(INICachedValue_t) * count);
+    if (!re)
+    {
+        if (section->cache && (!data || !data->arena))
+            deallocate_(data ? &data->allocator : NULL, section->cache);
+        section->cache = NULL;
+        return;
+    }
+    memset(re + kept, 0, sizeof(INICachedValue_t) * (count - kept));
+    section->cache = re;
+}
+#endif
+
+
+
+// Makes room for count pairs in a section of a pooled database, moving the
+// pairs of the sections that follow it in the pool along. Sections read in
+// order only ever grow at the end of the pool, so nothing has to move.
+static bool grow_pooled_pairs_(INISection_t *section, const unsigned count)
+{
+    INIData_t *data = section->data;
+    const unsigned extra = count - section->pair_allocation;
+    if (extra > data->pool_size - data->pool_used) return false;
+
+    INIPair_t *end = data->pool + data->pool_used;
+    if (!section->pairs) section->pairs = end;
+
+    INIPair_t *grown = section->pairs + section->pair_allocation;
+    if (grown != end)
+    {
+        memmove(grown + extra, grown, sizeof(INIPair_t) * (size_t)(end - grown));
+        for (unsigned i = 0; i < data->section_count; i++)
+        {
+            INISection_t *other = &data->sections[i];
+            if (other != section && other->pairs && other->pairs >= grown)
+                other->pairs += extra;
+        }
+    }
+
+    section->pair_allocation = count;
+    data->pool_used += extra;
+    return true;
+}
+
+
+
+// Returns the next free pair slot of a section, growing the section if
+// needed. The slot only becomes part of the section once pair_count is
+// incremented.
+static INIPair_t *reserve_pair_(INISection_t *section)
+{
+    if (!section) return NULL;
+
+    if (section->pair_count >= section->pair_allocation)
+    {
+        // Pooled sections take no more than they need, and sections of a
+        // fixed arena start small as the space they outgrow stays taken
+        const INIData_t *data = section->data;
+        unsigned allocation = section->pair_allocation * 2;
+        if (data && data->pool)
+            allocation = section->pair_count + 1;
+        else if (!allocation && data && data->pair_reservation)
+            allocation = data->pair_reservation;
+        else if (!allocation)
+            allocation = data && data->arena && data->fixed ? 1 : INI_INITIAL_ALLOCATED_PAIRS;
+        if (!reserve_pairs_(section, allocation)) return NULL;
+    }
+
+    return &section->pairs[section->pair_count];
+}
+
+
+
+// Makes the pair reserve_pair_() handed out part of the section.
+static void commit_pair_(INISection_t *section)
+{
+    const unsigned pair = section->pair_count++;
+    forget_value_(section, pair);
+    INIData_t *data = section->data;
+    if (data) data->generation++;
+    if (data && data->index)
+        index_pair_(data, (unsigned)(section - data->sections), pair);
+}
+
+
+
+// Adds a section to the index of data, dropping the index if it can't grow.
+static void index_section_(INIData_t *data, const unsigned section)
+{
+    INIIndex_t *index = data->index;
+    const INIIndexSlot_t slot = { hash_name_(name_view_(&data->sections[section])), section + 1, 0 };
+    if (!insert_slot_(&data->allocator, &index->sections, &index->section_capacity, &index->section_count, slot))
+        ini_disable_index(data);
+}
+
+
+
+static void index_pair_(INIData_t *data, const unsigned section, const unsigned pair)
+{
+    INIIndex_t *index = data->index;
+    const INIIndexSlot_t slot = { hash_key_(section, hash_name_(key_view_(&data->sections[section].pairs[pair]))), section + 1, pair + 1 };
+    if (!insert_slot_(&data->allocator, &index->pairs, &index->pair_capacity, &index->pair_count, slot))
+        ini_disable_index(data);
+}
+
+
+
+// Inserts into a table, doubling it first if that would leave it more
+// than half full. Capacities are powers of two.
+static bool insert_slot_(const INIAllocator_t *allocator, INIIndexSlot_t **slots, size_t *capacity, size_t *count, const INIIndexSlot_t slot)
+{
+    if ((*count + 1) * 2 > *capacity)
+    {
+        const size_t grown_capacity = *capacity ? *capacity * 2 : 16;
+        INIIndexSlot_t *grown = allocate_(allocator, sizeof(INIIndexSlot_t) * grown_capacity);
+        if (!grown) return false;
+        memset(grown, 0, sizeof(INIIndexSlot_t) * grown_capacity);
+
+        for (size_t i = 0; i < *capacity; i++)
+        {
+            if (!(*slots)[i].section) continue;
+            size_t j = (*slots)[i].hash & (grown_capacity - 1);
+            while (grown[j].section) j = (j + 1) & (grown_capacity - 1);
+            grown[j] = (*slots)[i];
+        }
+
+        deallocate_(allocator, *slots);
+        *slots = grown;
+        *capacity = grown_capacity;
+    }
+
+    size_t i = slot.hash & (*capacity - 1);
+    while ((*slots)[i].section) i = (i + 1) & (*capacity - 1);
+    (*slots)[i] = slot;
+    (*count)++;
+    return true;
+}
+
+
+
+static uint64_t hash_name_(const INIView_t name)
+{
+    return hash_bytes_(name.data, name.length, 14695981039346656037ull);
+}
+
+
+
+// Pairs are told apart by the position of their section as well. Keys are
+// hashed on their own, so a hash from ini_key() only needs the position
+// mixed in.
+static uint64_t hash_key_(const unsigned section, const uint64_t key_hash)
+{
+    return mix_(key_hash ^ ((uint64_t)(section + 1) * 0x9e3779b97f4a7c15ull));
+}
+
+
+
+// FNV-1a
+static uint64_t hash_bytes_(const char *bytes, const size_t length, uint64_t hash)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+
+
+// A hash of both the section and the key, with all bits well mixed since
+// the perfect hash picks buckets and slots from different ones.
+static uint64_t hash_pair_(const uint64_t seed, const INIView_t section, const INIView_t key)
+{
+    return mix_(hash_bytes_(key.data, key.length, mix_(hash_bytes_(section.data, section.length, seed))));
+}
+
+
+
+// splitmix64 finalizer
+static uint64_t mix_(uint64_t hash)
+{
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31);
+}
+
+
+
+// Sorts entries by hash and drops every pair whose key was already seen
+// earlier in the same section, returning how many are left. Sets retry if
+// two different pairs share a hash.
+static unsigned drop_duplicates_(const INIData_t *data, INIIndexSlot_t *entries, const unsigned count, bool *retry)
+{
+    *retry = false;
+    qsort(entries, count, sizeof(INIIndexSlot_t), compare_entries_);
+
+    unsigned kept = 0;
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (kept && entries[kept - 1].hash == entries[i].hash)
+        {
+            const INIIndexSlot_t *previous = &entries[kept - 1];
+            const INISection_t *section = &data->sections[previous->section];
+            if (previous->section == entries[i].section && key_equals_(&section->pairs[entries[i].pair], key_view_(&section->pairs[previous->pair])))
+                continue;
+            *retry = true;
+        }
+        entries[kept++] = entries[i];
+    }
+    return kept;
+}
+
+
+
+// Orders by hash, then by position so the first of duplicates comes first.
+static int compare_entries_(const void *a, const void *b)
+{
+    const INIIndexSlot_t *x = a;
+    const INIIndexSlot_t *y = b;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    if (x->section != y->section) return x->section < y->section ? -1 : 1;
+    if (x->pair != y->pair) return x->pair < y->pair ? -1 : 1;
+    return 0;
+}
+
+
+
+// Builds a frozen database out of distinct entries with hash-and-displace:
+// every entry falls into one of count buckets, and each bucket gets the
+// displacement that moves all of its entries to free slots, biggest
+// buckets first. Buckets of a single entry just take a free slot, stored
+// as a negative displacement. Sets retry if no displacement works.
+static INIFrozen_t *build_frozen_(const INIData_t *data, const INIIndexSlot_t *entries, const unsigned count, const uint64_t seed, bool *retry)
+{
+    const INIAllocator_t *allocator = &data->allocator;
+    *retry = false;
+
+    // Scratch: where each bucket starts in members, the entries grouped
+    // by bucket, the entry in each slot, and where the name of each
+    // section went in the strings
+    const size_t scratch_count = (size_t)count + 1 + count + count + data->section_count;
+    uint32_t *scratch = allocate_(allocator, sizeof(uint32_t) * scratch_count);
+    if (!scratch) return NULL;
+    uint32_t *starts = scratch;
+    uint32_t *members = starts + count + 1;
+    uint32_t *owners = members + count;
+    uint32_t *names = owners + count;
+
+    size_t string_size = 0;
+    for (unsigned i = 0; i < data->section_count; i++)
+        names[i] = UINT32_MAX;
+    for (unsigned i = 0; i < count; i++)
+    {
+        const INISection_t *section = &data->sections[entries[i].section];
+        if (names[entries[i].section] == UINT32_MAX)
+        {
+            names[entries[i].section] = 0;
+            string_size += name_view_(section).length + 1;
+        }
+        string_size += key_view_(&section->pairs[entries[i].pair]).length + 1;
+        string_size += value_view_(&section->pairs[entries[i].pair]).length + 1;
+    }
+
+    const size_t displacements_offset = align_up_(sizeof(INIFrozen_t), _Alignof(int32_t));
+    const size_t pairs_offset = align_up_(displacements_offset + sizeof(int32_t) * count, _Alignof(INIFrozenPair_t));
+    const size_t strings_offset = pairs_offset + sizeof(INIFrozenPair_t) * count;
+    INIFrozen_t *frozen = string_size <= UINT32_MAX ? allocate_(allocator, strings_offset + string_size) : NULL;
+    if (!frozen)
+    {
+        deallocate_(allocator, scratch);
+        return NULL;
+    }
+
+    int32_t *displacements = (int32_t *)((char *)frozen + displacements_offset);
+    INIFrozenPair_t *pairs = (INIFrozenPair_t *)((char *)frozen + pairs_offset);
+    char *strings = (char *)frozen + strings_offset;
+    frozen->allocator = *allocator;
+    frozen->seed = seed;
+    frozen->pair_count = count;
+    frozen->displacements = displacements;
+    frozen->pairs = pairs;
+    frozen->strings = strings;
+    frozen->strings_size = string_size;
+    frozen->image = NULL;
+    frozen->image_length = 0;
+    frozen->mapped = false;
+
+    // Group the entries by bucket
+    memset(starts, 0, sizeof(uint32_t) * (count + 1));
+    for (unsigned i = 0; i < count; i++)
+        starts[(entries[i].hash >> 32) % count + 1]++;
+    uint32_t largest = 0;
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (starts[i + 1] > largest) largest = starts[i + 1];
+        starts[i + 1] += starts[i];
+    }
+    for (unsigned i = 0; i < count; i++)
+        owners[i] = 0;
+    for (unsigned i = 0; i < count; i++)
+    {
+        const uint32_t bucket = (uint32_t)((entries[i].hash >> 32) % count);
+        members[starts[bucket] + owners[bucket]++] = i;
+    }
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        owners[i] = UINT32_MAX;
+        displacements[i] = 0;
+    }
+    for (uint32_t size = largest; size > 1; size--)
+        for (unsigned bucket = 0; bucket < count; bucket++)
+            if (starts[bucket + 1] - starts[bucket] == size
+            &&  !place_bucket_(entries, &members[starts[bucket]], size, count, owners, &displacements[bucket]))
+            {
+                *retry = true;
+                deallocate_(allocator, frozen);
+                deallocate_(allocator, scratch);
+                return NULL;
+            }
+
+    uint32_t free_slot = 0;
+    for (unsigned bucket = 0; bucket < count; bucket++)
+    {
+        if (starts[bucket + 1] - starts[bucket] != 1) continue;
+        while (owners[free_slot] != UINT32_MAX) free_slot++;
+        owners[free_slot] = members[starts[bucket]];
+        displacements[bucket] = -(int32_t)free_slot - 1;
+    }
+
+    // Strings go in slot order, so neighbouring slots are close in memory
+    size_t offset = 0;
+    for (uint32_t slot = 0; slot < count; slot++)
+    {
+        const INIIndexSlot_t *entry = &entries[owners[slot]];
+        const INISection_t *section = &data->sections[entry->section];
+        const INIPair_t *pair = &section->pairs[entry->pair];
+        const INIView_t name = name_view_(section);
+        const INIView_t key = key_view_(pair);
+        const INIView_t value = value_view_(pair);
+
+        if (!names[entry->section])
+        {
+            names[entry->section] = (uint32_t)offset + 1;
+            memcpy(strings + offset, name.data, name.length);
+            strings[offset + name.length] = '\0';
+            offset += name.length + 1;
+        }
+
+        pairs[slot].section = names[entry->section] - 1;
+        pairs[slot].section_length = (uint32_t)name.length;
+        pairs[slot].key = (uint32_t)offset;
+        pairs[slot].key_length = (uint32_t)key.length;
+        memcpy(strings + offset, key.data, key.length);
+        strings[offset + key.length] = '\0';
+        offset += key.length + 1;
+        pairs[slot].value = (uint32_t)offset;
+        memcpy(strings + offset, value.data, value.length);
+        strings[offset + value.length] = '\0';
+        offset += value.length + 1;
+    }
+
+    deallocate_(allocator, scratch);
+    return frozen;
+}
+
+
+
+// Finds a displacement that sends every member of a bucket to its own
+// free slot, and takes those slots.
+static bool place_bucket_(const INIIndexSlot_t *entries, const uint32_t *members, const uint32_t size, const uint32_t count, uint32_t *owners, int32_t *displacement)
+{
+    for (int32_t d = 0; d < FROZEN_DISPLACEMENTS_; d++)
+    {
+        bool fits = true;
+        for (uint32_t i = 0; i < size && fits; i++)
+        {
+            const uint32_t slot = displace_(entries[members[i]].hash, d, count);
+            fits = owners[slot] == UINT32_MAX;
+            for (uint32_t j = 0; j < i && fits; j++)
+                fits = displace_(entries[members[j]].hash, d, count) != slot;
+        }
+        if (!fits) continue;
+
+        for (uint32_t i = 0; i < size; i++)
+            owners[displace_(entries[members[i]].hash, d, count)] = members[i];
+        *displacement = d;
+        return true;
+    }
+    return false;
+}
+
+
+
+// Slots taken directly are checked when an image is opened, and kept
+// below count here all the same.
+static uint32_t frozen_slot_(const uint64_t hash, const int32_t *displacements, const uint32_t count)
+{
+    const int32_t displacement = displacements[(hash >> 32) % count];
+    if (displacement < 0) return (uint32_t)-(displacement + 1) % count;
+    return displace_(hash, displacement, count);
+}
+
+
+
+static uint32_t displace_(const uint64_t hash, const int32_t displacement, const uint32_t count)
+{
+    return (uint32_t)(((uint32_t)hash + (uint64_t)displacement * ((uint32_t)(hash >> 32) | 1)) % count);
+}
+
+
+
+// Freezes data and fills in the header of its compiled image. The image
+// is the header followed by header->size - sizeof(*header) bytes from
+// body, which point into the returned frozen database.
+static INIFrozen_t *freeze_image_(const INIData_t *data, INICompiledHeader_t *header, const char **body)
+{
+    INIFrozen_t *frozen = ini_freeze(data);
+    if (!frozen) return NULL;
+
+    // Everything following the header of a frozen database is already
+    // in one piece and free of pointers, so it's used as it is
+    *body = (const char *)frozen->displacements;
+    const size_t body_size = (size_t)(frozen->strings + frozen->strings_size - *body);
+
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, COMPILED_MAGIC_, sizeof(header->magic));
+    header->byte_order = COMPILED_BYTE_ORDER_;
+    header->version = COMPILED_VERSION_;
+    header->pair_count = frozen->pair_count;
+    header->seed = frozen->seed;
+    header->displacements = sizeof(*header);
+    header->pairs = sizeof(*header) + (uint64_t)((const char *)frozen->pairs - *body);
+    header->strings = sizeof(*header) + (uint64_t)(frozen->strings - *body);
+    header->size = sizeof(*header) + body_size;
+    header->checksum = checksum_(*body, body_size);
+    return frozen;
+}
+
+
+
+// Freezes data and writes it as a compiled image.
+static bool write_image_(const INIData_t *data, FILE *file)
+{
+    INICompiledHeader_t header;
+    const char *body;
+    INIFrozen_t *frozen = freeze_image_(data, &header, &body);
+    if (!frozen) return false;
+
+    const size_t body_size = (size_t)header.size - sizeof(header);
+    const bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                      && fwrite(body, 1, body_size, file) == body_size;
+    ini_free_frozen(frozen);
+    return written;
+}
+
+
+
+#ifdef INI_HAS_MMAP
+// Maps the compiled image in a file read-only. A shared mapping is
+// needed for memory that other processes attach to as well.
+static INIFrozen_t *map_image_(const int fd, const bool shared)
+{
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) return NULL;
+
+    const size_t length = (size_t)info.st_size;
+    void *mapping = mmap(NULL, length, PROT_READ, shared ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) return NULL;
+
+    INIFrozen_t *frozen = open_image_(mapping, mapping, length, true);
+    if (!frozen) munmap(mapping, length);
+    return frozen;
+}
+#endif
+
+
+
+// Makes a frozen database out of the contents of a compiled image, which
+// it then owns. image is what has to be unmapped or freed for it.
+static INIFrozen_t *open_image_(const char *contents, void *image, const size_t length, const bool mapped)
+{
+    INICompiledHeader_t header;
+    if (length < sizeof(header)) return NULL;
+    memcpy(&header, contents, sizeof(header));
+    if (!is_valid_image_(&header, contents, length)) return NULL;
+
+    INIFrozen_t *frozen = allocate_(NULL, sizeof(INIFrozen_t));
+    if (!frozen) return NULL;
+
+    frozen->allocator = (INIAllocator_t){ NULL, NULL, NULL, NULL };
+    frozen->seed = header.seed;
+    frozen->pair_count = header.pair_count;
+    frozen->displacements = (const int32_t *)(contents + header.displacements);
+    frozen->pairs = (const INIFrozenPair_t *)(contents + header.pairs);
+    frozen->strings = contents + header.strings;
+    frozen->strings_size = (size_t)(header.size - header.strings);
+    frozen->image = image;
+    frozen->image_length = length;
+    frozen->mapped = mapped;
+    return frozen;
+}
+
+
+
+// Checks that the tables of an image are where this version puts them,
+// that its contents match the checksum, and that every displacement and
+// string offset stays inside the image, so lookups can trust it.
+static bool is_valid_image_(const INICompiledHeader_t *header, const char *image, const size_t length)
+{
+    const uint64_t count = header->pair_count;
+    if (memcmp(header->magic, COMPILED_MAGIC_, sizeof(header->magic)) != 0
+    ||  header->byte_order != COMPILED_BYTE_ORDER_
+    ||  header->version != COMPILED_VERSION_
+    ||  header->size != length
+    ||  header->displacements != sizeof(INICompiledHeader_t)
+    ||  header->pairs != header->displacements + sizeof(int32_t) * count
+    ||  header->strings != header->pairs + sizeof(INIFrozenPair_t) * count
+    ||  header->strings > header->size
+    ||  header->checksum != checksum_(image + sizeof(INICompiledHeader_t), length - sizeof(INICompiledHeader_t)))
+        return false;
+
+    // With the last string terminated, every offset inside the strings
+    // starts a null-terminated one
+    const char *strings = image + header->strings;
+    const uint64_t strings_size = header->size - header->strings;
+    if (count && (!strings_size || strings[strings_size - 1] != '\0')) return false;
+
+    const int32_t *displacements = (const int32_t *)(image + header->displacements);
+    const INIFrozenPair_t *pairs = (const INIFrozenPair_t *)(image + header->pairs);
+    for (uint64_t i = 0; i < count; i++)
+    {
+        if (displacements[i] < 0 && (uint64_t)-(displacements[i] + 1) >= count) return false;
+
+        const INIFrozenPair_t *pair = &pairs[i];
+        if ((uint64_t)pair->section + pair->section_length >= strings_size
+        ||  (uint64_t)pair->key + pair->key_length >= strings_size
+        ||  pair->value >= strings_size
+        ||  strings[pair->section + pair->section_length] != '\0'
+        ||  strings[pair->key + pair->key_length] != '\0')
+            return false;
+    }
+    return true;
+}
+
+
+
+// FNV-1a, eight bytes at a time
+static uint64_t checksum_(const char *bytes, const size_t length)
+{
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    return hash_bytes_(bytes + i, length - i, hash);
+}
+
+
+
+static INIView_t name_view_(const INISection_t *section)
+{
+#ifdef INI_COMPACT_STRINGS
+    return (INIView_t){ section->name, section->name_length };
+#else
+    return (INIView_t){ section->name, strlen(section->name) };
+#endif
+}
+
+
+
+static INIView_t key_view_(const INIPair_t *pair)
+{
+#ifdef INI_COMPACT_STRINGS
+    return (INIView_t){ pair->key, pair->key_length };
+#else
+    return (INIView_t){ pair->key, strlen(pair->key) };
+#endif
+}
+
+
+
+static INIView_t value_view_(const INIPair_t *pair)
+{
+#ifdef INI_COMPACT_STRINGS
+    return (INIView_t){ pair->value, pair->value_length };
+#else
+    return (INIView_t){ pair->value, strlen(pair->value) };
+#endif
+}
+
+
+
+// The value of pair as a C string, or NULL if pair is NULL or data was
+// read with INI_BORROW_STRINGS, whose values aren't null-terminated and
+// are only handed out as views.
+static const char *terminated_value_(const INIData_t *data, const INIPair_t *pair)
+{
+    if (!pair || data->borrowed) return NULL;
+    return pair->value;
+}
+
+
+
+static INIPair_t *find_pair_(const INISection_t *section, const INIView_t key)
+{
+    const INIData_t *data = section->data;
+    return find_hashed_pair_(section, key, data && data->index ? hash_name_(key) : 0);
+}
+
+
+
+// find_pair_() with the hash of key on its own already known, which is
+// only used with an index.
+static INIPair_t *find_hashed_pair_(const INISection_t *section, const INIView_t key, const uint64_t key_hash)
+{
+    const INIData_t *data = section->data;
+    if (data && data->index)
+    {
+        const INIIndex_t *index = data->index;
+        if (!index->pair_count) return NULL;
+
+        const unsigned position = (unsigned)(section - data->sections);
+        const uint64_t hash = hash_key_(position, key_hash);
+        for (size_t i = hash & (index->pair_capacity - 1); index->pairs[i].section; i = (i + 1) & (index->pair_capacity - 1))
+        {
+            const INIIndexSlot_t *slot = &index->pairs[i];
+            if (slot->hash == hash && slot->section == position + 1 && key_equals_(&section->pairs[slot->pair - 1], key))
+                return &section->pairs[slot->pair - 1];
+        }
+        return NULL;
+    }
+
+    for (unsigned i = 0; i < section->pair_count; i++)
+        if (key_equals_(&section->pairs[i], key))
+            return &section->pairs[i];
+    return NULL;
+}
+
+
+
+// Keys and values from the parser are known to fit without
+// INI_COMPACT_STRINGS. With it, they're copied to the string area of the
+// database the section belongs to, or borrowed. See keep_string_().
+static bool set_key_(INISection_t *section, INIPair_t *pair, const INIView_t key, const bool borrow)
+{
+#ifdef INI_COMPACT_STRINGS
+    const char *kept = keep_string_(section->data, key, borrow);
+    if (!kept) return false;
+    pair->key = kept;
+    pair->key_length = key.length;
+#else
+    (void)section;
+    (void)borrow;
+    copy_view_(pair->key, key);
+#endif
+    return true;
+}
+
+
+
+static bool set_value_(INISection_t *section, INIPair_t *pair, const INIView_t value, const bool borrow)
+{
+#ifdef INI_COMPACT_STRINGS
+    const char *kept = keep_string_(section->data, value, borrow);
+    if (!kept) return false;
+    pair->value = kept;
+    pair->value_length = value.length;
+#else
+    (void)borrow;
+    copy_view_(pair->value, value);
+#endif
+    forget_value_(section, (unsigned)(pair - section->pairs));
+    return true;
+}
+
+
+
+static bool name_equals_(const INISection_t *section, const INIView_t name)
+{
+#ifdef INI_COMPACT_STRINGS
+    return section->name_length == name.length && memcmp(section->name, name.data, name.length) == 0;
+#else
+    return name.length < INI_MAX_STRING_SIZE
+        && memcmp(section->name, name.data, name.length) == 0
+        && section->name[name.length] == '\0';
+#endif
+}
+
+
+
+static bool key_equals_(const INIPair_t *pair, const INIView_t key)
+{
+#ifdef INI_COMPACT_STRINGS
+    return pair->key_length == key.length && memcmp(pair->key, key.data, key.length) == 0;
+#else
+    return key.length < INI_MAX_STRING_SIZE
+        && memcmp(pair->key, key.data, key.length) == 0
+        && pair->key[key.length] == '\0';
+#endif
+}
+
+
+
+#ifdef INI_COMPACT_STRINGS
+// What a string of data is kept as: the view itself if borrowed from
+// contents that outlive data, or else a copy in its string area. Empty
+// views may point anywhere, so those are kept as "".
+static const char *keep_string_(INIData_t *data, const INIView_t view, const bool borrow)
+{
+    if (!borrow) return store_string_(data, view);
+    return view.length ? view.data : "";
+}
+
+
+
+// Copies a view to the string area of data and null-terminates it.
+static const char *store_string_(INIData_t *data, const INIView_t view)
+{
+    char *string = carve_(data, view.length + 1, 1);
+    if (!string) return NULL;
+    memcpy(string, view.data, view.length);
+    string[view.length] = '\0';
+    return string;
+}
+#endif
+
+
+
+// Makes an empty heap database with room for sections sections. Pairs
+// are only allocated once a section gets its first, pairs_per_section at
+// a time, so unused sections cost nothing but their slot.
+static INIData_t *create_data_(const INIAllocator_t *allocator, const unsigned sections, const unsigned pairs_per_section)
+{
+    if (allocator && (!allocator->alloc || !allocator->realloc || !allocator->free)) return NULL;
+
+    INIData_t *data = allocate_(allocator, sizeof(INIData_t));
+    if (!data) return NULL;
+
+    data->section_count = 0;
+    data->section_allocation = sections ? sections : INI_INITIAL_ALLOCATED_SECTIONS;
+    data->pair_reservation = pairs_per_section;
+    data->pool = NULL;
+    data->pool_size = 0;
+    data->pool_used = 0;
+    data->flags = 0;
+    data->sources = NULL;
+    data->arena = false;
+    data->fixed = false;
+    data->borrowed = false;
+    data->blocks = NULL;
+    data->allocator = allocator ? *allocator : (INIAllocator_t){ NULL, NULL, NULL, NULL };
+    data->index = NULL;
+    data->generation = first_generation_();
+    data->sections = allocate_(allocator, sizeof(INISection_t) * data->section_allocation);
+    if (!data->sections)
+    {
+        deallocate_(allocator, data);
+        return NULL;
+    }
+    init_sections_(data, 0, data->section_allocation);
+    return data;
+}
+
+
+
+// Databases count their generations from a start of their own, so a
+// handle resolved against one never looks current for another that took
+// its place in memory.
+static uint64_t first_generation_(void)
+{
+    static uint64_t databases = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_add_fetch(&databases, 1, __ATOMIC_RELAXED) << 32;
+#else
+    return ++databases << 32;
+#endif
+}
+
+
+
+// Readies the section slots from begin to end. They get their pairs once
+// they're needed.
+static void init_sections_(INIData_t *data, const unsigned begin, const unsigned end)
+{
+    for (unsigned i = begin; i < end; i++)
+    {
+        INISection_t *section = &data->sections[i];
+        section->data = data;
+        section->pairs = NULL;
+        section->cache = NULL;
+        section->pair_count = 0;
+        section->pair_allocation = 0;
+        section->body = NULL;
+    }
+}
+
+
+
+// Places an arena database at the start of buffer, with the rest of the
+// buffer as its first block.
+static INIData_t *init_arena_(void *buffer, const size_t size, const bool fixed)
+{
+    if (size < ARENA_BLOCK_OFFSET_ + sizeof(INIBlock_t)) return NULL;
+
+    INIBlock_t *block = (INIBlock_t *)((char *)buffer + ARENA_BLOCK_OFFSET_);
+    block->next = NULL;
+    block->used = 0;
+    block->size = size - ARENA_BLOCK_OFFSET_ - sizeof(INIBlock_t);
+
+    INIData_t *data = buffer;
+    data->section_count = 0;
+    data->section_allocation = 0;
+    data->pair_reservation = 0;
+    data->pool = NULL;
+    data->pool_size = 0;
+    data->pool_used = 0;
+    data->flags = 0;
+    data->sources = NULL;
+    data->arena = true;
+    data->fixed = fixed;
+    data->borrowed = false;
+    data->blocks = block;
+    data->allocator = (INIAllocator_t){ NULL, NULL, NULL, NULL };
+    data->index = NULL;
+    data->generation = first_generation_();
+    data->sections = carve_(data, sizeof(INISection_t) * INI_INITIAL_ALLOCATED_SECTIONS, _Alignof(INISection_t));
+    if (!data->sections) return NULL;
+    init_sections_(data, 0, INI_INITIAL_ALLOCATED_SECTIONS);
+    data->section_allocation = INI_INITIAL_ALLOCATED_SECTIONS;
+    return data;
+}
+
+
+
+// Returns size bytes from the blocks of data, adding a block if none has
+// room unless the database is fixed.
+static void *carve_(INIData_t *data, const size_t size, const size_t alignment)
+{
+    INIBlock_t *block = data->blocks;
+    size_t offset = block ? align_up_(block->used, alignment) : 0;
+
+    if (!block || offset > block->size || block->size - offset < size)
+    {
+        if (data->fixed) return NULL;
+        const size_t block_size = data->arena ? INI_ARENA_BLOCK_SIZE : INI_STRING_BLOCK_SIZE;
+        const size_t capacity = size > block_size ? size : block_size;
+        INIBlock_t *added = allocate_(&data->allocator, sizeof(INIBlock_t) + capacity);
+        if (!added) return NULL;
+        added->used = 0;
+        added->size = capacity;
+
+        // An oversized request gets a block of its own, which goes behind
+        // the current one so its space isn't lost
+        if (block && capacity > block_size)
+        {
+            added->next = block->next;
+            block->next = added;
+        }
+        else
+        {
+            added->next = block;
+            data->blocks = added;
+        }
+        block = added;
+        offset = 0;
+    }
+
+    block->used = offset + size;
+    return (char *)block->bytes + offset;
+}
+
+
+
+// Grows an array of sections or pairs belonging to data. Arena arrays
+// are extended in place if they were the last thing carved, and copied
+// otherwise.
+static void *grow_array_(INIData_t *data, void *array, const size_t old_size, const size_t new_size)
+{
+    if (!data || !data->arena)
+        return reallocate_(data ? &data->allocator : NULL, array, new_size);
+
+    INIBlock_t *block = data->blocks;
+    if (array && (char *)array + old_size == (char *)block->bytes + block->used
+    &&  new_size - old_size <= block->size - block->used)
+    {
+        block->used += new_size - old_size;
+        return array;
+    }
+
+    void *grown = carve_(data, new_size, _Alignof(max_align_t));
+    if (grown && array) memcpy(grown, array, old_size);
+    return grown;
+}
+
+
+
+#if defined(INI_HAS_THREADS) && defined(INI_COMPACT_STRINGS)
+// Moves the blocks of from over to data.
+static void adopt_blocks_(INIData_t *data, INIData_t *from)
+{
+    if (!from->blocks) return;
+
+    INIBlock_t *last = from->blocks;
+    while (last->next) last = last->next;
+
+    if (data->blocks)
+    {
+        last->next = data->blocks->next;
+        data->blocks->next = from->blocks;
+    }
+    else data->blocks = from->blocks;
+    from->blocks = NULL;
+}
+#endif
+
+
+
+static size_t align_up_(const size_t n, const size_t alignment)
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+
+
+// The allocation functions below go through allocator if it's given and
+// set, and through the process-wide functions otherwise.
+static void *allocate_(const INIAllocator_t *allocator, const size_t size)
+{
+    if (allocator && allocator->alloc) return allocator->alloc(allocator->ctx, size);
+    return ini_malloc_ ? ini_malloc_(size) : NULL;
+}
+
+
+
+static void *reallocate_(const INIAllocator_t *allocator, void *ptr, const size_t size)
+{
+    if (allocator && allocator->alloc) return allocator->realloc(allocator->ctx, ptr, size);
+    return ini_realloc_ ? ini_realloc_(ptr, size) : NULL;
+}
+
+
+
+static void deallocate_(const INIAllocator_t *allocator, void *ptr)
+{
+    if (allocator && allocator->alloc) allocator->free(allocator->ctx, ptr);
+    else if (ini_free_) ini_free_(ptr);
+}
+
+
+
+static bool has_heap_(const INIAllocator_t *allocator)
+{
+    return (allocator && allocator->alloc) || (ini_malloc_ && ini_realloc_ && ini_free_);
+}
+
+
+
+// The conversions of the typed getters, returning default_value if str is
+// NULL or doesn't start with a number.
+static unsigned long long to_unsigned_(const char *str, const int base, const unsigned long long default_value)
+{
+    INICachedValue_t converted;
+    return convert_value_(str, base == 16 ? INI_CACHED_HEX : INI_CACHED_UNSIGNED, &converted) < INI_CONVERT_INVALID ? converted.value.u : default_value;
+}
+
+
+
+static long long to_signed_(const char *str, const long long default_value)
+{
+    INICachedValue_t converted;
+    return convert_value_(str, INI_CACHED_SIGNED, &converted) < INI_CONVERT_INVALID ? converted.value.s : default_value;
+}
+
+
+
+static long double to_float_(const char *str, const long double default_value)
+{
+    INICachedValue_t converted;
+    return convert_value_(str, INI_CACHED_FLOAT, &converted) < INI_CONVERT_INVALID ? converted.value.f : default_value;
+}
+
+
+
+static bool to_bool_(const char *str, const bool default_value)
+{
+    INICachedValue_t converted;
+    return convert_value_(str, INI_CACHED_BOOL, &converted) < INI_CONVERT_INVALID ? converted.value.b : default_value;
+}
+
+
+
+// Converts str as one of the INI_CACHED_* kinds, returning one of the
+// INI_CONVERT_* outcomes.
+static int convert_value_(const char *str, const unsigned char kind, INICachedValue_t *converted)
+{
+    if (!str) return INI_CONVERT_MISSING;
+
+    switch (kind)
+    {
+        case INI_CACHED_UNSIGNED:
+            return parse_integer_(str, 10, false, converted);
+
+        case INI_CACHED_HEX:
+            return parse_integer_(str, 16, false, converted);
+
+        case INI_CACHED_SIGNED:
+            return parse_integer_(str, 10, true, converted);
+
+        case INI_CACHED_FLOAT:
+            return parse_long_double_(str, &converted->value.f);
+
+        case INI_CACHED_DOUBLE:
+            return parse_double_(str, &converted->value.d);
+
+        case INI_CACHED_BOOL:
+            if (strcmp(str, "true") == 0) converted->value.b = true;
+            else if (strcmp(str, "false") == 0) converted->value.b = false;
+            else return INI_CONVERT_INVALID;
+            return INI_CONVERTED;
+
+        default:
+            return INI_CONVERT_INVALID;
+    }
+}
+
+
+
+// Parses an integer the way strtoull() or strtoll() would, without locale
+// lookups or errno. Out of range values are clamped like theirs are.
+static int parse_integer_(const char *str, const int base, const bool is_signed, INICachedValue_t *converted)
+{
+    const char *c = str;
+    while (is_space_(*c)) c++;
+
+    const bool negative = *c == '-';
+    if (*c == '-' || *c == '+') c++;
+    if (base == 16 && c[0] == '0' && (c[1] == 'x' || c[1] == 'X') && digit_value_(c[2]) < 16) c += 2;
+
+    const char *digits = c;
+    unsigned long long magnitude = 0;
+    bool overflow = false;
+    for (unsigned digit; (digit = digit_value_(*c)) < (unsigned)base; c++)
+    {
+        if (magnitude > (ULLONG_MAX - digit) / (unsigned)base) overflow = true;
+        else magnitude = magnitude * (unsigned)base + digit;
+    }
+    if (c == digits) return INI_CONVERT_INVALID;
+
+    if (is_signed)
+    {
+        const unsigned long long limit = negative ? (unsigned long long)LLONG_MAX + 1 : LLONG_MAX;
+        if (overflow || magnitude > limit)
+        {
+            overflow = true;
+            magnitude = limit;
+        }
+        converted->value.s = negative && magnitude ? -(long long)(magnitude - 1) - 1 : (long long)magnitude;
+    }
+    else if (overflow)
+        converted->value.u = ULLONG_MAX;
+    else
+        converted->value.u = negative ? 0 - magnitude : magnitude;
+
+    if (overflow) return INI_CONVERT_OVERFLOW;
+    return *c ? INI_CONVERT_TRAILING : INI_CONVERTED;
+}
+
+
+
+// Parses a decimal number into the nearest double without locale lookups.
+// When the significant digits and the power of ten are both exact doubles,
+// one multiplication or division rounds correctly (Clinger's fast path).
+// Up to 19 digits with any exponent are rounded by eisel_lemire_(). Only
+// longer numbers, hexadecimal ones, infinities, NaNs and results that
+// don't settle there take the exact path of parse_float_().
+static int parse_double_(const char *str, double *value)
+{
+    static const double powers[] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char *c = str;
+    while (is_space_(*c)) c++;
+
+    const bool negative = *c == '-';
+    if (*c == '-' || *c == '+') c++;
+
+    // Up to 19 significant digits fit, the rest only shift the exponent
+    unsigned long long mantissa = 0;
+    int significant = 0;
+    long exponent = 0;
+    bool exact = (*c >= '0' && *c <= '9') || (*c == '.' && c[1] >= '0' && c[1] <= '9');
+    if (c[0] == '0' && (c[1] == 'x' || c[1] == 'X')) exact = false;
+    for (; exact && *c >= '0' && *c <= '9'; c++)
+    {
+        if (significant < 19)
+        {
+            mantissa = mantissa * 10 + (unsigned)(*c - '0');
+            if (mantissa) significant++;
+        }
+        else
+        {
+            exact = *c == '0';
+            exponent++;
+        }
+    }
+    if (exact && *c == '.')
+    {
+        for (c++; exact && *c >= '0' && *c <= '9'; c++)
+        {
+            if (significant < 19)
+            {
+                mantissa = mantissa * 10 + (unsigned)(*c - '0');
+                if (mantissa) significant++;
+                exponent--;
+            }
+            else
+                exact = *c == '0';
+        }
+    }
+    if (exact && (*c == 'e' || *c == 'E')
+    &&  ((c[1] >= '0' && c[1] <= '9') || ((c[1] == '-' || c[1] == '+') && c[2] >= '0' && c[2] <= '9')))
+    {
+        c++;
+        const bool negative_exponent = *c == '-';
+        if (*c == '-' || *c == '+') c++;
+
+        long written = 0;
+        for (; *c >= '0' && *c <= '9'; c++)
+            if (written < 100000) written = written * 10 + (*c - '0');
+        exponent += negative_exponent ? -written : written;
+    }
+
+#if FLT_EVAL_METHOD == 0
+    if (exact && (!mantissa || (mantissa <= 1ull << 53 && exponent >= -22 && exponent <= 22)))
+    {
+        // Zero can come with any exponent
+        double result = (double)mantissa;
+        if (mantissa && exponent < 0) result /= powers[-exponent];
+        else if (mantissa) result *= powers[exponent];
+        *value = negative ? -result : result;
+        return *c ? INI_CONVERT_TRAILING : INI_CONVERTED;
+    }
+#else
+    (void)powers;
+#endif
+
+    double nearest;
+    if (exact && eisel_lemire_(mantissa, exponent, &nearest))
+    {
+        *value = negative ? -nearest : nearest;
+        return *c ? INI_CONVERT_TRAILING : INI_CONVERTED;
+    }
+
+    static const INIFloatFormat_t format = { DBL_MANT_DIG - 1, DBL_MIN_EXP - 1, DBL_MAX_EXP };
+    long double result;
+    const int status = parse_float_(str, &format, &result);
+    *value = (double)result;
+    return status;
+}
+
+
+
+// parse_double_() for long doubles. Those of more than 64 bits, like
+// binary128 or double-double, are rounded in a 128 bit INIMantissa_t, and
+// only read by strtold(), which follows the locale, without one.
+static int parse_long_double_(const char *str, long double *value)
+{
+#if LDBL_MANT_DIG == DBL_MANT_DIG
+    double result;
+    const int status = parse_double_(str, &result);
+    *value = result;
+    return status;
+#elif LDBL_MANT_DIG > 64 && !defined(INI_HAS_WIDE_MANTISSA)
+    char *end;
+    const int saved = errno;
+    errno = 0;
+    *value = strtold(str, &end);
+    const bool range = errno == ERANGE && (*value == 0 || isinf(*value));
+    errno = saved;
+    if (end == str) return INI_CONVERT_INVALID;
+    if (range) return INI_CONVERT_OVERFLOW;
+    return *end ? INI_CONVERT_TRAILING : INI_CONVERTED;
+#else
+    static const INIFloatFormat_t format = { LDBL_MANT_DIG - 1, LDBL_MIN_EXP - 1, LDBL_MAX_EXP };
+    return parse_float_(str, &format, value);
+#endif
+}
+
+
+
+// Parses a number the way strtod() would, decimal or hexadecimal, infinity
+// or NaN, without locale lookups, into the nearest value of format, ties to
+// even. Decimal numbers are exactly rounded as long as the digits that
+// matter fit in DECIMAL_DIGITS_, which always holds for doubles and takes
+// hundreds of digits not to for wider types.
+static int parse_float_(const char *str, const INIFloatFormat_t *format, long double *value)
+{
+    const char *c = str;
+    while (is_space_(*c)) c++;
+
+    const bool negative = *c == '-';
+    if (*c == '-' || *c == '+') c++;
+
+    INIMantissa_t mantissa;
+    int exponent;
+    int status;
+    if (c[0] == '0' && (c[1] == 'x' || c[1] == 'X')
+    &&  (digit_value_(c[2]) < 16 || (c[2] == '.' && digit_value_(c[3]) < 16)))
+        c = read_hex_float_(c + 2, format, &mantissa, &exponent, &status);
+    else if ((*c >= '0' && *c <= '9') || (*c == '.' && c[1] >= '0' && c[1] <= '9'))
+    {
+        INIDecimal_t decimal = { .count = 0 };
+        c = read_decimal_(c, &decimal);
+        status = decimal_to_binary_(&decimal, format, &mantissa, &exponent);
+    }
+    else if (starts_with_word_(c, "inf"))
+    {
+        c += starts_with_word_(c, "infinity") ? 8 : 3;
+        *value = negative ? -(long double)INFINITY : (long double)INFINITY;
+        return *c ? INI_CONVERT_TRAILING : INI_CONVERTED;
+    }
+    else if (starts_with_word_(c, "nan"))
+    {
+        c += 3;
+        if (*c == '(')
+        {
+            const char *close = c + 1;
+            while (digit_value_(*close) < 36 || *close == '_') close++;
+            if (*close == ')') c = close + 1;
+        }
+        *value = negative ? -(long double)NAN : (long double)NAN;
+        return *c ? INI_CONVERT_TRAILING : INI_CONVERTED;
+    }
+    else
+        return INI_CONVERT_INVALID;
+
+    if (status == INI_CONVERT_OVERFLOW)
+    {
+        *value = negative ? -(long double)INFINITY : (long double)INFINITY;
+        return INI_CONVERT_OVERFLOW;
+    }
+    if (status == CONVERT_UNDERFLOW_)
+    {
+        *value = negative ? -0.0L : 0.0L;
+        return INI_CONVERT_OVERFLOW;
+    }
+
+    // Steps of 2^60 keep every intermediate result exact, as they all lie
+    // between the mantissa and the final value, which is representable
+    long double result = (long double)mantissa;
+    for (; exponent > 60; exponent -= 60) result *= 0x1p60L;
+    for (; exponent < -60; exponent += 60) result *= 0x1p-60L;
+    result *= exponent < 0 ? 1.0L / (long double)(1ull << -exponent) : (long double)(1ull << exponent);
+
+    *value = negative ? -result : result;
+    return *c ? INI_CONVERT_TRAILING : INI_CONVERTED;
+}
+
+
+
+// Reads the digits, decimal point and exponent of a decimal number at c
+// into decimal. Returns where the number ends.
+static const char *read_decimal_(const char *c, INIDecimal_t *decimal)
+{
+    // Digits from the first nonzero one on, whether they fit or not
+    int digits = 0;
+    bool point = false;
+    for (;; c++)
+    {
+        if (*c == '.' && !point)
+        {
+            point = true;
+            decimal->point = digits;
+        }
+        else if (*c >= '0' && *c <= '9')
+        {
+            // Leading zeros only move the point
+            if (*c == '0' && !digits)
+            {
+                decimal->point--;
+                continue;
+            }
+            if (decimal->count < DECIMAL_DIGITS_) decimal->digits[decimal->count++] = (unsigned char)(*c - '0');
+            else if (*c != '0') decimal->truncated = true;
+            digits++;
+        }
+        else
+            break;
+    }
+    if (!point) decimal->point = digits;
+
+    if ((*c == 'e' || *c == 'E')
+    &&  ((c[1] >= '0' && c[1] <= '9') || ((c[1] == '-' || c[1] == '+') && c[2] >= '0' && c[2] <= '9')))
+    {
+        c++;
+        const bool negative = *c == '-';
+        if (*c == '-' || *c == '+') c++;
+
+        int written = 0;
+        for (; *c >= '0' && *c <= '9'; c++)
+            if (written < 100000) written = written * 10 + (*c - '0');
+        decimal->point += negative ? -written : written;
+    }
+
+    trim_decimal_(decimal);
+    return c;
+}
+
+
+
+// Reads the digits, point and binary exponent of a hexadecimal float at c,
+// past its 0x, and rounds it to the nearest value of format, ties to even,
+// as *mantissa * 2^*exponent. Sets status like decimal_to_binary_() and
+// returns where the number ends.
+static const char *read_hex_float_(const char *c, const INIFloatFormat_t *format, INIMantissa_t *mantissa, int *exponent, int *status)
+{
+    // Up to 32 significant digits are kept, more than any format needs.
+    // The others only count as being there through sticky.
+    unsigned long long high = 0, low = 0;
+    bool sticky = false;
+    long binary = 0;
+    bool point = false;
+    for (unsigned digit;; c++)
+    {
+        if (*c == '.' && !point) point = true;
+        else if ((digit = digit_value_(*c)) < 16)
+        {
+            if (high >> 60)
+            {
+                sticky = sticky || digit;
+                if (!point) binary += 4;
+                continue;
+            }
+            high = high << 4 | low >> 60;
+            low = low << 4 | digit;
+            if (point) binary -= 4;
+        }
+        else
+            break;
+    }
+
+    if ((*c == 'p' || *c == 'P')
+    &&  ((c[1] >= '0' && c[1] <= '9') || ((c[1] == '-' || c[1] == '+') && c[2] >= '0' && c[2] <= '9')))
+    {
+        c++;
+        const bool negative = *c == '-';
+        if (*c == '-' || *c == '+') c++;
+
+        long written = 0;
+        for (; *c >= '0' && *c <= '9'; c++)
+            if (written < 100000) written = written * 10 + (*c - '0');
+        binary += negative ? -written : written;
+    }
+
+    *mantissa = 0;
+    *exponent = 0;
+    *status = INI_CONVERTED;
+    if (!high && !low) return c;
+
+    int top = high ? 127 : 63;
+    while (!((top >= 64 ? high >> (top - 64) : low >> top) & 1)) top--;
+
+    // The leading bit is worth 2^leading. Subnormals keep fewer bits.
+    const long leading = top + binary;
+    if (leading >= format->max_exponent)
+    {
+        *status = INI_CONVERT_OVERFLOW;
+        return c;
+    }
+    long precision = format->mantissa_bits + 1;
+    if (leading < format->min_exponent) precision -= format->min_exponent - leading;
+
+    // The bits below the kept ones decide the rounding
+    const long drop = top + 1 - precision;
+    INIMantissa_t kept = take_bits_(high, low, drop);
+    bool half = false;
+    if (drop > 0 && drop <= 128)
+    {
+        const long below = drop - 1;
+        half = take_bits_(high, low, below) & 1;
+        const unsigned long long rest_low = below >= 64 ? low : low & ((1ull << below) - 1);
+        const unsigned long long rest_high = below >= 64 ? high & ((1ull << (below - 64)) - 1) : 0;
+        sticky = sticky || rest_low || rest_high;
+    }
+
+    if (half && (sticky || (kept & 1)))
+    {
+        // A carry out of the kept bits moves the leading bit up
+        if (!++kept || (precision < MANTISSA_BITS_ && kept >> precision))
+        {
+            if (leading + 1 >= format->max_exponent)
+            {
+                *status = INI_CONVERT_OVERFLOW;
+                return c;
+            }
+            if (!kept)
+            {
+                kept = (INIMantissa_t)1 << (MANTISSA_BITS_ - 1);
+                binary++;
+            }
+        }
+    }
+    if (!kept)
+    {
+        *status = CONVERT_UNDERFLOW_;
+        return c;
+    }
+
+    *mantissa = kept;
+    *exponent = (int)(binary + drop);
+    return c;
+}
+
+
+
+// The bits of the 128 bit number high:low from bit on, as many as
+// INIMantissa_t holds. A negative bit shifts them up instead.
+static INIMantissa_t take_bits_(const unsigned long long high, const unsigned long long low, const long bit)
+{
+#ifdef INI_HAS_WIDE_MANTISSA
+    const INIMantissa_t bits = (INIMantissa_t)high << 64 | low;
+    if (bit < 0) return bits << -bit;
+    return bit < 128 ? bits >> bit : 0;
+#else
+    if (bit < 0) return low << -bit;
+    if (bit == 0) return low;
+    if (bit < 64) return low >> bit | high << (64 - bit);
+    return bit < 128 ? high >> (bit - 64) : 0;
+#endif
+}
+
+
+
+// Rounds decimal to the nearest value of format, ties to even, as
+// *mantissa * 2^*exponent. Returns INI_CONVERT_OVERFLOW if that's too large
+// for format, CONVERT_UNDERFLOW_ if it rounds to zero, and INI_CONVERTED
+// otherwise.
+static int decimal_to_binary_(INIDecimal_t *decimal, const INIFloatFormat_t *format, INIMantissa_t *mantissa, int *exponent)
+{
+    // Shifts by up to these many bits take the point at least this many
+    // digits further
+    static const int steps[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    const int step_count = (int)(sizeof(steps) / sizeof(steps[0]));
+
+    *mantissa = 0;
+    *exponent = 0;
+    if (!decimal->count) return INI_CONVERTED;
+
+    // The number lies in [10^(point - 1), 10^point)
+    if (decimal->point > format->max_exponent * 30103L / 100000 + 1) return INI_CONVERT_OVERFLOW;
+    if (decimal->point < (format->min_exponent - format->mantissa_bits - 1) * 30103L / 100000 - 2) return CONVERT_UNDERFLOW_;
+
+    // Bring it into [1/2, 1)
+    int binary = 0;
+    while (decimal->point > 0)
+    {
+        const int n = decimal->point >= step_count ? 27 : steps[decimal->point];
+        shift_decimal_(decimal, -n);
+        binary += n;
+    }
+    while (decimal->point < 0 || (decimal->point == 0 && decimal->digits[0] < 5))
+    {
+        const int n = -decimal->point >= step_count ? 27 : steps[-decimal->point];
+        shift_decimal_(decimal, n);
+        binary -= n;
+    }
+
+    // Then into [1, 2), or lower for subnormals
+    binary--;
+    if (binary < format->min_exponent)
+    {
+        shift_decimal_(decimal, -(format->min_exponent - binary));
+        binary = format->min_exponent;
+    }
+    if (binary >= format->max_exponent) return INI_CONVERT_OVERFLOW;
+
+    shift_decimal_(decimal, format->mantissa_bits + 1);
+    bool carried = false;
+    INIMantissa_t rounded = round_decimal_(decimal, &carried);
+
+    // Rounding up might have added a bit
+    if (carried || (format->mantissa_bits < MANTISSA_BITS_ - 1 && rounded >> (format->mantissa_bits + 1)))
+    {
+        rounded = carried ? (INIMantissa_t)1 << (MANTISSA_BITS_ - 1) : rounded >> 1;
+        if (++binary >= format->max_exponent) return INI_CONVERT_OVERFLOW;
+    }
+    if (!rounded) return CONVERT_UNDERFLOW_;
+
+    *mantissa = rounded;
+    *exponent = binary - format->mantissa_bits;
+    return INI_CONVERTED;
+}
+
+
+
+// Multiplies decimal by 2^bits, or divides it for negative bits.
+static void shift_decimal_(INIDecimal_t *decimal, int bits)
+{
+    // The digits in flight have to fit 64 bits
+    for (; bits > 60; bits -= 60) shift_decimal_left_(decimal, 60);
+    for (; bits < -60; bits += 60) shift_decimal_right_(decimal, 60);
+    if (bits > 0) shift_decimal_left_(decimal, (unsigned)bits);
+    if (bits < 0) shift_decimal_right_(decimal, (unsigned)-bits);
+}
+
+
+
+static void shift_decimal_left_(INIDecimal_t *decimal, const unsigned bits)
+{
+    // The digits are written from the back, with room for all the new ones
+    // at the front, which are then moved down
+    const int room = 19;
+    int read = decimal->count;
+    int write = decimal->count + room;
+    unsigned long long n = 0;
+    while (read > 0 || n)
+    {
+        if (read > 0) n += (unsigned long long)decimal->digits[--read] << bits;
+        decimal->digits[--write] = (unsigned char)(n % 10);
+        n /= 10;
+    }
+
+    const int added = room - write;
+    int count = decimal->count + added;
+    memmove(decimal->digits, decimal->digits + write, (size_t)count);
+    for (; count > DECIMAL_DIGITS_; count--)
+        if (decimal->digits[count - 1]) decimal->truncated = true;
+    decimal->count = count;
+    decimal->point += added;
+    trim_decimal_(decimal);
+}
+
+
+
+static void shift_decimal_right_(INIDecimal_t *decimal, const unsigned bits)
+{
+    const unsigned long long mask = (1ull << bits) - 1;
+    int read = 0;
+    int write = 0;
+
+    // Read digits until the leading one of the result is in
+    unsigned long long n = 0;
+    for (; n >> bits == 0; read++)
+    {
+        if (read >= decimal->count)
+        {
+            if (!n)
+            {
+                decimal->count = 0;
+                return;
+            }
+            while (n >> bits == 0)
+            {
+                n *= 10;
+                read++;
+            }
+            break;
+        }
+        n = n * 10 + decimal->digits[read];
+    }
+    decimal->point -= read - 1;
+
+    for (; read < decimal->count; read++)
+    {
+        decimal->digits[write++] = (unsigned char)(n >> bits);
+        n = (n & mask) * 10 + decimal->digits[read];
+    }
+    for (; n; n = (n & mask) * 10)
+    {
+        if (write < DECIMAL_DIGITS_) decimal->digits[write++] = (unsigned char)(n >> bits);
+        else if (n >> bits) decimal->truncated = true;
+    }
+    decimal->count = write;
+    trim_decimal_(decimal);
+}
+
+
+
+// Drops trailing zeros.
+static void trim_decimal_(INIDecimal_t *decimal)
+{
+    while (decimal->count > 0 && !decimal->digits[decimal->count - 1]) decimal->count--;
+    if (!decimal->count) decimal->point = 0;
+}
+
+
+
+// Rounds decimal to an integer, ties to even, setting carried if that
+// takes it past the largest INIMantissa_t.
+static INIMantissa_t round_decimal_(const INIDecimal_t *decimal, bool *carried)
+{
+    INIMantissa_t n = 0;
+    int i = 0;
+    for (; i < decimal->point && i < decimal->count; i++) n = n * 10 + decimal->digits[i];
+    for (; i < decimal->point; i++) n *= 10;
+
+    // Exactly halfway only if the 5 is the last digit and none were dropped
+    const int next = decimal->point;
+    bool up = false;
+    if (next >= 0 && next < decimal->count)
+    {
+        if (decimal->digits[next] == 5 && next + 1 == decimal->count && !decimal->truncated)
+            up = next > 0 && decimal->digits[next - 1] % 2;
+        else
+            up = decimal->digits[next] >= 5;
+    }
+
+    if (up && ++n == 0) *carried = true;
+    return n;
+}
+
+
+
+// Rounds mantissa * 10^exponent to the nearest double the way Eisel and
+// Lemire do, from the 128 leading bits of the power of five. Returns false
+// if those leave the result in doubt, or if it's zero or infinite, for
+// parse_float_() to settle. mantissa has to be exact.
+static bool eisel_lemire_(unsigned long long mantissa, const long exponent, double *value)
+{
+    // The result is put together the way binary64 lays it out
+    if (DBL_MANT_DIG != 53 || DBL_MAX_EXP != 1024) return false;
+    if (!mantissa || exponent < -342 || exponent > 308) return false;
+
+    const unsigned long long *power = power_of_five_((int)exponent);
+    const int zeros = leading_zeros_(mantissa);
+    mantissa <<= zeros;
+
+    // The high half of the power is enough unless the product's bits below
+    // the 55 that are kept are all ones, and a carry could still come in
+    unsigned long long low;
+    unsigned long long high = multiply_(mantissa, power[0], &low);
+    if ((high & 0x1ff) == 0x1ff)
+    {
+        unsigned long long lower;
+        const unsigned long long carry = multiply_(mantissa, power[1], &lower);
+        low += carry;
+        if (low < carry) high++;
+    }
+    if (low == ULLONG_MAX && (exponent < -27 || exponent > 55)) return false;
+
+    // Binary exponent of the product, floor(exponent * log2(10)) + 63,
+    // shifted while positive as shifting negative numbers isn't portable
+    const int upper = (int)(high >> 63);
+    const int shift = upper + 9;
+    unsigned long long bits = high >> shift;
+    int biased = (int)((217706LL * (exponent + 65536)) >> 16) - 217706 + 63 + upper - zeros + 1023;
+
+    if (biased <= 0)
+    {
+        // Subnormals can't fall exactly halfway with 19 digits
+        if (1 - biased >= 64) return false;
+        bits >>= 1 - biased;
+        bits = (bits + (bits & 1)) >> 1;
+        if (!bits) return false;
+        biased = bits < 1ull << 52 ? 0 : 1;
+    }
+    else
+    {
+        // Only small powers give exact products, which may be exactly
+        // halfway and then round to even
+        if (low <= 1 && exponent >= -4 && exponent <= 23 && (bits & 3) == 1 && bits << shift == high)
+            bits &= ~1ull;
+        bits = (bits + (bits & 1)) >> 1;
+        if (bits >= 2ull << 52)
+        {
+            bits = 1ull << 52;
+            biased++;
+        }
+        bits &= ~(1ull << 52);
+        if (biased >= 0x7ff) return false;
+    }
+
+    const uint64_t word = (uint64_t)biased << 52 | bits;
+    memcpy(value, &word, sizeof(*value));
+    return true;
+}
+
+
+
+// Returns the high half of the 128 bit product of a and b, and its low
+// half through low.
+static unsigned long long multiply_(const unsigned long long a, const unsigned long long b, unsigned long long *low)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ const unsigned __int128 product = (unsigned __int128)a * b;
+    *low = (unsigned long long)product;
+    return (unsigned long long)(product >> 64);
+#else
+    const unsigned long long a_low = a & 0xffffffff, a_high = a >> 32;
+    const unsigned long long b_low = b & 0xffffffff, b_high = b >> 32;
+    const unsigned long long low_low = a_low * b_low;
+    const unsigned long long low_high = a_low * b_high;
+    const unsigned long long high_low = a_high * b_low;
+    const unsigned long long middle = (low_low >> 32) + (low_high & 0xffffffff) + (high_low & 0xffffffff);
+    *low = middle << 32 | (low_low & 0xffffffff);
+    return a_high * b_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+
+
+// The number of leading zero bits of a nonzero n.
+static int leading_zeros_(const unsigned long long n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(n);
+#else
+    int zeros = 0;
+    for (unsigned long long bit = 1ull << 63; !(n & bit); bit >>= 1) zeros++;
+    return zeros;
+#endif
+}
+
+
+
+// Whether c starts with word, ignoring case.
+static bool starts_with_word_(const char *c, const char *word)
+{
+    for (; *word; c++, word++)
+        if (*c != *word && *c != *word - 'a' + 'A')
+            return false;
+    return true;
+}
+
+
+
+// Returns the value of a digit in bases up to 36, or 36 or more if c isn't
+// one.
+static unsigned digit_value_(const char c)
+{
+    if (c >= '0' && c <= '9') return (unsigned)(c - '0');
+    if (c >= 'a' && c <= 'z') return (unsigned)(c - 'a') + 10;
+    if (c >= 'A' && c <= 'Z') return (unsigned)(c - 'A') + 10;
+    return 36;
+}
+
+
+
+// isspace() in the C locale.
+static bool is_space_(const char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+
+// Finds a pair along with the section it's in.
+static INIPair_t *lookup_pair_(const INIData_t *data, const char *section, const char *key, INISection_t **found_section)
+{
+    if (!data || !section || !key || !data->sections) return NULL;
+
+    *found_section = find_section_(data, (INIView_t){ section, strlen(section) });
+    if (!*found_section) return NULL;
+
+    return find_pair_(*found_section, (INIView_t){ key, strlen(key) });
+}
+
+
+
+// Converts the value of a pair as one of the INI_CACHED_* kinds. The first
+// conversion of a value is kept, and taken by later ones of the same kind.
+// Only the reader that claims an empty slot writes it, and it's published
+// with a release store, so concurrent readers are safe.
+static int get_converted_(const INIData_t *data, const char *section, const char *key, const unsigned char kind, INICachedValue_t *converted)
+{
+    INISection_t *found_section;
+    const INIPair_t *pair = lookup_pair_(data, section, key, &found_section);
+    return pair ? convert_pair_(found_section, pair, kind, converted) : INI_CONVERT_MISSING;
+}
+
+
+
+// Finds the pair a descriptor from ini_key() names, using the hashes and
+// lengths it holds.
+static INIPair_t *lookup_keyed_(const INIData_t *data, const INIKey_t *key, INISection_t **found_section)
+{
+    if (!data || !key || !key->section || !key->key || !data->sections) return NULL;
+
+    *found_section = find_hashed_section_(data, (INIView_t){ key->section, key->section_length }, key->section_hash);
+    if (!*found_section) return NULL;
+
+    return find_hashed_pair_(*found_section, (INIView_t){ key->key, key->key_length }, key->key_hash);
+}
+
+
+
+// get_converted_() for a descriptor from ini_key().
+static int get_keyed_(const INIData_t *data, const INIKey_t *key, const unsigned char kind, INICachedValue_t *converted)
+{
+    INISection_t *found_section;
+    const INIPair_t *pair = lookup_keyed_(data, key, &found_section);
+    return pair ? convert_pair_(found_section, pair, kind, converted) : INI_CONVERT_MISSING;
+}
+
+
+
+// The pair a handle points at, resolving it again first if it was
+// resolved against another database or before this one last changed.
+static const INIPair_t *handle_pair_(const INIData_t *data, INIHandle_t *handle)
+{
+    if (!data || !handle) return NULL;
+
+    if (handle->data != data || handle->generation != data->generation)
+    {
+        handle->pair = lookup_keyed_(data, &handle->key, &handle->section);
+
+        // Taken after the lookup, which loads lazily read sections
+        handle->data = data;
+        handle->generation = data->generation;
+    }
+    return handle->pair;
+}
+
+
+
+// get_converted_() for a handle from ini_resolve().
+static int get_handled_(const INIData_t *data, INIHandle_t *handle, const unsigned char kind, INICachedValue_t *converted)
+{
+    const INIPair_t *pair = handle_pair_(data, handle);
+    return pair ? convert_pair_(handle->section, pair, kind, converted) : INI_CONVERT_MISSING;
+}
+
+
+
+// Converts the value of a pair of section, through its cache if it has one.
+static int convert_pair_(INISection_t *section, const INIPair_t *pair, const unsigned char kind, INICachedValue_t *converted)
+{
+#ifdef INI_HAS_VALUE_CACHE
+    INICachedValue_t *cache = section->cache ? &section->cache[pair - section->pairs] : NULL;
+    if (cache)
+    {
+        const unsigned char cached = __atomic_load_n(&cache->kind, __ATOMIC_ACQUIRE);
+        if (cached == kind)
+        {
+            converted->value = cache->value;
+            return cache->status;
+        }
+        if (cached != INI_CACHED_NONE && cached != INI_CACHED_BUSY && derive_cached_(cache, kind, converted))
+            return cache->status;
+
+        unsigned char empty = INI_CACHED_NONE;
+        if (cached == INI_CACHED_NONE
+        &&  __atomic_compare_exchange_n(&cache->kind, &empty, INI_CACHED_BUSY, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            // Unsigned integers are kept signed where that holds them, so
+            // the signed getters find them too
+            unsigned char stored = kind == INI_CACHED_UNSIGNED ? INI_CACHED_SIGNED : kind;
+            int status = convert_stored_(section->data, pair, stored, converted);
+            if (stored != kind && status == INI_CONVERT_OVERFLOW)
+                status = convert_stored_(section->data, pair, stored = kind, converted);
+
+            cache->value = converted->value;
+            cache->status = (unsigned char)status;
+            __atomic_store_n(&cache->kind, stored, __ATOMIC_RELEASE);
+            if (stored != kind) derive_cached_(cache, kind, converted);
+            return status;
+        }
+    }
+#endif
+
+    return convert_stored_(section->data, pair, kind, converted);
+}
+
+
+
+#ifdef INI_HAS_VALUE_CACHE
+// Converts to kind from the kind cached where that gives exactly what
+// converting the value would. Signed integers give unsigned ones unless
+// they were clamped, long doubles give the doubles they hold exactly, and
+// what isn't a number of one kind isn't one of its sibling either.
+static bool derive_cached_(const INICachedValue_t *cache, const unsigned char kind, INICachedValue_t *converted)
+{
+    const unsigned char cached = cache->kind;
+    const bool integers = (cached == INI_CACHED_SIGNED && kind == INI_CACHED_UNSIGNED)
+                       || (cached == INI_CACHED_UNSIGNED && kind == INI_CACHED_SIGNED);
+    const bool floats = (cached == INI_CACHED_FLOAT && kind == INI_CACHED_DOUBLE)
+                     || (cached == INI_CACHED_DOUBLE && kind == INI_CACHED_FLOAT);
+    if (!integers && !floats) return false;
+    if (cache->status == INI_CONVERT_INVALID) return true;
+    if (cache->status == INI_CONVERT_OVERFLOW) return false;
+
+    if (cached == INI_CACHED_SIGNED)
+    {
+        converted->value.u = (unsigned long long)cache->value.s;
+        return true;
+    }
+    if (cached == INI_CACHED_FLOAT && (double)cache->value.f == cache->value.f)
+    {
+        converted->value.d = (double)cache->value.f;
+        return true;
+    }
+    return false;
+}
+#endif
+
+
+
+// convert_value_() for the value of a pair of data, or a missing one if
+// pair is NULL. Values borrowed with INI_BORROW_STRINGS aren't
+// null-terminated, so they're converted from a terminated copy.
+static int convert_stored_(const INIData_t *data, const INIPair_t *pair, const unsigned char kind, INICachedValue_t *converted)
 {
-    if (!section) return NULL;
+    if (!pair) return INI_CONVERT_MISSING;
 
-    if (section->pair_count >= section->pair_allocation)
+#ifdef INI_COMPACT_STRINGS
+    if (data && data->borrowed)
     {
-        if (!ini_realloc_) return NULL;
-        section->pair_allocation *= 2;
-        INIPair_t *re = ini_realloc_(section->pairs, sizeof(INIPair_t) * section->pair_allocation);
-        if (!re) return NULL;
-        section->pairs = re;
+        char local[INI_MAX_STRING_SIZE];
+        const INIView_t value = value_view_(pair);
+        char *copy = value.length < sizeof(local) ? local : allocate_(&data->allocator, value.length + 1);
+        if (!copy) return INI_CONVERT_INVALID;
+
+        memcpy(copy, value.data, value.length);
+        copy[value.length] = '\0';
+        const int status = convert_value_(copy, kind, converted);
+        if (copy != local) deallocate_(&data->allocator, copy);
+        return status;
     }
+#else
+    (void)data;
+#endif
 
-    INIPair_t *new_pair = &section->pairs[section->pair_count++];
-    *new_pair = pair;
-    return new_pair;
+    return convert_value_(pair->value, kind, converted);
 }
 
 
 
-INISection_t *ini_has_section(const INIData_t *data, const char *section)
+// Whether any entry of the schema is in section.
+static bool binds_section_(const INIBinding_t *schema, const unsigned count, const unsigned *slots, const size_t capacity, const INIView_t section, const uint64_t seed)
 {
-    if (!data || !section || !data->sections) return NULL;
+    if (slots)
+    {
+        const unsigned *sections = slots + capacity;
+        for (size_t slot = seed & (capacity - 1); sections[slot]; slot = (slot + 1) & (capacity - 1))
+        {
+            const char *name = schema[sections[slot] - 1].section;
+            if (strncmp(name, section.data, section.length) == 0 && !name[section.length]) return true;
+        }
+        return false;
+    }
 
-    for (unsigned i = 0; i < data->section_count; i++)
-        if (strncmp(section, data->sections[i].name, INI_MAX_STRING_SIZE) == 0)
-            return &data->sections[i];
-    return NULL;
+    for (unsigned i = 0; i < count; i++)
+        if (strncmp(schema[i].section, section.data, section.length) == 0 && !schema[i].section[section.length])
+            return true;
+    return false;
 }
 
 
 
-const char *ini_get_value(const INIData_t *data, const char *section, const char *key)
+// Finds the entry of the schema for a key of section.
+static const INIBinding_t *find_binding_(const INIBinding_t *schema, const unsigned count, const unsigned *slots, const size_t capacity, const INIView_t section, const INIView_t key, const uint64_t seed)
 {
-    if (!data || !section || !key || !data->sections) return NULL;
-
-    INISection_t *found_section = NULL;
-    for (unsigned i = 0; i < data->section_count; i++)
+    if (slots)
     {
-        if (strncmp(data->sections[i].name, section, INI_MAX_STRING_SIZE) == 0)
+        for (size_t slot = mix_(hash_bytes_(key.data, key.length, seed)) & (capacity - 1); slots[slot]; slot = (slot + 1) & (capacity - 1))
         {
-            found_section = &data->sections[i];
-            break;
+            const INIBinding_t *binding = &schema[slots[slot] - 1];
+            if (strncmp(binding->key, key.data, key.length) == 0 && !binding->key[key.length]
+            &&  strncmp(binding->section, section.data, section.length) == 0 && !binding->section[section.length])
+                return binding;
         }
+        return NULL;
     }
 
-    if (!found_section) return NULL;
-
-    for (unsigned i = 0; i < found_section->pair_count; i++)
-    {
-        if (strncmp(found_section->pairs[i].key, key, INI_MAX_STRING_SIZE) == 0)
-            return found_section->pairs[i].value;
-    }
-
+    for (unsigned i = 0; i < count; i++)
+        if (strncmp(schema[i].key, key.data, key.length) == 0 && !schema[i].key[key.length]
+        &&  strncmp(schema[i].section, section.data, section.length) == 0 && !schema[i].section[section.length])
+            return &schema[i];
     return NULL;
 }
 
 
 
-const char *ini_get_string(const INIData_t *data, const char *section, const char *key, const char *default_value)
+// Writes the value of pair, or the default if it's NULL or can't be
+// converted, into the member of target the entry points at.
+static int store_binding_(const INIBinding_t *binding, const INIData_t *data, const INIPair_t *pair, void *target)
 {
-    const char *str = ini_get_value(data, section, key);
-    if (!str) return default_value;
-    return str;
-}
+    const char *value = pair ? pair->value : NULL;
+    char *member = (char *)target + binding->offset;
+    const INIBindDefault_t *fallback = &binding->default_value;
+    INICachedValue_t converted;
+    int status;
+
+    switch (binding->type)
+    {
+        case INI_BIND_STRING:
+            if (value && data && data->borrowed)
+            {
+                *(const char **)member = fallback->str;
+                return UNTERMINATED_;
+            }
+            *(const char **)member = value ? value : fallback->str;
+            return value ? INI_CONVERTED : INI_CONVERT_MISSING;
 
+        case INI_BIND_VIEW:
+            if (pair) *(INIView_t *)member = value_view_(pair);
+            else *(INIView_t *)member = (INIView_t){ fallback->str, fallback->str ? strlen(fallback->str) : 0 };
+            return pair ? INI_CONVERTED : INI_CONVERT_MISSING;
 
+        case INI_BIND_INT:
+        {
+            status = convert_stored_(data, pair, INI_CACHED_SIGNED, &converted);
+            long long number = status < INI_CONVERT_INVALID ? converted.value.s : fallback->s;
+            if (number > INT_MAX || number < INT_MIN)
+            {
+                number = number > INT_MAX ? INT_MAX : INT_MIN;
+                status = INI_CONVERT_OVERFLOW;
+            }
+            *(int *)member = (int)number;
+            return status;
+        }
 
-unsigned long long ini_get_unsigned(const INIData_t *data, const char *section, const char *key, const unsigned long long default_value)
-{
-    const char *str = ini_get_value(data, section, key);
-    if (!str) return default_value;
+        case INI_BIND_UNSIGNED:
+        {
+            status = convert_stored_(data, pair, INI_CACHED_UNSIGNED, &converted);
+            unsigned long long number = status < INI_CONVERT_INVALID ? converted.value.u : fallback->u;
+            if (number > UINT_MAX)
+            {
+                number = UINT_MAX;
+                status = INI_CONVERT_OVERFLOW;
+            }
+            *(unsigned *)member = (unsigned)number;
+            return status;
+        }
 
-    char *end = NULL;
-    const unsigned long long value = strtoull(str, &end, 10);
-    if (end == str) return default_value;
-    return value;
+        case INI_BIND_INT64:
+            status = convert_stored_(data, pair, INI_CACHED_SIGNED, &converted);
+            *(int64_t *)member = status < INI_CONVERT_INVALID ? converted.value.s : fallback->s;
+            return status;
+
+        case INI_BIND_UINT64:
+        case INI_BIND_HEX:
+            status = convert_stored_(data, pair, binding->type == INI_BIND_HEX ? INI_CACHED_HEX : INI_CACHED_UNSIGNED, &converted);
+            *(uint64_t *)member = status < INI_CONVERT_INVALID ? converted.value.u : fallback->u;
+            return status;
+
+        case INI_BIND_DOUBLE:
+            status = convert_stored_(data, pair, INI_CACHED_DOUBLE, &converted);
+            *(double *)member = status < INI_CONVERT_INVALID ? converted.value.d : fallback->d;
+            return status;
+
+        case INI_BIND_BOOL:
+            status = convert_stored_(data, pair, INI_CACHED_BOOL, &converted);
+            *(bool *)member = status < INI_CONVERT_INVALID ? converted.value.b : fallback->b;
+            return status;
+
+        default:
+            return INI_CONVERT_INVALID;
+    }
 }
 
 
 
-long long ini_get_signed(const INIData_t *data, const char *section, const char *key, const long long default_value)
+// Describes the first problem ini_bind() runs into, with the line naming
+// the section and key.
+static void report_binding_(INIError_t *error, const INIView_t section, const INIView_t key, const int status)
 {
-    const char *str = ini_get_value(data, section, key);
-    if (!str) return default_value;
+    if (!error || error->encountered) return;
+
+    const char *msg;
+    switch (status)
+    {
+        case INI_CONVERT_TRAILING: msg = "Characters follow the value"; break;
+        case INI_CONVERT_OVERFLOW: msg = "Value is out of range";       break;
+        case INI_CONVERT_INVALID:  msg = "Value has the wrong type";    break;
+        case INI_CONVERT_MISSING:  msg = "Key is missing";              break;
+        case UNKNOWN_KEY_:         msg = "Key is unknown";              break;
+        case UNTERMINATED_:        msg = "Value isn't null-terminated"; break;
+        default:                   msg = "Value can't be bound";        break;
+    }
 
-    char *end = NULL;
-    const long long value = strtoll(str, &end, 10);
-    if (end == str) return default_value;
-    return value;
+    char line[INI_MAX_LINE_SIZE];
+    const int length = snprintf(line, sizeof(line), "[%.*s] %.*s", (int)section.length, section.data, (int)key.length, key.data);
+    set_parse_error_(error, line, length < 0 ? 0 : (size_t)length, (ptrdiff_t)section.length + 3, msg);
 }
 
 
 
-unsigned long long ini_get_hex(const INIData_t *data, const char *section, const char *key, const unsigned long long default_value)
+// Drops the converted value of a pair whose value changed.
+static void forget_value_(INISection_t *section, const unsigned pair)
 {
-    const char *str = ini_get_value(data, section, key);
-    if (!str) return default_value;
-
-    char *end = NULL;
-    const unsigned long long value = strtoull(str, &end, 16);
-    if (end == str) return default_value;
-    return value;
+    if (section->cache)
+        section->cache[pair].kind = INI_CACHED_NONE;
 }
 
 
 
-long double ini_get_float(const INIData_t *data, const char *section, const char *key, const long double default_value)
+// Assumes dest has room for the view and a null-terminator.
+static void copy_view_(char *dest, const INIView_t view)
 {
-    const char *str = ini_get_value(data, section, key);
-    if (!str) return default_value;
-
-    char *end = NULL;
-    const long double value = strtold(str, &end);
-    if (end == str) return default_value;
-    return value;
+    memcpy(dest, view.data, view.length);
+    dest[view.length] = '\0';
 }
 
 
 
-bool ini_get_bool(const INIData_t *data, const char *section, const char *key, const bool default_value)
+static void set_parse_error_(INIError_t *error, const char *line, size_t length, const ptrdiff_t offset, const char *msg)
 {
-    const char *str = ini_get_value(data, section, key);
-    if (!str) return default_value;
-    if (strcmp(str, "true") == 0) return true;
-    if (strcmp(str, "false") == 0) return false;
-    return default_value;
-}
+    if (!error || offset < 0) return;
 
+    error->encountered = true;
+    error->offset = offset;
 
+    memcpy(error->msg, msg, strnlen(msg, INI_MAX_LINE_SIZE - 1) + 1);
 
-// Assumes line is null-terminated.
-bool ini_is_blank_line(const char *line)
-{
-    if (!line) return false;
-    const char *c = skip_ignored_characters_(line);
-    return *c == '\0';
+    if (length > INI_MAX_LINE_SIZE - 1) length = INI_MAX_LINE_SIZE - 1;
+    memcpy(error->line, line, length);
+    error->line[length] = '\0';
 }
 
 
 
-bool ini_parse_section(const char *line, INISection_t *section, ptrdiff_t *discrepancy)
+static void clear_parse_error_(INIError_t *error)
 {
-    if (!line) return false;
+    if (!error) return;
+    error->encountered = false;
+    memset(error->line, 0, sizeof(error->line));
+    memset(error->msg, 0, sizeof(error->msg));
+    error->offset = 0;
+}
 
-    const char *c = line;
-    if (discrepancy) *discrepancy = 0;
 
-    char *dest_c = NULL;
-    if (section)
-    {
-        memset(section->name, 0, sizeof(section->name));
-        dest_c = section->name;
-    }
 
-    c = skip_ignored_characters_(c);
-    if (*c != '[') goto is_not_section;
-    c++;
-    c = skip_ignored_characters_(c);
+static bool contains_consecutive_spaces_(const INIView_t str)
+{
+    for (size_t i = 1; i < str.length; i++)
+        if (str.data[i] == ' ' && str.data[i - 1] == ' ')
+            return true;
+    return false;
+}
 
-    if (!is_valid_section_starting_character_(*c)) goto is_not_section;
 
-    const char *last_space = NULL;
-    while (is_valid_section_character_(*c))
-    {
-        if (*c == ' ')
-        {
-            if (last_space && c - last_space == 1)
-                break;
-            last_space = c;
-        }
 
-        if (dest_c)
-        {
-            if (dest_c - section->name >= INI_MAX_STRING_SIZE - 1)
-                return false;
-            *dest_c++ = *c;
-        }
+static char peek_(const char *c, const char *end)
+{
+    return c < end ? *c : '\0';
+}
 
-        c++;
-    }
 
-    if (dest_c)
-    {
-        if (last_space && c - last_space == 1)
-            dest_c--;
-        *dest_c = '\0';
-    }
 
-    c = skip_ignored_characters_(c);
-    if (*c != ']') goto is_not_section;
-    c++;
+static const char *skip_ignored_characters_(const char *c, const char *end)
+{
+    if (!c) return NULL;
 
-    c = skip_ignored_characters_(c);
-    if (*c != '\0') goto is_not_section;
+    while (c < end && has_class_(*c, CHAR_SPACE_))
+        c++;
 
-    return true;
+    if (c < end && (*c == ';' || *c == '#'))
+        return end;
 
-    is_not_section:
-    if (discrepancy) *discrepancy = c - line;
-    if (section)
-        section->name[0] = '\0';
-    return false;
+    return c;
 }
 
 
 
-bool ini_parse_pair(const char *line, INIPair_t *pair, ptrdiff_t *discrepancy)
+static void init_lines_(INILines_t *lines, const char *buffer, const char *end)
 {
-    if (!line) return false;
-
-    if (discrepancy) *discrepancy = 0;
-
-    if (pair)
-        memset(pair->key, 0, sizeof(pair->key));
+    lines->block = buffer;
+    lines->end = end;
+#ifdef INI_HAS_SSE2
+    lines->newlines = find_newlines_(buffer, end);
+#else
+    lines->newlines = 0;
+#endif
+}
 
-    char key[INI_MAX_STRING_SIZE];
-    if (!ini_parse_key(line, key, INI_MAX_STRING_SIZE, discrepancy)) goto is_not_pair;
 
-    char value[INI_MAX_STRING_SIZE];
-    if (!ini_parse_value(line, value, INI_MAX_STRING_SIZE, discrepancy)) goto is_not_pair;
 
-    if (pair)
+// Returns the start of the line after the one at c, or the end of the
+// buffer. c has to be where the line handed out last ended.
+static const char *next_line_(INILines_t *lines, const char *c)
+{
+#ifdef INI_HAS_SSE2
+    (void)c;
+    while (!lines->newlines)
     {
-        memcpy(pair->key, key, INI_MAX_STRING_SIZE);
-        memcpy(pair->value, value, INI_MAX_STRING_SIZE);
+        if (lines->end - lines->block <= 64) return lines->end;
+        lines->block += 64;
+        lines->newlines = find_newlines_(lines->block, lines->end);
     }
 
-    return true;
-
-    is_not_pair:
-    if (pair)
-    {
-        pair->key[0] = '\0';
-        pair->value[0] = '\0';
-    }
-    return false;
+    const char *newline = lines->block + __builtin_ctzll(lines->newlines);
+    lines->newlines &= lines->newlines - 1;
+    return newline + 1;
+#else
+    const char *newline = memchr(c, '\n', (size_t)(lines->end - c));
+    return newline ? newline + 1 : lines->end;
+#endif
 }
 
 
 
-bool ini_parse_key(const char *line, char *dest, const unsigned n, ptrdiff_t *discrepancy)
+#ifdef INI_HAS_SSE2
+// Bits of the newlines in the 64 bytes from c, or those left before end
+static uint64_t find_newlines_(const char *c, const char *end)
 {
-    if (!line) return false;
-
-    if (discrepancy) *discrepancy = 0;
-
-    const char *c = line;
-    c = skip_ignored_characters_(c);
-    const char *beginning = c;
-    if (!is_valid_key_starting_value_(*beginning)) goto is_not_key;
-
-    while (is_valid_key_character_(*c))
+    uint64_t newlines = 0;
+    if (end - c >= 64)
     {
-        if (dest)
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (int i = 0; i < 4; i++)
         {
-            if (c - beginning >= n - 1) goto is_not_key;
-            *dest++ = *c;
+            const __m128i v = _mm_loadu_si128((const __m128i *)(c + 16 * i));
+            newlines |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)) << (16 * i);
         }
-        c++;
+        return newlines;
     }
-    if (dest) *dest = '\0';
-
-    c = skip_ignored_characters_(c);
-    if (*c == '=' || *c == ':') return true;
 
-    is_not_key:
-    if (discrepancy) *discrepancy = c - line;
-    return false;
+    for (int i = 0; c + i < end; i++)
+        if (c[i] == '\n') newlines |= 1ull << i;
+    return newlines;
 }
+#endif
 
 
 
-bool ini_parse_value(const char *line, char *dest, const unsigned n, ptrdiff_t *discrepancy)
+// Value and key runs make up most of the bytes in a typical file, so
+// they're scanned 16 or 32 bytes at a time where the CPU allows. The scalar
+// loops are the reference, and finish whatever the vector ones leave.
+// Spaces only end unquoted values when doubled, so one space never stops
+// a scan. scan_value_ returns the first character that isn't part of the
+// value or the second of two spaces, scan_key_ the first non-key one. The
+// character before a value has to be readable.
+static const char *scan_value_(const char *c, const char *end, const bool quoted)
 {
-    if (!line) return false;
+#ifdef INI_HAS_SSE2
+    if (end - c >= 32) return scan_value_wide_(c, end, quoted);
+    if (end - c >= 16) return scan_value_sse2_(c, end, quoted);
+#endif
+    return scan_value_scalar_(c, end, quoted);
+}
 
-    if (discrepancy) *discrepancy = 0;
 
-    const char *c = line;
 
-    while (*c != '=' && *c != ':' && *c != '\0') c++;
-    if (*c == '\0') goto is_not_value;
-    c++;
+static const char *scan_key_(const char *c, const char *end)
+{
+#ifdef INI_HAS_SSE2
+    if (end - c >= 32) return scan_key_wide_(c, end);
+    if (end - c >= 16) return scan_key_sse2_(c, end);
+#endif
+    return scan_key_scalar_(c, end);
+}
 
-    c = skip_ignored_characters_(c);
-    const char *beginning = c;
 
-    const bool quoted = (*c == '"');
-    if (quoted) c++;
 
-    const char *last_space = NULL;
-    while (is_valid_value_character_(*c))
+static const char *scan_value_scalar_(const char *c, const char *end, const bool quoted)
+{
+    for (; c < end; c++)
     {
         if (*c == ' ')
         {
-            if (last_space && c - last_space == 1)
-                if (!quoted) break;
-            last_space = c;
+            if (!quoted && c[-1] == ' ') return c;
         }
+        else if (!is_plain_value_character_(*c))
+            return c;
+    }
+    return c;
+}
 
-        if (dest)
-        {
-            if (c - beginning >= n - 1)
-                goto is_not_value;
-            *dest++ = *c;
-        }
 
-        c++;
-    }
 
-    if (quoted)
-    {
-        if (*c != '"') goto is_not_value;
+static const char *scan_key_scalar_(const char *c, const char *end)
+{
+    while (c < end && is_valid_key_character_(*c))
         c++;
-    }
-
-    else
-        if (*c == '"') goto is_not_value;
+    return c;
+}
 
-    if (dest)
-    {
-        if (last_space && c - last_space == 1)
-            dest--;
-        *dest = '\0';
-    }
 
-    c = skip_ignored_characters_(c);
-    if (*c == '\0') return true;
 
-    is_not_value:
-    if (discrepancy) *discrepancy = c - line;
-    return false;
+#ifdef INI_HAS_SSE2
+// Both check a run of bytes on ASCII ranges only, signed bytes from 0x80 up
+// are negative and always fall outside them
+static __m128i in_range_sse2_(const __m128i v, const char low, const char high)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char)(low - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8((char)(high + 1))));
 }
 
 
 
-void ini_free_data(INIData_t *data)
+static const char *scan_value_sse2_(const char *c, const char *end, const bool quoted)
 {
-    if (!ini_free_) return;
-    if (data)
+    // A space ending the block before pairs with one starting the next
+    unsigned carry = c[-1] == ' ';
+    for (; end - c >= 16; c += 16)
     {
-        if (data->sections)
-        {
-            for (unsigned i = 0; i < data->section_allocation; i++)
-                if (data->sections[i].pairs)
-                    ini_free_(data->sections[i].pairs);
-            ini_free_(data->sections);
-        }
-        ini_free_(data);
+        const __m128i v = _mm_loadu_si128((const __m128i *)c);
+
+        // Unsigned v < ' ' catches control characters, anything >= 0x80
+        // is left alone like the scalar check does
+        const __m128i space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+        __m128i stop = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(' ' - 1)), v);
+        stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f)));
+        stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8('[')));
+        stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8(']')));
+        stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8(';')));
+        stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8('#')));
+        stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+
+        const unsigned spaces = (unsigned)_mm_movemask_epi8(space);
+        unsigned mask = (unsigned)_mm_movemask_epi8(stop);
+        if (!quoted) mask |= spaces & (spaces << 1 | carry);
+        if (mask) return c + __builtin_ctz(mask);
+        carry = spaces >> 15;
     }
+    return scan_value_scalar_(c, end, quoted);
 }
 
 
 
-INIData_t *ini_create_data()
+static const char *scan_key_sse2_(const char *c, const char *end)
 {
-    if (!ini_malloc_) return NULL;
-
-    INIData_t *data = ini_malloc_(sizeof(INIData_t));
-    if (!data) return NULL;
-
-    data->section_count = 0;
-    data->section_allocation = INI_INITIAL_ALLOCATED_SECTIONS;
-    data->sections = ini_malloc_(sizeof(INISection_t) * data->section_allocation);
-    if (!data->sections)
+    for (; end - c >= 16; c += 16)
     {
-        free(data);
-        return NULL;
-    }
+        const __m128i v = _mm_loadu_si128((const __m128i *)c);
 
-    for (unsigned i = 0; i < data->section_allocation; i++)
-    {
-        INISection_t *section = &data->sections[i];
-        section->name[0] = '\0';
-        section->pair_allocation = INI_INITIAL_ALLOCATED_PAIRS;
-        section->pairs = ini_malloc_(sizeof(INIPair_t) * section->pair_allocation);
-        section->pair_count = 0;
-    }
+        __m128i key = in_range_sse2_(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+        key = _mm_or_si128(key, in_range_sse2_(v, '0', '9'));
+        key = _mm_or_si128(key, _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
 
-    return data;
+        const unsigned mask = ~(unsigned)_mm_movemask_epi8(key) & 0xffff;
+        if (mask) return c + __builtin_ctz(mask);
+    }
+    return scan_key_scalar_(c, end);
 }
+#endif
 
 
 
-void ini_init_data(INIData_t* data, INISection_t* sections, INIPair_t** pairs, const unsigned num_sections, const unsigned num_pairs)
+#ifdef INI_HAS_AVX2
+__attribute__((target("avx2")))
+static __m256i in_range_avx2_(const __m256i v, const char low, const char high)
 {
-    if (!data || !sections || !pairs) return;
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8((char)(low - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(high + 1)), v));
+}
 
-    data->sections = sections;
-    data->section_count = 0;
-    data->section_allocation = num_sections;
 
-    for (unsigned i = 0; i < num_sections; i++)
+
+__attribute__((target("avx2")))
+static const char *scan_value_avx2_(const char *c, const char *end, const bool quoted)
+{
+    unsigned carry = c[-1] == ' ';
+    for (; end - c >= 32; c += 32)
     {
-        sections[i].pairs = pairs[i];
-        sections[i].pair_count = 0;
-        sections[i].pair_allocation = num_pairs;
+        const __m256i v = _mm256_loadu_si256((const __m256i *)c);
+
+        const __m256i space = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+        __m256i stop = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(' ' - 1)), v);
+        stop = _mm256_or_si256(stop, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7f)));
+        stop = _mm256_or_si256(stop, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('[')));
+        stop = _mm256_or_si256(stop, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']')));
+        stop = _mm256_or_si256(stop, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(';')));
+        stop = _mm256_or_si256(stop, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('#')));
+        stop = _mm256_or_si256(stop, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+
+        const unsigned spaces = (unsigned)_mm256_movemask_epi8(space);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(stop);
+        if (!quoted) mask |= spaces & (spaces << 1 | carry);
+        if (mask) return c + __builtin_ctz(mask);
+        carry = spaces >> 31;
     }
+
+    // Legacy SSE code is slow while the upper halves are dirty
+    _mm256_zeroupper();
+    return scan_value_sse2_(c, end, quoted);
 }
 
 
 
-static void set_parse_error_(INIError_t *error, const char *line, const ptrdiff_t offset, const char *msg)
+__attribute__((target("avx2")))
+static const char *scan_key_avx2_(const char *c, const char *end)
 {
-    if (!error || offset < 0) return;
+    for (; end - c >= 32; c += 32)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)c);
 
-    error->encountered = true;
-    error->offset = offset;
+        __m256i key = in_range_avx2_(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z');
+        key = _mm256_or_si256(key, in_range_avx2_(v, '0', '9'));
+        key = _mm256_or_si256(key, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
 
-    memcpy(error->msg, msg, strnlen(msg, INI_MAX_LINE_SIZE - 1) + 1);
-    memcpy(error->line, line, strnlen(line, INI_MAX_LINE_SIZE - 1) + 1);
+        const unsigned mask = ~(unsigned)_mm256_movemask_epi8(key);
+        if (mask) return c + __builtin_ctz(mask);
+    }
+    _mm256_zeroupper();
+    return scan_key_sse2_(c, end);
 }
 
 
 
-static void clear_parse_error_(INIError_t *error)
+// Picks the widest scanners once, before anything can be parsed.
+// __builtin_cpu_supports() needs the CPU model set up by then.
+__attribute__((constructor))
+static void resolve_scanners_(void)
 {
-    if (!error) return;
-    error->encountered = false;
-    memset(error->line, 0, sizeof(error->line));
-    memset(error->msg, 0, sizeof(error->msg));
-    error->offset = 0;
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx2")) return;
+    scan_value_wide_ = scan_value_avx2_;
+    scan_key_wide_ = scan_key_avx2_;
 }
+#endif
 
 
 
-static bool contains_consecutive_spaces_(const char *str)
+static bool is_valid_section_starting_character_(const char c)
 {
-    return str && strstr(str, "  ");
+    return has_class_(c, CHAR_NAME_START_);
 }
 
 
 
-static const char *skip_ignored_characters_(const char *c)
+static bool is_valid_section_character_(const char c)
 {
-    if (!c) return NULL;
-
-    while (isspace((unsigned char)*c))
-        c++;
-
-    if (*c == ';' || *c == '#')
-        return c + strlen(c);
-
-    return c;
+    return has_class_(c, CHAR_SECTION_);
 }
 
 
 
-static bool is_valid_section_starting_character_(const char c)
+static bool is_valid_key_starting_value_(const char c)
 {
-    return (isalpha( (unsigned char) c)) || c == '_';
+    return has_class_(c, CHAR_NAME_START_);
 }
 
 
 
-static bool is_valid_section_character_(const char c)
+static bool is_valid_key_character_(const char c)
 {
-    return (isalnum((unsigned char)c)) || c == '_' || c == ' ';
+    return has_class_(c, CHAR_KEY_);
 }
 
 
 
-static bool is_valid_key_starting_value_(const char c)
+// A valid value character that needs no special handling (i.e. not a space)
+static bool is_plain_value_character_(const char c)
 {
-    return (isalpha( (unsigned char) c)) || c == '_';
+    return has_class_(c, CHAR_PLAIN_VALUE_);
 }
 
 
 
-static bool is_valid_key_character_(const char c)
+static bool has_class_(const char c, const unsigned char_class)
 {
-    return (isalnum((unsigned char)c)) || c == '_';
+    return char_classes_[(unsigned char)c] & char_class;
 }
 
 
-
-static bool is_valid_value_character_(const char c)
+// The 128 leading bits of 5^exponent for exponents from -342 to 308, high
+// half first, rounded up for negative exponents (Lemire, "Number Parsing at
+// a Gigabyte per Second", 2021).
+static const unsigned long long *power_of_five_(const int exponent)
 {
-    if (c == '\n' || c == '\r' || c == '\0'
-    ||  strchr("[];#\"", c) != NULL
-    ||  iscntrl((unsigned)c))
-        return false;
-
-    return true;
+    static const unsigned long long powers[][2] =
+    {
+        { 0xeef453d6923bd65aull, 0x113faa2906a13b3full }, { 0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull },
+        { 0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull }, { 0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull },
+        { 0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull }, { 0xb64ec836a47146f9ull, 0x9748e2826cdee284ull },
+        { 0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull }, { 0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull },
+        { 0xb208ef855c969f4full, 0xbdbd2d335e51a935ull }, { 0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull },
+        { 0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull }, { 0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull },
+        { 0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull }, { 0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull },
+        { 0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull }, { 0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull },
+        { 0x84a57695fe98746dull, 0x014bb630f7604b57ull }, { 0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull },
+        { 0xcf42894a5dce35eaull, 0x52064cac828675b9ull }, { 0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull },
+        { 0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull }, { 0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull },
+        { 0xfd00b897478238d0ull, 0x8920b098955522b4ull }, { 0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull },
+        { 0xc5a890362fddbc62ull, 0xeb2189f734aa831dull }, { 0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull },
+        { 0x9a6bb0aa55653b2dull, 0x47b233c92125366eull }, { 0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull },
+        { 0xf148440a256e2c76ull, 0xc00670ea43ca250dull }, { 0x96cd2a865764dbcaull, 0x380406926a5e5728ull },
+        { 0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull }, { 0xeba09271e88d976bull, 0xf7864a44c633682eull },
+        { 0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull }, { 0xb8157268fdae9e4cull, 0x5960ea05bad82964ull },
+        { 0xe61acf033d1a45dfull, 0x6fb92487298e33bdull }, { 0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull },
+        { 0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull }, { 0xe0b62e2929aba83cull, 0x331acdabfe94de87ull },
+        { 0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull }, { 0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull },
+        { 0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull }, { 0x892731ac9faf056eull, 0xbe311c083a225cd2ull },
+        { 0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull }, { 0xd64d3d9db981787dull, 0x092cbbccdad5b108ull },
+        { 0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull }, { 0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull },
+        { 0xd1476e2c07286faaull, 0x1af5af660db4aee1ull }, { 0x82cca4db847945caull, 0x50d98d9fc890ed4dull },
+        { 0xa37fce126597973cull, 0xe50ff107bab528a0ull }, { 0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull },
+        { 0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull }, { 0x9faacf3df73609b1ull, 0x77b191618c54e9acull },
+        { 0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull }, { 0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull },
+        { 0x9becce62836ac577ull, 0x4ee367f9430aec32ull }, { 0xc2e801fb244576d5ull, 0x229c41f793cda73full },
+        { 0xf3a20279ed56d48aull, 0x6b43527578c1110full }, { 0x9845418c345644d6ull, 0x830a13896b78aaa9ull },
+        { 0xbe5691ef416bd60cull, 0x23cc986bc656d553ull }, { 0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull },
+        { 0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull }, { 0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull },
+        { 0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull }, { 0x91376c36d99995beull, 0x23100809b9c21fa1ull },
+        { 0xb58547448ffffb2dull, 0xabd40a0c2832a78aull }, { 0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull },
+        { 0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull }, { 0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull },
+        { 0xdd95317f31c7fa1dull, 0x40405643d711d583ull }, { 0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull },
+        { 0xad1c8eab5ee43b66ull, 0xda3243650005eecfull }, { 0xd863b256369d4a40ull, 0x90bed43e40076a82ull },
+        { 0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull }, { 0xa90de3535aaae202ull, 0x711515d0a205cb36ull },
+        { 0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull }, { 0x8412d9991ed58091ull, 0xe858790afe9486c2ull },
+        { 0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull }, { 0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full },
+        { 0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull }, { 0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull },
+        { 0xc987434744ac874eull, 0xa327ffb266b56220ull }, { 0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull },
+        { 0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull }, { 0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull },
+        { 0xf6019da07f549b2bull, 0x7e2a53a146606a48ull }, { 0x99c102844f94e0fbull, 0x2eda7444cbfc426dull },
+        { 0xc0314325637a1939ull, 0xfa911155fefb5308ull }, { 0xf03d93eebc589f88ull, 0x793555ab7eba27caull },
+        { 0x96267c7535b763b5ull, 0x4bc1558b2f3458deull }, { 0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull },
+        { 0xea9c227723ee8bcbull, 0x465e15a979c1cadcull }, { 0x92a1958a7675175full, 0x0bfacd89ec191ec9ull },
+        { 0xb749faed14125d36ull, 0xcef980ec671f667bull }, { 0xe51c79a85916f484ull, 0x82b7e12780e7401aull },
+        { 0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull }, { 0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull },
+        { 0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull }, { 0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull },
+        { 0xaecc49914078536dull, 0x58fae9f773886e18ull }, { 0xda7f5bf590966848ull, 0xaf39a475506a899eull },
+        { 0x888f99797a5e012dull, 0x6d8406c952429603ull }, { 0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull },
+        { 0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull }, { 0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full },
+        { 0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull }, { 0xd0601d8efc57b08bull, 0xf13b94daf124da26ull },
+        { 0x823c12795db6ce57ull, 0x76c53d08d6b70858ull }, { 0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull },
+        { 0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull }, { 0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull },
+        { 0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull }, { 0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull },
+        { 0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull }, { 0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull },
+        { 0xc21094364dfb5636ull, 0x985915fc12f542e4ull }, { 0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull },
+        { 0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull }, { 0xbd8430bd08277231ull, 0x50c6ff782a838353ull },
+        { 0xece53cec4a314ebdull, 0xa4f8bf5635246428ull }, { 0x940f4613ae5ed136ull, 0x871b7795e136be99ull },
+        { 0xb913179899f68584ull, 0x28e2557b59846e3full }, { 0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull },
+        { 0x9096ea6f3848984full, 0x3ff0d2c85def7621ull }, { 0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull },
+        { 0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull }, { 0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull },
+        { 0xb080392cc4349decull, 0xbd8d794d96aacfb3ull }, { 0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull },
+        { 0x89e42caaf9491b60ull, 0xf41686c49db57244ull }, { 0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull },
+        { 0xd77485cb25823ac7ull, 0x7d633293366b828bull }, { 0x86a8d39ef77164bcull, 0xae5dff9c02033197ull },
+        { 0xa8530886b54dbdebull, 0xd9f57f830283fdfcull }, { 0xd267caa862a12d66ull, 0xd072df63c324fd7bull },
+        { 0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull }, { 0xa46116538d0deb78ull, 0x52d9be85f074e608ull },
+        { 0xcd795be870516656ull, 0x67902e276c921f8bull }, { 0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull },
+        { 0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull }, { 0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull },
+        { 0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull }, { 0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull },
+        { 0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull }, { 0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull },
+        { 0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull }, { 0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull },
+        { 0xef340a98172aace4ull, 0x86fb897116c87c34ull }, { 0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull },
+        { 0xbae0a846d2195712ull, 0x8974836059cca109ull }, { 0xe998d258869facd7ull, 0x2bd1a438703fc94bull },
+        { 0x91ff83775423cc06ull, 0x7b6306a34627ddcfull }, { 0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull },
+        { 0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull }, { 0x8e938662882af53eull, 0x547eb47b7282ee9cull },
+        { 0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull }, { 0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull },
+        { 0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull }, { 0xae0b158b4738705eull, 0x9624ab50b148d445ull },
+        { 0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull }, { 0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull },
+        { 0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull }, { 0xd47487cc8470652bull, 0x7647c3200069671full },
+        { 0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull }, { 0xa5fb0a17c777cf09ull, 0xf468107100525890ull },
+        { 0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull }, { 0x81ac1fe293d599bfull, 0xc6f14cd848405530ull },
+        { 0xa21727db38cb002full, 0xb8ada00e5a506a7cull }, { 0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull },
+        { 0xfd442e4688bd304aull, 0x908f4a166d1da663ull }, { 0x9e4a9cec15763e2eull, 0x9a598e4e043287feull },
+        { 0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull }, { 0xf7549530e188c128ull, 0xd12bee59e68ef47cull },
+        { 0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull }, { 0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull },
+        { 0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull }, { 0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull },
+        { 0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull }, { 0xebdf661791d60f56ull, 0x111b495b3464ad21ull },
+        { 0x936b9fcebb25c995ull, 0xcab10dd900beec34ull }, { 0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull },
+        { 0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull }, { 0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull },
+        { 0xb3f4e093db73a093ull, 0x59ed216765690f56ull }, { 0xe0f218b8d25088b8ull, 0x306869c13ec3532cull },
+        { 0x8c974f7383725573ull, 0x1e414218c73a13fbull }, { 0xafbd2350644eeacfull, 0xe5d1929ef90898faull },
+        { 0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull }, { 0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull },
+        { 0xab9eb47c81f5114full, 0x066ea92f3f326564ull }, { 0xd686619ba27255a2ull, 0xc80a537b0efefebdull },
+        { 0x8613fd0145877585ull, 0xbd06742ce95f5f36ull }, { 0xa798fc4196e952e7ull, 0x2c48113823b73704ull },
+        { 0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull }, { 0x82ef85133de648c4ull, 0x9a984d73dbe722fbull },
+        { 0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull }, { 0xcc963fee10b7d1b3ull, 0x318df905079926a8ull },
+        { 0xffbbcfe994e5c61full, 0xfdf17746497f7052ull }, { 0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull },
+        { 0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull }, { 0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull },
+        { 0x9c1661a651213e2dull, 0x06bea10ca65c084eull }, { 0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull },
+        { 0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull }, { 0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull },
+        { 0xbe89523386091465ull, 0xf6bbb397f1135823ull }, { 0xee2ba6c0678b597full, 0x746aa07ded582e2cull },
+        { 0x94db483840b717efull, 0xa8c2a44eb4571cdcull }, { 0xba121a4650e4ddebull, 0x92f34d62616ce413ull },
+        { 0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull }, { 0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull },
+        { 0xb5b5ada8aaff80b8ull, 0x0d819992132456baull }, { 0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull },
+        { 0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull }, { 0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull },
+        { 0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull }, { 0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull },
+        { 0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull }, { 0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull },
+        { 0x87625f056c7c4a8bull, 0x11471cd764ad4972ull }, { 0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull },
+        { 0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull }, { 0x843610cb4bf160cbull, 0xcedf722a585139baull },
+        { 0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull }, { 0xce947a3da6a9273eull, 0x733d226229feea32ull },
+        { 0x811ccc668829b887ull, 0x0806357d5a3f525full }, { 0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull },
+        { 0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull }, { 0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull },
+        { 0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull }, { 0xc5029163f384a931ull, 0x0a9e795e65d4df11ull },
+        { 0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull }, { 0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull },
+        { 0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull }, { 0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull },
+        { 0x964e858c91ba2655ull, 0x3a6a07f8d510f86full }, { 0xbbe226efb628afeaull, 0x890489f70a55368bull },
+        { 0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull }, { 0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull },
+        { 0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull }, { 0xe55990879ddcaabdull, 0xcc420a6a101d0515ull },
+        { 0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull }, { 0xb32df8e9f3546564ull, 0x47939822dc96abf9ull },
+        { 0xdff9772470297ebdull, 0x59787e2b93bc56f7ull }, { 0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull },
+        { 0xaefae51477a06b03ull, 0xede622920b6b23f1ull }, { 0xdab99e59958885c4ull, 0xe95fab368e45ecedull },
+        { 0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull }, { 0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull },
+        { 0xd59944a37c0752a2ull, 0x4be76d3346f0495full }, { 0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull },
+        { 0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull }, { 0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull },
+        { 0x825ecc24c873782full, 0x8ed400668c0c28c8ull }, { 0xa2f67f2dfa90563bull, 0x728900802f0f32faull },
+        { 0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull }, { 0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull },
+        { 0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull }, { 0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull },
+        { 0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull }, { 0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull },
+        { 0xc24452da229b021bull, 0xfbe85badce996168ull }, { 0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull },
+        { 0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull }, { 0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull },
+        { 0xed246723473e3813ull, 0x290123e9aab23b68ull }, { 0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull },
+        { 0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull }, { 0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull },
+        { 0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull }, { 0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull },
+        { 0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull }, { 0x8d590723948a535full, 0x579c487e5a38ad0eull },
+        { 0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull }, { 0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull },
+        { 0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull }, { 0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full },
+        { 0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full }, { 0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull },
+        { 0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull }, { 0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull },
+        { 0x83a3eeeef9153e89ull, 0x1953cf68300424acull }, { 0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull },
+        { 0xcdb02555653131b6ull, 0x3792f412cb06794dull }, { 0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull },
+        { 0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull }, { 0xc8de047564d20a8bull, 0xf245825a5a445275ull },
+        { 0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull }, { 0x9ced737bb6c4183dull, 0x55464dd69685606bull },
+        { 0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull }, { 0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull },
+        { 0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull }, { 0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull },
+        { 0xef73d256a5c0f77cull, 0x963e66858f6d4440ull }, { 0x95a8637627989aadull, 0xdde7001379a44aa8ull },
+        { 0xbb127c53b17ec159ull, 0x5560c018580d5d52ull }, { 0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull },
+        { 0x9226712162ab070dull, 0xcab3961304ca70e8ull }, { 0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull },
+        { 0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull }, { 0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull },
+        { 0xb267ed1940f1c61cull, 0x55f038b237591ed3ull }, { 0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull },
+        { 0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull }, { 0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull },
+        { 0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull }, { 0x881cea14545c7575ull, 0x7e50d64177da2e54ull },
+        { 0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull }, { 0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull },
+        { 0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull }, { 0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull },
+        { 0xcfb11ead453994baull, 0x67de18eda5814af2ull }, { 0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull },
+        { 0xa2425ff75e14fc31ull, 0xa1258379a94d028dull }, { 0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull },
+        { 0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull }, { 0x9e74d1b791e07e48ull, 0x775ea264cf55347eull },
+        { 0xc612062576589ddaull, 0x95364afe032a819eull }, { 0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull },
+        { 0x9abe14cd44753b52ull, 0xc4926a9672793543ull }, { 0xc16d9a0095928a27ull, 0x75b7053c0f178294ull },
+        { 0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull }, { 0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull },
+        { 0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull }, { 0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull },
+        { 0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull }, { 0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull },
+        { 0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull }, { 0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull },
+        { 0xb424dc35095cd80full, 0x538484c19ef38c95ull }, { 0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull },
+        { 0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull }, { 0xafebff0bcb24aafeull, 0xf78f69a51539d749ull },
+        { 0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull }, { 0x89705f4136b4a597ull, 0x31680a88f8953031ull },
+        { 0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull }, { 0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull },
+        { 0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull }, { 0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull },
+        { 0xd1b71758e219652bull, 0xd3c36113404ea4a9ull }, { 0x83126e978d4fdf3bull, 0x645a1cac083126eaull },
+        { 0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull }, { 0xccccccccccccccccull, 0xcccccccccccccccdull },
+        { 0x8000000000000000ull, 0x0000000000000000ull }, { 0xa000000000000000ull, 0x0000000000000000ull },
+        { 0xc800000000000000ull, 0x0000000000000000ull }, { 0xfa00000000000000ull, 0x0000000000000000ull },
+        { 0x9c40000000000000ull, 0x0000000000000000ull }, { 0xc350000000000000ull, 0x0000000000000000ull },
+        { 0xf424000000000000ull, 0x0000000000000000ull }, { 0x9896800000000000ull, 0x0000000000000000ull },
+        { 0xbebc200000000000ull, 0x0000000000000000ull }, { 0xee6b280000000000ull, 0x0000000000000000ull },
+        { 0x9502f90000000000ull, 0x0000000000000000ull }, { 0xba43b74000000000ull, 0x0000000000000000ull },
+        { 0xe8d4a51000000000ull, 0x0000000000000000ull }, { 0x9184e72a00000000ull, 0x0000000000000000ull },
+        { 0xb5e620f480000000ull, 0x0000000000000000ull }, { 0xe35fa931a0000000ull, 0x0000000000000000ull },
+        { 0x8e1bc9bf04000000ull, 0x0000000000000000ull }, { 0xb1a2bc2ec5000000ull, 0x0000000000000000ull },
+        { 0xde0b6b3a76400000ull, 0x0000000000000000ull }, { 0x8ac7230489e80000ull, 0x0000000000000000ull },
+        { 0xad78ebc5ac620000ull, 0x0000000000000000ull }, { 0xd8d726b7177a8000ull, 0x0000000000000000ull },
+        { 0x878678326eac9000ull, 0x0000000000000000ull }, { 0xa968163f0a57b400ull, 0x0000000000000000ull },
+        { 0xd3c21bcecceda100ull, 0x0000000000000000ull }, { 0x84595161401484a0ull, 0x0000000000000000ull },
+        { 0xa56fa5b99019a5c8ull, 0x0000000000000000ull }, { 0xcecb8f27f4200f3aull, 0x0000000000000000ull },
+        { 0x813f3978f8940984ull, 0x4000000000000000ull }, { 0xa18f07d736b90be5ull, 0x5000000000000000ull },
+        { 0xc9f2c9cd04674edeull, 0xa400000000000000ull }, { 0xfc6f7c4045812296ull, 0x4d00000000000000ull },
+        { 0x9dc5ada82b70b59dull, 0xf020000000000000ull }, { 0xc5371912364ce305ull, 0x6c28000000000000ull },
+        { 0xf684df56c3e01bc6ull, 0xc732000000000000ull }, { 0x9a130b963a6c115cull, 0x3c7f400000000000ull },
+        { 0xc097ce7bc90715b3ull, 0x4b9f100000000000ull }, { 0xf0bdc21abb48db20ull, 0x1e86d40000000000ull },
+        { 0x96769950b50d88f4ull, 0x1314448000000000ull }, { 0xbc143fa4e250eb31ull, 0x17d955a000000000ull },
+        { 0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull }, { 0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull },
+        { 0xb7abc627050305adull, 0xf14a3d9e40000000ull }, { 0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull },
+        { 0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull }, { 0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull },
+        { 0xe0352f62a19e306eull, 0xd50b2037ad200000ull }, { 0x8c213d9da502de45ull, 0x4526f422cc340000ull },
+        { 0xaf298d050e4395d6ull, 0x9670b12b7f410000ull }, { 0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull },
+        { 0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull }, { 0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull },
+        { 0xd5d238a4abe98068ull, 0x72a4904598d6d880ull }, { 0x85a36366eb71f041ull, 0x47a6da2b7f864750ull },
+        { 0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull }, { 0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull },
+        { 0x82818f1281ed449full, 0xbff8f10e7a8921a4ull }, { 0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull },
+        { 0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull }, { 0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull },
+        { 0x9f4f2726179a2245ull, 0x01d762422c946590ull }, { 0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull },
+        { 0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull }, { 0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full },
+        { 0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull }, { 0xf316271c7fc3908aull, 0x8bef464e3945ef7aull },
+        { 0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull }, { 0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull },
+        { 0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull }, { 0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull },
+        { 0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull }, { 0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull },
+        { 0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull }, { 0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull },
+        { 0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull }, { 0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull },
+        { 0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull }, { 0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull },
+        { 0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull }, { 0xacb92ed9397bf996ull, 0x49c2c37f07965404ull },
+        { 0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull }, { 0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull },
+        { 0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull }, { 0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull },
+        { 0x83c7088e1aab65dbull, 0x792667c6da79e0faull }, { 0xa4b8cab1a1563f52ull, 0x577001b891185938ull },
+        { 0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull }, { 0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull },
+        { 0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull }, { 0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull },
+        { 0xfb5878494ace3a5full, 0x04ab48a04065c723ull }, { 0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull },
+        { 0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull }, { 0xf5746577930d6500ull, 0xca8f44ec7ee36479ull },
+        { 0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull }, { 0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull },
+        { 0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull }, { 0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull },
+        { 0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull }, { 0xea1575143cf97226ull, 0xf52d09d71a3293bdull },
+        { 0x924d692ca61be758ull, 0x593c2626705f9c56ull }, { 0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull },
+        { 0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull }, { 0x8edf98b59a373fecull, 0x4724bd4189bd5eacull },
+        { 0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull }, { 0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull },
+        { 0x8b865b215899f46cull, 0xbd79e0d20082ee74ull }, { 0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull },
+        { 0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull }, { 0x884134fe908658b2ull, 0x3109058d147fdcddull },
+        { 0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull }, { 0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull },
+        { 0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull }, { 0xa6539930bf6bff45ull, 0x84db8346b786151cull },
+        { 0xcfe87f7cef46ff16ull, 0xe612641865679a63ull }, { 0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull },
+        { 0xa26da3999aef7749ull, 0xe3be5e330f38f09dull }, { 0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull },
+        { 0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull }, { 0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull },
+        { 0xc646d63501a1511dull, 0xb281e1fd541501b8ull }, { 0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull },
+        { 0x9ae757596946075full, 0x3375788de9b06958ull }, { 0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull },
+        { 0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull }, { 0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull },
+        { 0xbd176620a501fbffull, 0xb650e5a93bc3d898ull }, { 0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull },
+        { 0x93ba47c980e98cdfull, 0xc66f336c36b10137ull }, { 0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull },
+        { 0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull }, { 0x9043ea1ac7e41392ull, 0x87c89837ad68db2full },
+        { 0xb454e4a179dd1877ull, 0x29babe4598c311fbull }, { 0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull },
+        { 0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull }, { 0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full },
+        { 0xdc21a1171d42645dull, 0x76707543f4fa1f73ull }, { 0x899504ae72497ebaull, 0x6a06494a791c53a8ull },
+        { 0xabfa45da0edbde69ull, 0x0487db9d17636892ull }, { 0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull },
+        { 0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull }, { 0xa7f26836f282b732ull, 0x8e6cac7768d7141eull },
+        { 0xd1ef0244af2364ffull, 0x3207d795430cd926ull }, { 0x8335616aed761f1full, 0x7f44e6bd49e807b8ull },
+        { 0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull }, { 0xcd036837130890a1ull, 0x36dba887c37a8c0full },
+        { 0x802221226be55a64ull, 0xc2494954da2c9789ull }, { 0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull },
+        { 0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull }, { 0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull },
+        { 0x9c69a97284b578d7ull, 0xff2a760414536efbull }, { 0xc38413cf25e2d70dull, 0xfef5138519684abaull },
+        { 0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull }, { 0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull },
+        { 0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull }, { 0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull },
+        { 0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull }, { 0xba756174393d88dfull, 0x94f971119aeef9e4ull },
+        { 0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull }, { 0x91abb422ccb812eeull, 0xac62e055c10ab33aull },
+        { 0xb616a12b7fe617aaull, 0x577b986b314d6009ull }, { 0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull },
+        { 0x8e41ade9fbebc27dull, 0x14588f13be847307ull }, { 0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull },
+        { 0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull }, { 0x8aec23d680043beeull, 0x25de7bb9480d5854ull },
+        { 0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull }, { 0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull },
+        { 0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull }, { 0xa99541bf57452b28ull, 0x353a1607ac744a53ull },
+        { 0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull }, { 0x847c9b5d7c2e09b7ull, 0x69956135febada11ull },
+        { 0xa59bc234db398c25ull, 0x43fab9837e699095ull }, { 0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull },
+        { 0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull }, { 0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull },
+        { 0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull }, { 0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull },
+        { 0x9defbf01b061adabull, 0x3a0888136afa64a7ull }, { 0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull },
+        { 0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull }, { 0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull },
+        { 0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull }, { 0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull },
+        { 0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull }, { 0xbc4665b596706114ull, 0x873d5d9f0dde1feeull },
+        { 0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull }, { 0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull },
+        { 0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full }, { 0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull },
+        { 0x8fa475791a569d10ull, 0xf96e017d694487bcull }, { 0xb38d92d760ec4455ull, 0x37c981dcc395a9acull },
+        { 0xe070f78d3927556aull, 0x85bbe253f47b1417ull }, { 0x8c469ab843b89562ull, 0x93956d7478ccec8eull },
+        { 0xaf58416654a6babbull, 0x387ac8d1970027b2ull }, { 0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull },
+        { 0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull }, { 0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull },
+        { 0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull }, { 0x85c7056562757456ull, 0xf6872d5667844e49ull },
+        { 0xa738c6bebb12d16cull, 0xb428f8ac016561dbull }, { 0xd106f86e69d785c7ull, 0xe13336d701beba52ull },
+        { 0x82a45b450226b39cull, 0xecc0024661173473ull }, { 0xa34d721642b06084ull, 0x27f002d7f95d0190ull },
+        { 0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull }, { 0xff290242c83396ceull, 0x7e67047175a15271ull },
+        { 0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull }, { 0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull },
+        { 0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull }, { 0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull },
+        { 0xc2abf989935ddbfeull, 0x6acff893d00ea435ull }, { 0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull },
+        { 0x98165af37b2153deull, 0xc3727a337a8b704aull }, { 0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull },
+        { 0xeda2ee1c7064130cull, 0x1162def06f79df73ull }, { 0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull },
+        { 0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull }, { 0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull },
+        { 0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull }, { 0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull },
+        { 0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull }, { 0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull },
+        { 0xb10d8e1456105dadull, 0x7425a83e872c5f47ull }, { 0xdd50f1996b947518ull, 0xd12f124e28f77719ull },
+        { 0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full }, { 0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull },
+        { 0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull }, { 0x8714a775e3e95c78ull, 0x65acfaec34810a71ull },
+        { 0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull }, { 0xd31045a8341ca07cull, 0x1ede48111209a050ull },
+        { 0x83ea2b892091e44dull, 0x934aed0aab460432ull }, { 0xa4e4b66b68b65d60ull, 0xf81da84d5617853full },
+        { 0xce1de40642e3f4b9ull, 0x36251260ab9d668eull }, { 0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull },
+        { 0xa1075a24e4421730ull, 0xb24cf65b8612f81full }, { 0xc94930ae1d529cfcull, 0xdee033f26797b627ull },
+        { 0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull }, { 0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull },
+        { 0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull }, { 0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull },
+        { 0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull }, { 0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull },
+        { 0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull }, { 0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull },
+        { 0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull }, { 0xea53df5fd18d5513ull, 0x84c86189216dc5edull },
+        { 0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull }, { 0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull },
+        { 0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull }, { 0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull },
+        { 0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull }, { 0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull },
+        { 0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull }, { 0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull },
+        { 0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull }, { 0x8865899617fb1871ull, 0x7e2fa67c7a658892ull },
+        { 0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull }, { 0xd51ea6fa85785631ull, 0x552a74227f3ea565ull },
+        { 0x8533285c936b35deull, 0xd53a88958f87275full }, { 0xa67ff273b8460356ull, 0x8a892abaf368f137ull },
+        { 0xd01fef10a657842cull, 0x2d2b7569b0432d85ull }, { 0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull },
+        { 0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full }, { 0xcb3f2f7642717713ull, 0x241c70a936219a73ull },
+        { 0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull }, { 0x9ec95d1463e8a506ull, 0xf4363804324a40aaull },
+        { 0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull }, { 0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull },
+        { 0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull }, { 0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull },
+        { 0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull }, { 0x976e41088617ca01ull, 0xd5be0503e085d813ull },
+        { 0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull }, { 0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull },
+        { 0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull }, { 0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull },
+        { 0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull }, { 0x906a617d450187e2ull, 0x27fb2b80668b24c5ull },
+        { 0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull }, { 0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull },
+        { 0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull }, { 0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull },
+        { 0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull }, { 0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull },
+        { 0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull }, { 0xd732290fbacaf133ull, 0xa97c177947ad4095ull },
+        { 0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull }, { 0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull },
+        { 0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull }, { 0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull },
+        { 0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull }, { 0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull },
+        { 0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull }, { 0xa0555e361951c366ull, 0xd7e105bcc332621full },
+        { 0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull }, { 0xfa856334878fc150ull, 0xb14f98f6f0feb951ull },
+        { 0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull }, { 0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull },
+        { 0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull }, { 0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull },
+        { 0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull }, { 0xeeea5d5004981478ull, 0x1858ccfce06cac74ull },
+        { 0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull }, { 0xbaa718e68396cffdull, 0xd30560258f54e6baull },
+        { 0xe950df20247c83fdull, 0x47c6b82ef32a2069ull }, { 0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull },
+        { 0xb6472e511c81471dull, 0xe0133fe4adf8e952ull }, { 0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull },
+        { 0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull }
+    };
+
+    return powers[exponent + 342];
 }
@@ -46,10 +46,23 @@
 
 
 
-typedef struct INIPair_t    INIPair_t;
-typedef struct INISection_t INISection_t;
-typedef struct INIData_t    INIData_t;
-typedef struct INIError_t   INIError_t;
+typedef struct INIPair_t      INIPair_t;
+typedef struct INISection_t   INISection_t;
+typedef struct INIData_t      INIData_t;
+typedef struct INIError_t     INIError_t;
+typedef struct INIView_t      INIView_t;
+typedef struct INICallbacks_t INICallbacks_t;
+typedef struct INIParser_t    INIParser_t;
+typedef struct INIAllocator_t INIAllocator_t;
+typedef struct INIFrozen_t    INIFrozen_t;
+typedef struct INIIndexSlot_t INIIndexSlot_t;
+typedef struct INIIndex_t     INIIndex_t;
+typedef struct INIMeasure_t   INIMeasure_t;
+typedef struct INICachedValue_t INICachedValue_t;
+typedef struct INIBinding_t   INIBinding_t;
+typedef union  INIBindDefault_t INIBindDefault_t;
+typedef struct INIKey_t       INIKey_t;
+typedef struct INIHandle_t    INIHandle_t;
 
 
 
@@ -67,12 +80,39 @@ void               ini_set_reallocator     (void*(*)(void*,    size_t));
 
 // File I/O
 INIData_t         *ini_read_file_path      (const char*,       INIData_t*,       INIError_t*, uint64_t);
+INIData_t         *ini_map_file_path       (const char*,       INIData_t*,       INIError_t*, uint64_t);
 INIData_t         *ini_read_file_pointer   (FILE*,             INIData_t*,       INIError_t*, uint64_t);
+INIData_t         *ini_read_buffer         (const char*,       size_t,           INIData_t*,  INIError_t*, uint64_t);
+INIData_t         *ini_read_buffer_parallel(const char*,       size_t,           unsigned,    INIData_t*, INIError_t*, uint64_t);
+INIData_t         *ini_read_directory      (const char*,       const char*,      unsigned,    INIData_t*, INIError_t*, uint64_t);
 void               ini_write_file_path     (const char*,       const INIData_t*);
 void               ini_write_file_pointer  (FILE*,             const INIData_t*);
 
 
 
+// Streaming
+bool               ini_stream_file_path    (const char*,       const INICallbacks_t*, void*, INIError_t*, uint64_t);
+bool               ini_stream_file_pointer (FILE*,             const INICallbacks_t*, void*, INIError_t*, uint64_t);
+bool               ini_stream_buffer       (const char*,       size_t, const INICallbacks_t*, void*, INIError_t*, uint64_t);
+
+
+
+// Measuring
+bool               ini_measure_file_path   (const char*,       INIMeasure_t*,    INIError_t*, uint64_t);
+bool               ini_measure_file_pointer(FILE*,             INIMeasure_t*,    INIError_t*, uint64_t);
+bool               ini_measure_buffer      (const char*,       size_t,           INIMeasure_t*, INIError_t*, uint64_t);
+
+
+
+// Push parsing
+INIParser_t       *ini_parser_create       (INIData_t*,        const INICallbacks_t*, void*, INIError_t*, uint64_t);
+void               ini_parser_free         (INIParser_t*);
+bool               ini_parser_init         (INIParser_t*,      INIData_t*,       const INICallbacks_t*, void*, INIError_t*, uint64_t);
+bool               ini_parser_feed         (INIParser_t*,      const char*,      size_t);
+bool               ini_parser_finish       (INIParser_t*);
+
+
+
 // Database insertion
 INISection_t      *ini_add_section         (INIData_t*,        const char*);
 INIPair_t         *ini_add_pair            (const INIData_t*,  const char*,      INIPair_t);
@@ -80,15 +120,76 @@ INIPair_t         *ini_add_pair_to_section (INISection_t *,    INIPair_t);
 
 
 
+// Database indexing
+bool               ini_enable_index        (INIData_t*);
+void               ini_disable_index       (INIData_t*);
+
+
+
 // Database query
 INISection_t      *ini_has_section         (const INIData_t*,  const char*);
 const char        *ini_get_value           (const INIData_t*,  const char*,      const char*);
+INIView_t          ini_get_view            (const INIData_t*,  const char*,      const char*);
 const char        *ini_get_string          (const INIData_t*,  const char*,      const char*, const char*);
 unsigned long long ini_get_unsigned        (const INIData_t*,  const char*,      const char*, unsigned long long);
 long long          ini_get_signed          (const INIData_t*,  const char*,      const char*, long long);
 unsigned long long ini_get_hex             (const INIData_t*,  const char*,      const char*, unsigned long long);
 long double        ini_get_float           (const INIData_t*,  const char*,      const char*, long double);
 bool               ini_get_bool            (const INIData_t*,  const char*,      const char*, bool);
+double             ini_get_double          (const INIData_t*,  const char*,      const char*, double,      int*);
+int64_t            ini_get_int64           (const INIData_t*,  const char*,      const char*, int64_t,     int*);
+
+
+
+// Prehashed lookups
+INIKey_t           ini_key                 (const char*,       const char*);
+const char        *ini_get_value_k         (const INIData_t*,  const INIKey_t*);
+INIView_t          ini_get_view_k          (const INIData_t*,  const INIKey_t*);
+const char        *ini_get_string_k        (const INIData_t*,  const INIKey_t*,  const char*);
+unsigned long long ini_get_unsigned_k      (const INIData_t*,  const INIKey_t*,  unsigned long long);
+long long          ini_get_signed_k        (const INIData_t*,  const INIKey_t*,  long long);
+unsigned long long ini_get_hex_k           (const INIData_t*,  const INIKey_t*,  unsigned long long);
+long double        ini_get_float_k         (const INIData_t*,  const INIKey_t*,  long double);
+bool               ini_get_bool_k          (const INIData_t*,  const INIKey_t*,  bool);
+double             ini_get_double_k        (const INIData_t*,  const INIKey_t*,  double,      int*);
+int64_t            ini_get_int64_k         (const INIData_t*,  const INIKey_t*,  int64_t,     int*);
+
+
+
+// Resolved lookups
+INIHandle_t        ini_resolve             (const INIData_t*,  const char*,      const char*);
+const char        *ini_handle_get_value    (const INIData_t*,  INIHandle_t*);
+INIView_t          ini_handle_get_view     (const INIData_t*,  INIHandle_t*);
+const char        *ini_handle_get_string   (const INIData_t*,  INIHandle_t*,     const char*);
+unsigned long long ini_handle_get_unsigned (const INIData_t*,  INIHandle_t*,     unsigned long long);
+long long          ini_handle_get_signed   (const INIData_t*,  INIHandle_t*,     long long);
+unsigned long long ini_handle_get_hex      (const INIData_t*,  INIHandle_t*,     unsigned long long);
+long double        ini_handle_get_float    (const INIData_t*,  INIHandle_t*,     long double);
+bool               ini_handle_get_bool     (const INIData_t*,  INIHandle_t*,     bool);
+double             ini_handle_get_double   (const INIData_t*,  INIHandle_t*,     double,      int*);
+int64_t            ini_handle_get_int64    (const INIData_t*,  INIHandle_t*,     int64_t,     int*);
+
+
+
+// Schema binding
+unsigned           ini_bind                (const INIData_t*,  const INIBinding_t*, unsigned, void*,     INIError_t*);
+
+
+
+// Frozen databases
+INIFrozen_t       *ini_freeze              (const INIData_t*);
+void               ini_free_frozen         (INIFrozen_t*);
+bool               ini_compile             (const INIData_t*,  const char*);
+INIFrozen_t       *ini_open_compiled       (const char*);
+int                ini_export_shared       (const INIData_t*);
+INIFrozen_t       *ini_attach_shared       (int);
+const char        *ini_frozen_get_value    (const INIFrozen_t*, const char*,     const char*);
+const char        *ini_frozen_get_string   (const INIFrozen_t*, const char*,     const char*, const char*);
+unsigned long long ini_frozen_get_unsigned (const INIFrozen_t*, const char*,     const char*, unsigned long long);
+long long          ini_frozen_get_signed   (const INIFrozen_t*, const char*,     const char*, long long);
+unsigned long long ini_frozen_get_hex      (const INIFrozen_t*, const char*,     const char*, unsigned long long);
+long double        ini_frozen_get_float    (const INIFrozen_t*, const char*,     const char*, long double);
+bool               ini_frozen_get_bool     (const INIFrozen_t*, const char*,     const char*, bool);
 
 
 
@@ -103,12 +204,19 @@ bool               ini_parse_value         (const char*,       char*,
 
 // Heap
 INIData_t         *ini_create_data         (void);
+INIData_t         *ini_create_data_with    (const INIAllocator_t*);
+INIData_t         *ini_create_data_reserve (unsigned,          unsigned);
+INIData_t         *ini_create_data_reserve_with(const INIAllocator_t*, unsigned, unsigned);
+INIData_t         *ini_create_arena_data   (void);
 void               ini_free_data           (INIData_t*);
 
 
 
 // Stack
 void               ini_init_data           (INIData_t*,        INISection_t*,    INIPair_t**, unsigned, unsigned);
+INIData_t         *ini_init_arena_data     (void*,             size_t);
+void               ini_init_pooled_data    (INIData_t*,        INISection_t*,    unsigned,    INIPair_t*, unsigned);
+bool               ini_init_strings        (INIData_t*,        void*,            size_t);
 
 
 
@@ -150,6 +258,44 @@ void               ini_init_data           (INIData_t*,        INISection_t*,
 
 
 
+#ifndef INI_MIN_PARALLEL_CHUNK
+    #define INI_MIN_PARALLEL_CHUNK (64 * 1024)
+#endif
+#ifndef INI_MAX_PARALLEL_THREADS
+    #define INI_MAX_PARALLEL_THREADS 64
+#endif
+
+
+
+#ifndef INI_STRING_BLOCK_SIZE
+    #define INI_STRING_BLOCK_SIZE 4096
+#endif
+#ifndef INI_ARENA_BLOCK_SIZE
+    #define INI_ARENA_BLOCK_SIZE (64 * 1024)
+#endif
+
+
+
+// Define INI_NO_SIMD to keep the parser from using SSE2/AVX2
+// when scanning values.
+
+// Define INI_NO_THREADS to make ini_read_buffer_parallel()
+// always read on the calling thread.
+
+// Define INI_COMPACT_STRINGS to keep section names, keys and
+// values in a string area owned by the database, allocated
+// INI_STRING_BLOCK_SIZE bytes at a time, rather than in
+// INI_MAX_STRING_SIZE arrays. Strings then have no length
+// limit and take only the space they need, but the database
+// requires the heap unless made by ini_init_arena_data().
+// Databases made by ini_init_data() or ini_init_pooled_data()
+// never use the heap for them, and need a buffer from
+// ini_init_strings() to hold any.
+// Must be defined the same for the library and everything
+// including this header.
+
+
+
 // I strongly advise against changing these
 
 #define ini_read_file(T,data,error,flags) _Generic((T), \
@@ -158,6 +304,12 @@ void               ini_init_data           (INIData_t*,        INISection_t*,
     FILE*:       ini_read_file_pointer            \
 )(T,data,error,flags)
 
+#define ini_measure_file(T,measure,error,flags) _Generic((T), \
+    const char*: ini_measure_file_path,              \
+    char*:       ini_measure_file_path,              \
+    FILE*:       ini_measure_file_pointer            \
+)(T,measure,error,flags)
+
 #define ini_write_file(T,data) _Generic((T), \
     const char*: ini_write_file_path,              \
     char*:       ini_write_file_path,              \
@@ -168,10 +320,26 @@ void               ini_init_data           (INIData_t*,        INISection_t*,
 
 // File parsing flags
 
+// Skip what can't be read instead of failing: invalid lines, keys
+// already in their section, and sections that fail to parse or
+// can't be added, along with the pairs following those.
 #define INI_CONTINUE_PAST_ERROR      (1ull << 0)
+
+// Add the pairs of a repeated section to the first one.
 #define INI_ALLOW_DUPLICATE_SECTIONS (1ull << 1)
+
+// Replace the value of a repeated key, so its section keeps a
+// single pair for it.
 #define INI_DUPLICATE_KEYS_OVERWRITE (1ull << 2)
 
+// Only index section headers while reading, and parse the pairs
+// of a section the first time it's looked up. See ini_read_buffer().
+#define INI_LAZY_SECTIONS            (1ull << 3)
+
+// With INI_COMPACT_STRINGS, point names, keys and values into the
+// contents being read instead of copying them. See ini_read_buffer().
+#define INI_BORROW_STRINGS           (1ull << 4)
+
 
 
 ////////////////////////
@@ -181,11 +349,180 @@ void               ini_init_data           (INIData_t*,        INISection_t*,
 /**
  * Key=value pair
  */
+#ifdef INI_COMPACT_STRINGS
+struct INIPair_t
+{
+    // Null-terminated, except when filled by ini_parse_pair() or
+    // read with INI_BORROW_STRINGS.
+    // A length of 0 in a pair passed to ini_add_pair() means
+    // the string is null-terminated and has it measured.
+    const char *key;
+    const char *value;
+    size_t key_length;
+    size_t value_length;
+};
+#else
 struct INIPair_t
 {
     char key[INI_MAX_STRING_SIZE];
     char value[INI_MAX_STRING_SIZE];
 };
+#endif
+
+// Pair of two null-terminated strings to pass to ini_add_pair(),
+// the same with and without INI_COMPACT_STRINGS
+#ifdef INI_COMPACT_STRINGS
+#define INI_PAIR(key, value) ((INIPair_t){ (key), (value), 0, 0 })
+#else
+#define INI_PAIR(key, value) ((INIPair_t){ key, value })
+#endif
+
+
+
+/**
+ * Value of a pair as converted by ini_get_unsigned() and friends
+ *
+ * Kept per pair so repeated lookups skip the conversion. Changing a
+ * value through the API forgets it, but writing to a pair's value
+ * directly leaves it stale.
+ *
+ * A pair holds one kind, the first it's converted to, except that
+ * unsigned integers are kept signed where that holds them. Unsigned
+ * integers are taken from signed ones that weren't clamped, and doubles
+ * from long doubles that hold them exactly, so those getters share a
+ * pair's entry. Other kinds are converted again on every lookup.
+ */
+#define INI_CACHED_NONE     0
+#define INI_CACHED_BUSY     1
+#define INI_CACHED_UNSIGNED 2
+#define INI_CACHED_SIGNED   3
+#define INI_CACHED_HEX      4
+#define INI_CACHED_FLOAT    5
+#define INI_CACHED_BOOL     6
+#define INI_CACHED_DOUBLE   7
+
+struct INICachedValue_t
+{
+    // One of INI_CACHED_*
+    unsigned char kind;
+
+    // One of INI_CONVERT_*
+    unsigned char status;
+
+    union
+    {
+        unsigned long long u;
+        long long s;
+        long double f;
+        double d;
+        bool b;
+    } value;
+};
+
+
+
+/**
+ * Outcomes of converting a value, as reported by ini_get_double()
+ * and ini_get_int64()
+ *
+ * A number followed by other characters or out of range still gives
+ * a value. The others give the default.
+ */
+#define INI_CONVERTED        0
+#define INI_CONVERT_TRAILING 1
+#define INI_CONVERT_OVERFLOW 2
+#define INI_CONVERT_INVALID  3
+#define INI_CONVERT_MISSING  4
+
+
+
+/**
+ * A section and key looked up often, with what the lookups need
+ * worked out once by ini_key(). It doesn't belong to any database,
+ * so it keeps working as they are replaced.
+ */
+struct INIKey_t
+{
+    // Not copied, so they must outlive the descriptor
+    const char *section;
+    const char *key;
+
+    size_t section_length;
+    size_t key_length;
+
+    // Hashes the index is probed with
+    uint64_t section_hash;
+    uint64_t key_hash;
+};
+
+
+
+/**
+ * A section and key resolved by ini_resolve() to the pair holding
+ * them, for the ini_handle_get_* functions
+ *
+ * The pair is looked up again whenever the handle is used with
+ * another database or one that changed since, and the handle is
+ * updated in place. Threads reading the same database each need
+ * their own handles.
+ */
+struct INIHandle_t
+{
+    INIKey_t key;
+
+    // The database and generation the pair was found in
+    const INIData_t *data;
+    uint64_t generation;
+
+    // NULL if the key wasn't there
+    INISection_t *section;
+    INIPair_t *pair;
+};
+
+
+
+/**
+ * Types of the struct members ini_bind() fills
+ */
+#define INI_BIND_STRING   0 // const char *, pointing into the database
+#define INI_BIND_INT      1 // int
+#define INI_BIND_UNSIGNED 2 // unsigned
+#define INI_BIND_INT64    3 // int64_t
+#define INI_BIND_UINT64   4 // uint64_t
+#define INI_BIND_HEX      5 // uint64_t, written in hexadecimal
+#define INI_BIND_DOUBLE   6 // double
+#define INI_BIND_BOOL     7 // bool
+#define INI_BIND_VIEW     8 // INIView_t, pointing into the database
+
+// The member matching the type is used
+union INIBindDefault_t
+{
+    long long s;
+    unsigned long long u;
+    double d;
+    bool b;
+    const char *str;
+};
+
+/**
+ * Entry of a schema for ini_bind(), binding a key to a struct member
+ *
+ *     { "window", "width", INI_BIND_INT, offsetof(Config, width), { .s = 640 } }
+ */
+struct INIBinding_t
+{
+    const char *section;
+    const char *key;
+
+    // One of INI_BIND_*
+    unsigned char type;
+
+    // Of the member, from offsetof()
+    size_t offset;
+
+    // Taken when the key is missing or its value can't be converted
+    INIBindDefault_t default_value;
+};
 
 
 
@@ -199,15 +536,99 @@ struct INISection_t
 {
     // Name of the section, excluding the encapsulating
     // [ ] characters
+#ifdef INI_COMPACT_STRINGS
+    const char *name;
+    size_t name_length;
+#else
     char name[INI_MAX_STRING_SIZE];
+#endif
+
+    // Database the section belongs to, NULL if it was only
+    // filled by ini_parse_section()
+    INIData_t *data;
 
     // Pointer to pairs
     INIPair_t *pairs;
     unsigned pair_count;
 
+    // Converted values of the pairs, parallel to them and
+    // pair_allocation long, NULL if they aren't kept
+    INICachedValue_t *cache;
+
     // Number of allocated pairs
     // >= pair_count
     unsigned pair_allocation;
+
+    // Contents of the section that haven't been parsed yet
+    // when read with INI_LAZY_SECTIONS, NULL once they are
+    const char *body;
+    size_t body_length;
+};
+
+
+
+/**
+ * Allocation functions for a single database. Each is passed
+ * ctx along with the usual malloc/realloc/free arguments.
+ */
+struct INIAllocator_t
+{
+    void *(*alloc)   (void *ctx, size_t size);
+    void *(*realloc) (void *ctx, void *ptr, size_t size);
+    void  (*free)    (void *ctx, void *ptr);
+    void *ctx;
+};
+
+
+
+/**
+ * What ini_measure_* functions found in some ini contents.
+ * Sections that appear more than once are counted each time.
+ * When INI_ALLOW_DUPLICATE_SECTIONS or INI_CONTINUE_PAST_ERROR
+ * merges them, max_pairs counts the pairs of all of their
+ * appearances together. Duplicate keys are counted each time.
+ */
+struct INIMeasure_t
+{
+    // Number of section headers
+    unsigned sections;
+
+    // Most pairs in a single section, and pairs overall
+    unsigned max_pairs;
+    unsigned total_pairs;
+
+    // Bytes of every section name, key and value, each with
+    // its null-terminator
+    size_t string_bytes;
+};
+
+
+
+/**
+ * Open-addressing hash tables over the sections and pairs
+ * of a database. Slots hold indices plus one so that zeroed
+ * slots are empty, which keeps them valid when the arrays
+ * they index are moved. Capacities are powers of two.
+ *
+ * Only defined here so that sources generated by ini2c can
+ * hold an index. See ini_enable_index().
+ */
+struct INIIndexSlot_t
+{
+    uint64_t hash;
+    unsigned section;
+    unsigned pair;
+};
+
+struct INIIndex_t
+{
+    INIIndexSlot_t *sections;
+    size_t section_capacity;
+    size_t section_count;
+
+    INIIndexSlot_t *pairs;
+    size_t pair_capacity;
+    size_t pair_count;
 };
 
 
@@ -226,6 +647,50 @@ struct INIData_t
     // Number of allocated sections
     // >= section_count
     unsigned section_allocation;
+
+    // Number of pairs a section is allocated once it gets
+    // its first, 0 for INI_INITIAL_ALLOCATED_PAIRS, or for
+    // a single pair with ini_init_arena_data()
+    unsigned pair_reservation;
+
+    // Pairs all sections take theirs from when made by
+    // ini_init_pooled_data(), NULL otherwise. The first
+    // pool_used of the pool_size pairs are taken.
+    INIPair_t *pool;
+    unsigned pool_size;
+    unsigned pool_used;
+
+    // Flags lazily read sections are parsed with, and the
+    // contents they point into if owned by the database
+    uint64_t flags;
+    struct INISource_t *sources;
+
+    // Whether sections, pairs and strings are carved out of
+    // blocks instead of being allocated one by one, and
+    // whether those blocks are limited to a buffer given by
+    // the caller
+    bool arena;
+    bool fixed;
+
+    // Whether names, keys and values may point into contents read
+    // with INI_BORROW_STRINGS, and so not be null-terminated
+    bool borrowed;
+
+    // The blocks of an arena, and where names, keys and values
+    // are kept with INI_COMPACT_STRINGS
+    struct INIBlock_t *blocks;
+
+    // Where the memory of the database comes from. Zeroed to
+    // use the functions set by ini_set_allocator() and co.
+    INIAllocator_t allocator;
+
+    // Hash tables over sections and pairs, NULL unless
+    // ini_enable_index() was called
+    INIIndex_t *index;
+
+    // Changes whenever sections or pairs are added or may
+    // have moved, so handles from ini_resolve() look again
+    uint64_t generation;
 };
 
 
@@ -250,6 +715,79 @@ struct INIError_t
 
 
 
+/**
+ * A view of a string within parsed contents. It is NOT
+ * null-terminated and is only valid for as long as the
+ * contents it points into.
+ */
+struct INIView_t
+{
+    const char *data;
+    size_t length;
+};
+
+
+
+/**
+ * Callbacks for the streaming parser. Either may be NULL.
+ * Returning false from a callback stops parsing early.
+ */
+struct INICallbacks_t
+{
+    // Called for every section header, in file order. Duplicate
+    // sections are reported each time they appear.
+    bool (*on_section)(void *user, INIView_t name);
+
+    // Called for every pair along with the name of the section
+    // it resides in. Duplicate keys are reported each time they
+    // appear.
+    bool (*on_pair)(void *user, INIView_t section, INIView_t key, INIView_t value);
+};
+
+
+
+/**
+ * An incremental parser that is fed ini contents in chunks of
+ * any size, e.g. as they arrive from a socket. Fills either an
+ * INIData_t or reports to a set of callbacks.
+ *
+ * Set up with ini_parser_init() or ini_parser_create(), the
+ * members are internal state and shouldn't be modified.
+ */
+struct INIParser_t
+{
+    // Exactly one of these is set
+    INIData_t *data;
+    const INICallbacks_t *callbacks;
+
+    void *user;
+    INIError_t *error;
+    uint64_t flags;
+
+    // Section pairs are currently added to
+    INISection_t *current_section;
+
+    // Section name reported to callbacks, kept since
+    // the chunk it came in is gone by the next feed
+    bool in_section;
+    char section[INI_MAX_LINE_SIZE];
+    size_t section_length;
+
+    // A line split across chunks
+    char line[INI_MAX_LINE_SIZE];
+    size_t line_length;
+
+    // Set once parsing has stopped, either from an
+    // error, a callback or ini_parser_finish()
+    bool done;
+    bool failed;
+
+    // What ini_parser_create() took the parser from
+    INIAllocator_t allocator;
+};
+
+
+
 ///////////////////////////
 // Function Declarations //
 ///////////////////////////
@@ -272,6 +810,8 @@ void ini_disable_heap(void);
  *  Set the allocator to be used internally by ini. If you
  *  set this, you almost *certainly* want to also set the
  *  reallocator and deallocator.
+ *  Affects the whole process and isn't thread-safe, see
+ *  ini_create_data_with() for giving a database its own.
  *
  *  @param allocator malloc like allocator
  */
@@ -318,10 +858,42 @@ void ini_set_reallocator(void *(*reallocator) (void*,size_t));
 INIData_t *ini_read_file_path(const char *path, INIData_t *data, INIError_t *error, uint64_t flags);
 
 
+/**
+ * Parse an ini file by mapping it into memory read-only rather than
+ * reading it through stdio. Behaves exactly like ini_read_file_path()
+ * otherwise, and falls back to it on platforms without mmap.
+ *
+ * Files that aren't regular files, like pipes or those in /proc,
+ * are read with ini_read_file_pointer() instead.
+ *
+ * With INI_BORROW_STRINGS (see ini_read_buffer()) or
+ * INI_LAZY_SECTIONS, the strings of data point into the mapping,
+ * which is then kept until ini_free_data(). Databases that can't
+ * use the heap copy the strings and unmap the file right away.
+ * While the mapping is kept, the file must not be truncated:
+ * touching the pages past its new end raises SIGBUS on lookups.
+ * Replace it by renaming a new file over it instead.
+ *
+ *   @param path  File path to parse
+ *   @param data  The database object to be filled with ini contents.
+ * 				  Must be a valid pointer.
+ *   @param error Pointer to error object to keep track of
+ * 				  erroneous character offset and store error message
+ *   @param flags Bit-aligned flags to control behavior of the file parser.
+ * 				  See the flag macros
+ *
+ * @return A pointer to data on success, or NULL on failure.
+ */
+INIData_t *ini_map_file_path(const char *path, INIData_t *data, INIError_t *error, uint64_t flags);
+
+
+
 /**
  * Parse an ini file and populate a data structure
  * with contents. User will need to free the returned
  * object on their own later on with a call to ini_free()
+ * Lines longer than INI_MAX_LINE_SIZE are read into a
+ * buffer on the heap, and are errors without one.
  *
  *   @param file  File pointer to parse
  *   @param data  The database object to be filled with ini contents.
@@ -337,6 +909,279 @@ INIData_t *ini_read_file_pointer(FILE *file, INIData_t *data, INIError_t *error,
 
 
 
+/**
+ * Parse ini contents that are already in memory and populate a
+ * data structure with them. Lines are parsed in place, so unlike
+ * ini_read_file_pointer() there is no intermediate line copy and
+ * long lines don't need the heap.
+ *
+ * Names, keys and values are always copied into data unless the
+ * library is built with INI_COMPACT_STRINGS and read with
+ * INI_BORROW_STRINGS. By default they're copied into
+ * INI_MAX_STRING_SIZE arrays, and with INI_COMPACT_STRINGS alone
+ * into the database's string area at only their own length.
+ *
+ * With both, they aren't copied at all, but point into buffer and
+ * are delimited by their lengths. buffer must then outlive data and
+ * not change; the file readers keep the whole file in memory for
+ * that until ini_free_data(), unless data can't use the heap. As
+ * the strings aren't null-terminated, ini_get_value() and
+ * ini_get_string() refuse them and ini_bind() reports INI_BIND_STRING
+ * members as problems. Use ini_get_view() and INI_BIND_VIEW instead.
+ * Typed getters convert them as usual. Without INI_COMPACT_STRINGS
+ * the flag is ignored.
+ *
+ * With INI_LAZY_SECTIONS only the section headers are parsed up
+ * front. The pairs of a section are parsed the first time it is
+ * looked up through ini_has_section(), ini_get_value() or any of
+ * the getters, so reading a large file costs little more than the
+ * sections actually used. Until then its pairs member is empty.
+ * Errors in pairs aren't reported when loaded this way, offending
+ * lines are skipped as with INI_CONTINUE_PAST_ERROR. The buffer
+ * must outlive data; the file readers keep their own copy or
+ * mapping alive until ini_free_data(). Lookups then modify data,
+ * so it shouldn't be shared between threads.
+ *
+ *   @param buffer The ini contents. Need not be null-terminated.
+ *   @param length The number of bytes in buffer.
+ *   @param data   The database object to be filled with ini contents.
+ * 				   Must be a valid pointer.
+ *   @param error  Pointer to error object to keep track of
+ * 				   erroneous character offset and store error message
+ *   @param flags  Bit-aligned flags to control behavior of the parser.
+ * 				   See the flag macros
+ *
+ * @return A pointer to data on success, or NULL on failure.
+ */
+INIData_t *ini_read_buffer(const char *buffer, size_t length, INIData_t *data, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Parse ini contents that are already in memory using several
+ * threads. The contents are split at section headers, each piece
+ * is parsed on its own thread and the results are merged in file
+ * order. The result, including which flags allow duplicates and
+ * which errors are reported, is exactly that of ini_read_buffer().
+ *
+ * Falls back to ini_read_buffer() when the heap is disabled, when
+ * threads aren't available, when the contents are too small to be
+ * worth splitting (see INI_MIN_PARALLEL_CHUNK), or when reading
+ * with INI_LAZY_SECTIONS.
+ *
+ * Each piece is indexed if data is (see ini_enable_index()). Index
+ * data first for contents with many sections, which would otherwise
+ * be checked for duplicates one by one in every piece.
+ *
+ *   @param buffer   The ini contents. Need not be null-terminated.
+ *   @param length   The number of bytes in buffer.
+ *   @param nthreads The number of threads to use, including the
+ *                   calling thread. At most INI_MAX_PARALLEL_THREADS.
+ *   @param data     The database object to be filled with ini contents.
+ * 				     Must be a valid pointer.
+ *   @param error    Pointer to error object to keep track of
+ * 				     erroneous character offset and store error message
+ *   @param flags    Bit-aligned flags to control behavior of the parser.
+ * 				     See the flag macros
+ *
+ * @return A pointer to data on success, or NULL on failure.
+ */
+INIData_t *ini_read_buffer_parallel(const char *buffer, size_t length, unsigned nthreads, INIData_t *data, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Parse every file in a directory whose name matches a pattern, as
+ * in a conf.d directory. Files are read in lexical order of their
+ * names, later files adding to and, following the duplicate flags,
+ * overriding earlier ones. The result is exactly that of calling
+ * ini_read_file_path() on each file in turn, but the files are
+ * parsed concurrently on up to nthreads threads before merging.
+ *
+ * Only supported on unix-like platforms. Files are read one by one
+ * on the calling thread when threads aren't available, the heap is
+ * disabled, or when reading with INI_LAZY_SECTIONS.
+ *
+ *   @param dir      The directory to read.
+ *   @param pattern  fnmatch() style pattern file names must match,
+ *                   e.g. "*.ini". NULL matches every file. As with a
+ *                   shell, wildcards don't match a leading '.'.
+ *   @param nthreads The number of threads to use, including the
+ *                   calling thread. At most INI_MAX_PARALLEL_THREADS.
+ *   @param data     The database object to be filled with ini contents.
+ * 				     Must be a valid pointer.
+ *   @param error    Pointer to error object to keep track of
+ * 				     erroneous character offset and store error message
+ *   @param flags    Bit-aligned flags to control behavior of the parser.
+ * 				     See the flag macros
+ *
+ * @return A pointer to data on success, or NULL on failure.
+ */
+INIData_t *ini_read_directory(const char *dir, const char *pattern, unsigned nthreads, INIData_t *data, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Parse an ini file and report its sections and pairs through
+ * callbacks instead of building an INIData_t. Uses a constant
+ * amount of memory no matter the size of the file.
+ *
+ *   @param path      File path to parse
+ *   @param callbacks Functions to call for each section and pair.
+ *                    Must be a valid pointer.
+ *   @param user      Passed through to the callbacks untouched.
+ *   @param error     Pointer to error object to keep track of
+ *                    erroneous character offset and store error message
+ *   @param flags     Bit-aligned flags to control behavior of the file parser.
+ *                    Only INI_CONTINUE_PAST_ERROR applies, duplicates are
+ *                    left for the callbacks to handle.
+ *
+ * @return True if the file was parsed (or a callback stopped parsing),
+ *         false on failure.
+ */
+bool ini_stream_file_path(const char *path, const INICallbacks_t *callbacks, void *user, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Parse an ini file and report its sections and pairs through
+ * callbacks instead of building an INIData_t. The views passed to
+ * the callbacks point into a line buffer that is reused, so copy
+ * anything you want to keep.
+ *
+ * @see ini_stream_file_path()
+ */
+bool ini_stream_file_pointer(FILE *file, const INICallbacks_t *callbacks, void *user, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Parse ini contents already in memory and report their sections and
+ * pairs through callbacks. The views passed to the callbacks point
+ * directly into buffer, so nothing is copied.
+ *
+ *   @param buffer The ini contents. Need not be null-terminated.
+ *   @param length The number of bytes in buffer.
+ *
+ * @see ini_stream_file_path()
+ */
+bool ini_stream_buffer(const char *buffer, size_t length, const INICallbacks_t *callbacks, void *user, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Check an ini file without storing anything and count what
+ * reading it would store, so that a database can be given
+ * exactly the space it needs up front. For example, the
+ * sections and max_pairs of a measure can size the arrays
+ * passed to ini_init_data(). Names, keys and values are
+ * limited the same as when reading into a database.
+ *
+ *   @param path    File path to measure
+ *   @param measure Filled with the counts. Must be a valid pointer.
+ *   @param error   Pointer to error object to keep track of
+ *                  erroneous character offset and store error message
+ *   @param flags   Bit-aligned flags to control behavior of the file parser.
+ *                  Only INI_CONTINUE_PAST_ERROR applies.
+ *
+ * @return True if the file was measured, false on failure.
+ */
+bool ini_measure_file_path(const char *path, INIMeasure_t *measure, INIError_t *error, uint64_t flags);
+
+
+
+/** @see ini_measure_file_path() */
+bool ini_measure_file_pointer(FILE *file, INIMeasure_t *measure, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Measure ini contents already in memory.
+ *
+ *   @param buffer The ini contents. Need not be null-terminated.
+ *   @param length The number of bytes in buffer.
+ *
+ * @see ini_measure_file_path()
+ */
+bool ini_measure_buffer(const char *buffer, size_t length, INIMeasure_t *measure, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Create a heap-allocated push parser. See ini_parser_init().
+ * A parser filling data is allocated the way data is.
+ *
+ * @return Pointer to a parser that must be free'd later with
+ *         a call to ini_parser_free(), or NULL on failure.
+ */
+INIParser_t *ini_parser_create(INIData_t *data, const INICallbacks_t *callbacks, void *user, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Free a parser created with ini_parser_create(). Does not
+ * touch the data object it was filling.
+ *
+ *   @param parser The parser to be free'd.
+ */
+void ini_parser_free(INIParser_t *parser);
+
+
+
+/**
+ * Initialize a push parser. Contents are then given to it with
+ * ini_parser_feed() and ini_parser_finish().
+ *
+ *   @param parser    The parser to be initialized.
+ *   @param data      The database object to be filled with ini contents,
+ *                    or NULL if callbacks are given instead.
+ *   @param callbacks Functions to call for each section and pair, or NULL
+ *                    if data is given instead.
+ *   @param user      Passed through to the callbacks untouched.
+ *   @param error     Pointer to error object to keep track of
+ *                    erroneous character offset and store error message
+ *   @param flags     Bit-aligned flags to control behavior of the parser.
+ *                    See the flag macros
+ *
+ * @return True on success, false if not exactly one of data and
+ *         callbacks is given.
+ */
+bool ini_parser_init(INIParser_t *parser, INIData_t *data, const INICallbacks_t *callbacks, void *user, INIError_t *error, uint64_t flags);
+
+
+
+/**
+ * Give the parser the next chunk of contents. Chunks may end
+ * anywhere, including in the middle of a line. Complete lines
+ * are parsed right away and the rest is kept until the next
+ * call. Never blocks.
+ *
+ * Lines longer than INI_MAX_LINE_SIZE (newline included) are
+ * errors no matter how they are split.
+ *
+ *   @param parser The parser to feed.
+ *   @param bytes  The next chunk of contents. Need not be null-terminated.
+ *   @param n      The number of bytes in the chunk.
+ *
+ * @return False once parsing has failed, true otherwise.
+ */
+bool ini_parser_feed(INIParser_t *parser, const char *bytes, size_t n);
+
+
+
+/**
+ * Tell the parser there are no more contents, parsing a final
+ * line that has no newline. Further feeds are ignored.
+ *
+ *   @param parser The parser to finish.
+ *
+ * @return True if all contents were parsed (or a callback stopped
+ *         parsing), false on failure.
+ */
+bool ini_parser_finish(INIParser_t *parser);
+
+
+
 /**
  * Use the contents of an INIData_t object to generate an
  * INI file (or overwrite an existing one)
@@ -401,7 +1246,8 @@ INIPair_t *ini_add_pair(const INIData_t *data, const char *section, INIPair_t pa
 
 /**
  * 	Add a pair directly to a section, agnostic to the parent
- * 	INIData_t object.
+ * 	INIData_t object. With INI_COMPACT_STRINGS the section
+ * 	must belong to a database, which the strings are copied to.
  *
  * 	  @param section The section to acquire the pair.
  * 	  @param pair    A pair object whose data will be copied into
@@ -413,6 +1259,35 @@ INIPair_t *ini_add_pair_to_section(INISection_t *section, INIPair_t pair);
 
 
 
+/**
+ * Index the sections and pairs of a database in hash tables.
+ * From then on, every section and pair added is indexed as
+ * well, and lookups, including the ones made while reading,
+ * take constant time instead of scanning. If the index can't
+ * grow at some point, it's dropped and lookups scan again.
+ *
+ *   @param data The INIData_t object to index. The index is
+ *               allocated like the rest of its memory, even for
+ *               databases made with ini_init_data().
+ *
+ * @return True if the database is indexed, false if memory for
+ *         the index couldn't be allocated.
+ */
+bool ini_enable_index(INIData_t *data);
+
+
+
+/**
+ * Free the index of a database, if it has one. ini_free_data()
+ * does this too, but databases made with ini_init_data() need
+ * to call this themselves.
+ *
+ *   @param data The INIData_t object to stop indexing.
+ */
+void ini_disable_index(INIData_t *data);
+
+
+
 /**
  * Query for a section object based on the section name.
  *
@@ -435,15 +1310,37 @@ INISection_t *ini_has_section(const INIData_t *data, const char *section);
  *   @param key     The key string to search for.
  *
  * @return The value in the form of a null-terminated C-string, or
- *         NULL if not found.
+ *         NULL if not found or if data was read with
+ *         INI_BORROW_STRINGS, whose values aren't null-terminated.
+ *         Use ini_get_view() for those.
  */
 const char *ini_get_value(const INIData_t *data, const char *section, const char *key);
 
 
 
+/**
+ * Retrieve a value from an INIData_t object given a section
+ * name and a key value, along with its length. Unlike
+ * ini_get_value(), this works for data read with
+ * INI_BORROW_STRINGS too.
+ *
+ *   @param data    The INIData_t object to be searched.
+ *   @param section The section string to search for.
+ *   @param key     The key string to search for.
+ *
+ * @return A view of the value, which is only null-terminated if
+ *         data wasn't read with INI_BORROW_STRINGS, or a view with
+ *         a NULL data member if not found.
+ */
+INIView_t ini_get_view(const INIData_t *data, const char *section, const char *key);
+
+
+
 /**
  * Attempt to fetch an string value from INI data given a
  * section and key. If unfound, returns a provided default.
+ * The default is returned too for data read with
+ * INI_BORROW_STRINGS; see ini_get_value().
  *
  *   @param data    Pointer to the INIData_t object to search
  *   @param section The section title being searched for.
@@ -463,6 +1360,12 @@ const char *ini_get_string(const INIData_t *data, const char *section, const cha
  * Attempt to fetch an unsigned integer value from INI data given a
  * section and key. If unfound, returns a provided default.
  *
+ * The converted value is kept with the pair, so asking for it again
+ * skips the conversion. This holds for the other typed getters too.
+ * Any number of threads may call the typed getters on the same data
+ * at once, as long as none of them modifies it. This does not hold
+ * for data read with INI_LAZY_SECTIONS, whose lookups parse sections.
+ *
  *   @param data    Pointer to the INIData_t object to search
  *   @param section The section title being searched for.
  *   @param key     The key being searched for.
@@ -517,6 +1420,12 @@ unsigned long long ini_get_hex(const INIData_t *data, const char *section, const
  * Attempt to fetch an floating point value from INI data given a
  * section and key. If unfound, returns a provided default.
  *
+ * Decimal and hexadecimal values, infinities and NaNs are read the way
+ * strtold() reads them in the C locale, whatever the current locale.
+ * Only where long double has more than 64 bits of precision and the
+ * compiler has no 128 bit integer are they read by strtold() itself,
+ * which follows the current locale.
+ *
  *   @param data    Pointer to the INIData_t object to search
  *   @param section The section title being searched for.
  *   @param key     The key being searched for.
@@ -549,6 +1458,311 @@ bool ini_get_bool(const INIData_t *data, const char *section, const char *key, b
 
 
 
+/**
+ * Attempt to fetch a double from INI data given a section and key,
+ * reporting how the conversion went.
+ *
+ * The conversion doesn't depend on the locale and rounds exactly, and
+ * is cheaper than ini_get_float() for the usual short decimals.
+ *
+ *   @param data    Pointer to the INIData_t object to search
+ *   @param section The section title being searched for.
+ *   @param key     The key being searched for.
+ *   @param default Default value to be used if searched
+ *                  value is not found or isn't a number.
+ *   @param status  Set to one of INI_CONVERT_* if not NULL. Values too
+ *                  large are returned as infinities and values too
+ *                  small as zeros, both with INI_CONVERT_OVERFLOW.
+ *
+ * @return The searched value or the provided default.
+ */
+double ini_get_double(const INIData_t *data, const char *section, const char *key, double default_value, int *status);
+
+
+
+/**
+ * Attempt to fetch a 64-bit signed integer from INI data given a
+ * section and key, reporting how the conversion went.
+ *
+ *   @param data    Pointer to the INIData_t object to search
+ *   @param section The section title being searched for.
+ *   @param key     The key being searched for.
+ *   @param default Default value to be used if searched
+ *                  value is not found or isn't a number.
+ *   @param status  Set to one of INI_CONVERT_* if not NULL. Values out
+ *                  of range are clamped to INT64_MIN or INT64_MAX.
+ *
+ * @return The searched value or the provided default.
+ */
+int64_t ini_get_int64(const INIData_t *data, const char *section, const char *key, int64_t default_value, int *status);
+
+
+
+/**
+ * Describe a section and key for the ini_get_*_k functions, which
+ * then skip measuring and hashing them on every lookup. Lookups are
+ * fastest on a database with an index; see ini_enable_index().
+ *
+ *   @param section The section title, which must outlive the result.
+ *   @param key     The key, which must outlive the result.
+ *
+ * @return The descriptor, usable with any database.
+ */
+INIKey_t ini_key(const char *section, const char *key);
+
+
+
+/**
+ * The ini_get_*_k functions are equivalent to the ini_get_*
+ * functions, for a section and key described by ini_key().
+ *
+ *   @param data Pointer to the INIData_t object to search.
+ *   @param key  The section and key to search for.
+ *
+ * @return See ini_get_value().
+ */
+const char *ini_get_value_k(const INIData_t *data, const INIKey_t *key);
+
+/** @see ini_get_view() */
+INIView_t ini_get_view_k(const INIData_t *data, const INIKey_t *key);
+
+/** @see ini_get_string() */
+const char *ini_get_string_k(const INIData_t *data, const INIKey_t *key, const char *default_value);
+
+/** @see ini_get_unsigned() */
+unsigned long long ini_get_unsigned_k(const INIData_t *data, const INIKey_t *key, unsigned long long default_value);
+
+/** @see ini_get_signed() */
+long long ini_get_signed_k(const INIData_t *data, const INIKey_t *key, long long default_value);
+
+/** @see ini_get_hex() */
+unsigned long long ini_get_hex_k(const INIData_t *data, const INIKey_t *key, unsigned long long default_value);
+
+/** @see ini_get_float() */
+long double ini_get_float_k(const INIData_t *data, const INIKey_t *key, long double default_value);
+
+/** @see ini_get_bool() */
+bool ini_get_bool_k(const INIData_t *data, const INIKey_t *key, bool default_value);
+
+/** @see ini_get_double() */
+double ini_get_double_k(const INIData_t *data, const INIKey_t *key, double default_value, int *status);
+
+/** @see ini_get_int64() */
+int64_t ini_get_int64_k(const INIData_t *data, const INIKey_t *key, int64_t default_value, int *status);
+
+
+
+/**
+ * Resolve a section and key to the pair holding them, so that the
+ * ini_handle_get_* functions read it without a lookup for as long
+ * as data doesn't change.
+ *
+ *   @param data    Pointer to the INIData_t object to search.
+ *   @param section The section title, which must outlive the result.
+ *   @param key     The key, which must outlive the result.
+ *
+ * @return The handle, which also resolves keys that are missing
+ *         for now and can be used with any other database.
+ */
+INIHandle_t ini_resolve(const INIData_t *data, const char *section, const char *key);
+
+
+
+/**
+ * The ini_handle_get_* functions are equivalent to the ini_get_*
+ * functions, for a handle from ini_resolve().
+ *
+ *   @param data   Pointer to the INIData_t object to search.
+ *   @param handle The handle, resolved again if out of date.
+ *
+ * @return See ini_get_value().
+ */
+const char *ini_handle_get_value(const INIData_t *data, INIHandle_t *handle);
+
+/** @see ini_get_view() */
+INIView_t ini_handle_get_view(const INIData_t *data, INIHandle_t *handle);
+
+/** @see ini_get_string() */
+const char *ini_handle_get_string(const INIData_t *data, INIHandle_t *handle, const char *default_value);
+
+/** @see ini_get_unsigned() */
+unsigned long long ini_handle_get_unsigned(const INIData_t *data, INIHandle_t *handle, unsigned long long default_value);
+
+/** @see ini_get_signed() */
+long long ini_handle_get_signed(const INIData_t *data, INIHandle_t *handle, long long default_value);
+
+/** @see ini_get_hex() */
+unsigned long long ini_handle_get_hex(const INIData_t *data, INIHandle_t *handle, unsigned long long default_value);
+
+/** @see ini_get_float() */
+long double ini_handle_get_float(const INIData_t *data, INIHandle_t *handle, long double default_value);
+
+/** @see ini_get_bool() */
+bool ini_handle_get_bool(const INIData_t *data, INIHandle_t *handle, bool default_value);
+
+/** @see ini_get_double() */
+double ini_handle_get_double(const INIData_t *data, INIHandle_t *handle, double default_value, int *status);
+
+/** @see ini_get_int64() */
+int64_t ini_handle_get_int64(const INIData_t *data, INIHandle_t *handle, int64_t default_value, int *status);
+
+
+
+/**
+ * Fill the members of a struct from INI data as a schema describes,
+ * in one walk over the data instead of a lookup per key.
+ *
+ * Every entry of the schema is written, with its default if the key
+ * is missing or its value can't be converted. Keys in sections the
+ * schema names but that it doesn't bind are counted as problems;
+ * sections it doesn't name at all are skipped.
+ *
+ *   @param data   Pointer to the INIData_t object to read.
+ *   @param schema Entries binding keys to members of target.
+ *   @param count  The number of entries in schema.
+ *   @param target The struct to fill.
+ *   @param error  Describes the first problem if not NULL, naming
+ *                 the section and key in its line.
+ *
+ * @return The number of missing, unknown or badly converted keys.
+ */
+unsigned ini_bind(const INIData_t *data, const INIBinding_t *schema, unsigned count, void *target, INIError_t *error);
+
+
+
+/**
+ * @brief  Make an immutable copy of a database for lookups only. It's
+ *         a single allocation holding exactly the pairs and strings
+ *         of the database, found through a minimal perfect hash over
+ *         section and key, so every lookup is one hash and one
+ *         comparison. Where a section holds a key more than once,
+ *         only the pair ini_get_value() would find is kept.
+ *
+ *   @param data The INIData_t object to copy. Lazily read sections
+ *               are loaded first. Its allocator is used for the
+ *               copy.
+ *
+ * @return Pointer to the frozen copy that must be free'd later with
+ *         a call to ini_free_frozen(), or NULL if allocation failed
+ *         or the database holds more than 4 GiB of strings.
+ */
+INIFrozen_t *ini_freeze(const INIData_t *data);
+
+
+
+/**
+ * Free a database frozen by ini_freeze() or opened by
+ * ini_open_compiled().
+ *
+ *   @param frozen The frozen database to be free'd.
+ */
+void ini_free_frozen(INIFrozen_t *frozen);
+
+
+
+/**
+ * @brief  Freeze a database and write it to a file as a binary image
+ *         that ini_open_compiled() can use without parsing. The image
+ *         is versioned and checksummed, and only holds offsets, so it
+ *         can be mapped anywhere. It's tied to the byte order of the
+ *         machine that wrote it.
+ *
+ *   @param data The INIData_t object to compile. See ini_freeze().
+ *   @param path The path of the file to write, which is replaced.
+ *
+ * @return True if the image was written, false otherwise.
+ */
+bool ini_compile(const INIData_t *data, const char *path);
+
+
+
+/**
+ * @brief  Open an image written by ini_compile() for lookups with the
+ *         ini_frozen_get_* functions, which then read straight from
+ *         a private mapping of the file where supported. The image is
+ *         checked before use: its version, byte order, size and
+ *         checksum, and that its tables, every displacement and every
+ *         string offset stay inside it, with names and keys ending
+ *         where their lengths say. The checksum only catches damage,
+ *         so values of a deliberately forged image may still be wrong.
+ *
+ *   @param path The path of the compiled image.
+ *
+ * @return Pointer to the frozen database that must be free'd later
+ *         with a call to ini_free_frozen(), or NULL if the file
+ *         couldn't be read or isn't a valid image of this version.
+ */
+INIFrozen_t *ini_open_compiled(const char *path);
+
+
+
+/**
+ * @brief  Compile a database into anonymous shared memory, so that other
+ *         processes can query it without parsing or copying. On Linux
+ *         the memory is a memfd sealed against writes and resizing, on
+ *         other POSIX systems an unlinked shm object. The descriptor is
+ *         meant to be inherited or passed over a UNIX socket and given
+ *         to ini_attach_shared().
+ *
+ *   @param data The INIData_t object to export. See ini_compile().
+ *
+ * @return A file descriptor that must be closed by the caller, or -1 if
+ *         the image couldn't be written or shared memory isn't
+ *         supported.
+ */
+int ini_export_shared(const INIData_t *data);
+
+
+
+/**
+ * @brief  Map a database exported with ini_export_shared() read-only for
+ *         lookups with the ini_frozen_get_* functions. Every process
+ *         attached shares the same pages. Memory that supports sealing
+ *         is rejected unless it is sealed against writes and shrinking.
+ *
+ *   @param fd The file descriptor of the shared memory, which may be
+ *             closed once this returns.
+ *
+ * @return Pointer to the frozen database that must be free'd later
+ *         with a call to ini_free_frozen(), or NULL if the memory
+ *         couldn't be mapped or isn't a valid image of this version.
+ */
+INIFrozen_t *ini_attach_shared(int fd);
+
+
+
+/**
+ * The ini_frozen_get_* functions are equivalent to the ini_get_*
+ * functions, for frozen databases.
+ *
+ *   @param frozen  The frozen database to be searched.
+ *   @param section The section string to search for.
+ *   @param key     The key string to search for.
+ *
+ * @return See ini_get_value().
+ */
+const char *ini_frozen_get_value(const INIFrozen_t *frozen, const char *section, const char *key);
+
+/** @see ini_get_string() */
+const char *ini_frozen_get_string(const INIFrozen_t *frozen, const char *section, const char *key, const char *default_value);
+
+/** @see ini_get_unsigned() */
+unsigned long long ini_frozen_get_unsigned(const INIFrozen_t *frozen, const char *section, const char *key, unsigned long long default_value);
+
+/** @see ini_get_signed() */
+long long ini_frozen_get_signed(const INIFrozen_t *frozen, const char *section, const char *key, long long default_value);
+
+/** @see ini_get_hex() */
+unsigned long long ini_frozen_get_hex(const INIFrozen_t *frozen, const char *section, const char *key, unsigned long long default_value);
+
+/** @see ini_get_float() */
+long double ini_frozen_get_float(const INIFrozen_t *frozen, const char *section, const char *key, long double default_value);
+
+/** @see ini_get_bool() */
+bool ini_frozen_get_bool(const INIFrozen_t *frozen, const char *section, const char *key, bool default_value);
+
+
+
 /**
  * 
  * A helper function that parses a character array and
@@ -575,7 +1789,9 @@ bool ini_is_blank_line(const char *line);
  *					    store name strings. If NULL is provided,
 *                  	    has no effect. If a string is not a valid
 *                  	    section, then the name string is zero-length
-*                  	    and null-terminated.
+*                  	    and null-terminated. With INI_COMPACT_STRINGS
+*                  	    the name points into line instead and is
+*                  	    delimited by name_length.
  *   @param discrepancy A pointer to an integer representing the
  *                      offset of the erroneous character if
  *                      present. If no error found, will be given
@@ -598,7 +1814,9 @@ bool ini_parse_section(const char *line, INISection_t *section, ptrdiff_t *discr
  *                      key and value strings. If NULL is provided,
  *                      has no effect. If a string is not a valid
  *                      pair, then the key and value strings are
- *                      zero-length and null-terminated.
+ *                      zero-length and null-terminated. With
+ *                      INI_COMPACT_STRINGS they point into line
+ *                      instead and are delimited by their lengths.
  *   @param discrepancy A pointer to an integer representing the
  *                  	offset of the erroneous character if
  *                  	present. If no error found, will be given
@@ -665,17 +1883,84 @@ bool ini_parse_value(const char *line, char *dest, unsigned n, ptrdiff_t *discre
  *
  * @return Pointer to INIData_t object that must be free'd later
  *   	   with a call to ini_free_data(). Initial allocations
- *   	   comply with INI_INITIAL_ALLOCATED_PAIRS and
- *   	   INI_INITIAL_ALLOCATED_SECTIONS
+ *   	   comply with INI_INITIAL_ALLOCATED_SECTIONS, and each
+ *   	   section is allocated INI_INITIAL_ALLOCATED_PAIRS pairs
+ *   	   once it gets its first.
  */
 INIData_t *ini_create_data();
 
 
 
+/**
+ * @brief  Create an INIData_t database object like ini_create_data(),
+ *         but take all of its memory from the given allocator
+ *         instead of the one shared by the whole process. The
+ *         allocator doesn't need to be thread-safe: the threads of
+ *         ini_read_buffer_parallel() and ini_read_directory() take
+ *         turns calling it.
+ *
+ *   @param allocator The functions to allocate with, all of which
+ *                    must be set. Copied into the database. If
+ *                    NULL, same as ini_create_data().
+ *
+ * @return Pointer to INIData_t object that must be free'd later
+ *   	   with a call to ini_free_data(), or NULL if allocation
+ *   	   failed.
+ */
+INIData_t *ini_create_data_with(const INIAllocator_t *allocator);
+
+
+
+/**
+ * @brief  Create a heap-allocated INIData_t database object sized
+ *         for its expected contents, so that it isn't grown again
+ *         and again while being filled. Like every heap database,
+ *         a section only gets its pairs allocated once it has one.
+ *
+ *   @param sections          The number of sections to make room
+ *                            for, 0 for INI_INITIAL_ALLOCATED_SECTIONS.
+ *   @param pairs_per_section The number of pairs a section gets room
+ *                            for with its first, 0 for
+ *                            INI_INITIAL_ALLOCATED_PAIRS.
+ *
+ * @return Pointer to INIData_t object that must be free'd later
+ *   	   with a call to ini_free_data(), or NULL if allocation
+ *   	   failed.
+ */
+INIData_t *ini_create_data_reserve(unsigned sections, unsigned pairs_per_section);
+
+
+
+/**
+ * @brief  Create a database sized like ini_create_data_reserve(),
+ *         with its memory from allocator like ini_create_data_with().
+ *
+ * @see ini_create_data_reserve()
+ * @see ini_create_data_with()
+ */
+INIData_t *ini_create_data_reserve_with(const INIAllocator_t *allocator, unsigned sections, unsigned pairs_per_section);
+
+
+
+/**
+ * @brief  Create a heap-allocated INIData_t database object whose
+ *         sections, pairs and strings are all carved out of blocks
+ *         of INI_ARENA_BLOCK_SIZE bytes. Arrays that outgrow their
+ *         space are copied and the old space is not reused until
+ *         the database is freed, which only frees the blocks.
+ *
+ * @return Pointer to INIData_t object that must be free'd later
+ *   	   with a call to ini_free_data(), or NULL if allocation
+ *   	   failed.
+ */
+INIData_t *ini_create_arena_data();
+
+
+
 /**
  * Free the memory resources used by an INIData_t object.
  * This should be called if you have created an INIData_t
- * object with ini_create_data()
+ * object with ini_create_data() or ini_create_arena_data()
  *
  *   @param data The INIData_t object to be free'd.
  */
@@ -686,7 +1971,9 @@ void ini_free_data(INIData_t *data);
 /**
  * Initialize a data object with sections, initialize sections
  * with pairs. Useful for saving some time when working with
- * the stack. See examples.
+ * the stack. See examples. With INI_COMPACT_STRINGS the strings
+ * need a buffer from ini_init_strings(); until given one, adding
+ * a section or pair fails unless reading with INI_BORROW_STRINGS.
  *
  *   @param data         The INIData_t object to be initialized. Its section
  *                       count is set to zero, its section allocations set
@@ -708,4 +1995,76 @@ void ini_init_data(INIData_t* data, INISection_t* sections, INIPair_t** pairs, u
 
 
 
+/**
+ * Initialize a data object like ini_init_data(), but have all
+ * sections take their pairs from one pool as they need them
+ * instead of each getting the same fixed number. The pool only
+ * has to hold as many pairs as there are in total, which
+ * ini_measure_file_path() can count. Each section keeps its
+ * pairs next to each other, so adding a pair to a section
+ * other than the last one to get a pair moves the pairs that
+ * follow it, and pointers to them.
+ *
+ *   @param data         The INIData_t object to be initialized.
+ *   @param sections     The sections given to the data object, of size
+ *                       num_sections.
+ *   @param num_sections The number of sections.
+ *   @param pool         The pairs shared by all sections, of size num_pairs.
+ *   @param num_pairs    The number of pairs in the pool.
+ */
+void ini_init_pooled_data(INIData_t *data, INISection_t *sections, unsigned num_sections, INIPair_t *pool, unsigned num_pairs);
+
+
+
+/**
+ * @brief  Create an INIData_t database object inside a buffer, which
+ *         sections, pairs and strings are then carved out of like
+ *         with ini_create_arena_data(). No heap allocations are made
+ *         for it, reading fails once the buffer is full instead.
+ *
+ *         Sections start with room for a single pair and double it
+ *         as they grow, leaving what they outgrew unused. Setting
+ *         pair_reservation of the database beforehand, e.g. to the
+ *         max_pairs of ini_measure_buffer(), gives each section all
+ *         of its pairs at once instead.
+ *
+ *   @param buffer The memory to keep the database in, aligned for
+ *                 any type. Must outlive the database and not be
+ *                 used for anything else while it does.
+ *   @param size   The size of the buffer in bytes.
+ *
+ * @return Pointer to the INIData_t object at the start of the buffer,
+ *         or NULL if the buffer is too small for it. Doesn't need
+ *         to be free'd.
+ */
+INIData_t *ini_init_arena_data(void *buffer, size_t size);
+
+
+
+// Bytes a buffer for ini_init_strings() takes to hold strings
+// of string_bytes bytes, as counted by ini_measure_file_path()
+#define INI_STRING_BUFFER_SIZE(string_bytes) ((string_bytes) + 64)
+
+/**
+ * @brief  Have a database made by ini_init_data() or
+ *         ini_init_pooled_data() keep its section names, keys and
+ *         values in a buffer. Only needed with INI_COMPACT_STRINGS,
+ *         where such a database otherwise can't store any strings,
+ *         as it never takes them from the heap. Reading fails once
+ *         the buffer is full.
+ *
+ *   @param data   The initialized INIData_t object.
+ *   @param buffer The memory to keep the strings in. Must outlive
+ *                 the database.
+ *   @param size   The size of the buffer in bytes. See
+ *                 INI_STRING_BUFFER_SIZE().
+ *
+ * @return True if the strings are kept in the buffer, or with
+ *         INI_COMPACT_STRINGS undefined, false if the buffer is
+ *         too small or an argument is NULL.
+ */
+bool ini_init_strings(INIData_t *data, void *buffer, size_t size);
+
+
+
 #endif //INI_H
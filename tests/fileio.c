@@ -5,7 +5,16 @@
 
 #include <assert.h>
 #include <math.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 
 
@@ -14,6 +23,18 @@
 static void start_stack_use();
 static void end_stack_use();
 
+// Writes a compiled image back with a corrupted field and the checksum
+// fixed up to match, so only the checks on the tables can catch it
+static void write_resealed_image(const char *path, const char *image, size_t length, size_t offset, uint32_t field);
+
+
+
+// Gives the heap back even when a stack test fails before it does
+TEST_TEARDOWN(ini_tests)
+{
+    end_stack_use();
+}
+
 
 
 TEST(ini_tests, file_parsing)
@@ -198,161 +219,1476 @@ TEST(ini_tests, file_parsing_past_error)
 
 
 
-TEST(ini_tests, file_writing)
+TEST(ini_tests, buffer_parsing_past_broken_header)
 {
-    const char contents[] = "[section]\n"
+    const char contents[] = "[Section1]\n"
                             "hello=world\n"
-                            "hi=true\n"
-                            "val=5\n"
-                            "this: is a string"
-                            "this_one=\"is a string with   consecutive spaces\"\n";
+                            "[Section2\n"
+                            "stray=pair\n"
+                            "[Section3]\n"
+                            "integer=5\n";
+
+    // Pairs under the broken header don't end up in Section1
+    for (int lazy = 0; lazy < 2; lazy++)
+    {
+        INIData_t *data = ini_create_data();
+        const uint64_t flags = INI_CONTINUE_PAST_ERROR | (lazy ? INI_LAZY_SECTIONS : 0);
+        ASSERT_TRUE(ini_read_buffer(contents, sizeof(contents) - 1, data, NULL, flags) != NULL);
+        ASSERT_EQ(data->section_count, 2);
+        ASSERT_STREQ(ini_get_string(data, "Section1", "hello", ""), "world");
+        ASSERT_TRUE(ini_get_value(data, "Section1", "stray") == NULL);
+        ASSERT_EQ(ini_get_signed(data, "Section3", "integer", 0), 5);
+        ini_free_data(data);
+    }
+
+    INIMeasure_t measure;
+    ASSERT_TRUE(ini_measure_buffer(contents, sizeof(contents) - 1, &measure, NULL, INI_CONTINUE_PAST_ERROR));
+    ASSERT_EQ(measure.sections, 2);
+    ASSERT_EQ(measure.total_pairs, 2);
+}
 
-    FILE *input_file = tmpfile();
-    assert(input_file);
-    fputs(contents, input_file);
-    rewind(input_file);
 
+
+TEST(ini_tests, file_parsing_duplicate_keys_overwrite_in_place)
+{
+    const char contents[] = "[Section]\n"
+                            "key=first\n"
+                            "other=value\n"
+                            "key=second\n";
+
+    FILE *file = tmpfile();
+    assert(file);
+    fputs(contents, file);
+    rewind(file);
     INIData_t *data = ini_create_data();
-    ini_read_file(input_file, data, NULL, 0);
+    ASSERT_TRUE(ini_read_file(file, data, NULL, INI_DUPLICATE_KEYS_OVERWRITE) != NULL);
+    fclose(file);
 
-    FILE *output_file = tmpfile();
-    ini_write_file(output_file, data);
-    rewind(output_file);
+    // The first pair takes the value, no second one is added
+    const INISection_t *section = ini_has_section(data, "Section");
+    ASSERT_EQ(section->pair_count, 2);
+    ASSERT_STREQ(ini_get_string(data, "Section", "key", ""), "second");
+    ini_free_data(data);
+}
 
-    INIData_t *copy = ini_create_data();
-    ini_read_file(output_file, copy, NULL, 0);
-    ASSERT_TRUE(copy != NULL);
-    ASSERT_TRUE(copy->sections != NULL);
-    ASSERT_EQ(data->section_count, copy->section_count);
 
-    for (unsigned i = 0; i < data->section_count; i++)
-    {
-        const INISection_t *section = &data->sections[i];
-        for (unsigned j = 0; j < section->pair_count; j++)
-        {
-            const char *key = section->pairs[j].key;
-            const char *value = section->pairs[j].value;
 
-            ASSERT_STREQ(value, ini_get_value(copy, section->name, key));
+TEST(ini_tests, file_parsing_past_duplicate_key)
+{
+    const char contents[] = "[Section]\n"
+                            "key=first\n"
+                            "key=second\n"
+                            "other=value\n";
 
-        }
-    }
+    FILE *file = tmpfile();
+    assert(file);
+    fputs(contents, file);
+    rewind(file);
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_file(file, data, NULL, INI_CONTINUE_PAST_ERROR) != NULL);
+    fclose(file);
 
+    // The duplicate is skipped like any other line in error
+    ASSERT_EQ(ini_has_section(data, "Section")->pair_count, 2);
+    ASSERT_STREQ(ini_get_string(data, "Section", "key", ""), "first");
+    ASSERT_STREQ(ini_get_string(data, "Section", "other", ""), "value");
     ini_free_data(data);
-    ini_free_data(copy);
-    fclose(input_file);
-    fclose(output_file);
 }
 
 
 
-TEST(ini_tests, stack)
+TEST(ini_tests, file_parsing_past_unadded_section)
 {
     start_stack_use();
 
     const char contents[] = "[Section]\n"
                             "key=value\n"
-                            "other_key=other_value\n"
-                            "[OtherSection]\n"
-                            "final_key=final_value\n";
+                            "[Unadded]\n"
+                            "stray=pair\n"
+                            "[Broken\n"
+                            "another=stray\n";
+
     FILE *file = tmpfile();
+    assert(file);
     fputs(contents, file);
     rewind(file);
 
-    const int max_sections = 32;
-    const int max_pairs = 32;
-
-    INISection_t sections[max_sections];
-    INIPair_t pairs[max_sections][max_pairs];
-    INIPair_t *row_ptrs[max_sections];
-    for (int i = 0; i < max_sections; i++)
-        row_ptrs[i] = pairs[i];
+    INISection_t sections[1];
+    INIPair_t pairs[1][4];
+    INIPair_t *rows[1] = { pairs[0] };
     INIData_t ini;
-    ini_init_data(&ini, sections, row_ptrs, max_sections, max_pairs);
+    ini_init_data(&ini, sections, rows, 1, 4);
+    char strings[INI_STRING_BUFFER_SIZE(64)];
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
 
-    ASSERT_TRUE(ini_read_file(file, &ini, NULL, 0) != NULL);
+    // Neither the section that doesn't fit nor the broken one fail the
+    // read, and their pairs don't end up in the section before them
+    ASSERT_TRUE(ini_read_file(file, &ini, NULL, INI_CONTINUE_PAST_ERROR) != NULL);
     fclose(file);
-
-    ASSERT_STREQ(ini_get_string(&ini, "Section", "key", ""), "value");
-    ASSERT_STREQ(ini_get_string(&ini, "Section", "other_key", ""), "other_value");
-    ASSERT_STREQ(ini_get_string(&ini, "OtherSection", "final_key", ""), "final_value");
+    ASSERT_EQ(ini.section_count, 1);
+    ASSERT_EQ(ini.sections[0].pair_count, 1);
+    ASSERT_TRUE(ini_get_value(&ini, "Section", "stray") == NULL);
+    ASSERT_TRUE(ini_get_value(&ini, "Section", "another") == NULL);
 
     end_stack_use();
 }
 
 
 
-TEST(ini_tests, stack_insufficient_pair_allocation)
+TEST(ini_tests, buffer_parsing)
 {
-    start_stack_use();
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n"
+                            "[Section2]\n"
+                            "boolean=true\n"
+                            "integer=5\n"
+                            "string=\"is a string\"\n"
+                            "float=1.0";
 
-    const char contents[] = "[Section]\n"
-                            "key=value\n"
-                            "other_key=other_value\n";
-    FILE *file = tmpfile();
-    fputs(contents, file);
-    rewind(file);
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer(contents, sizeof(contents) - 1, data, NULL, 0) != NULL);
+    ASSERT_STREQ(ini_get_value(data, "Section1", "hello"), "world");
+    ASSERT_TRUE(ini_get_bool(data, "Section2", "boolean", false));
+    ASSERT_EQ(ini_get_signed(data, "Section2", "integer", 0), 5);
+    ASSERT_STREQ(ini_get_string(data, "Section2", "string", ""), "is a string");
+    ASSERT_EQ(ini_get_float(data, "Section2", "float", INFINITY), 1.0f);
+    ini_free_data(data);
+}
 
-    const int max_sections = 8;
-    const int max_pairs = 1;
 
-    INISection_t sections[max_sections];
-    INIPair_t pairs[max_sections][max_pairs];
-    INIPair_t *row_ptrs[max_sections];
-    for (int i = 0; i < max_sections; i++)
-        row_ptrs[i] = pairs[i];
-    INIData_t ini;
-    ini_init_data(&ini, sections, row_ptrs, max_sections, max_pairs);
 
-    ASSERT_TRUE(ini_read_file(file, &ini, NULL, 0) == NULL);
-    fclose(file);
+TEST(ini_tests, buffer_parsing_erroneous_pair)
+{
+    const char contents[] = "[Section1]\n"
+                            "erroneous line\n"
+                            "[Section2]\n";
 
-    end_stack_use();
+    INIData_t *data = ini_create_data();
+    INIError_t error;
+    ASSERT_TRUE(ini_read_buffer(contents, sizeof(contents) - 1, data, &error, 0) == NULL);
+    ASSERT_TRUE(error.encountered);
+    ASSERT_STREQ(error.line, "erroneous line\n");
+    ASSERT_EQ(error.offset, 10);
+    ini_free_data(data);
 }
 
 
 
-TEST(ini_tests, stack_insufficient_section_allocation)
+// Values are scanned 32, 16 and then 1 byte at a time, so every stop
+// character is tried at every position of values around those sizes
+TEST(ini_tests, value_scanning_boundaries)
 {
-    start_stack_use();
+    static const unsigned lengths[] = { 15, 16, 17, 31, 32, 33 };
+    static const char stops[] = { '[', ']', ';', '#', '"', '\x01', '\x7f', (char)0x80, (char)0xff };
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(*lengths); l++)
+    for (size_t s = 0; s < sizeof(stops) / sizeof(*stops); s++)
+    for (unsigned p = 0; p < lengths[l]; p++)
+    {
+        char line[64] = "k=";
+        memset(line + 2, 'a', lengths[l]);
+        line[2 + p] = stops[s];
+
+        char value[64];
+        ptrdiff_t offset = -1;
+        const bool parsed = ini_parse_value(line, value, sizeof(value), &offset);
+
+        // Bytes from 0x80 up are part of values, comments end them,
+        // and anything else stopping the scan is an error right there
+        if ((unsigned char)stops[s] >= 0x80)
+        {
+            ASSERT_TRUE(parsed);
+            ASSERT_STREQ(value, line + 2);
+        }
+        else if (stops[s] == ';' || stops[s] == '#')
+        {
+            ASSERT_TRUE(parsed);
+            ASSERT_EQ(strlen(value), p);
+            ASSERT_EQ(strncmp(value, line + 2, p), 0);
+        }
+        else
+        {
+            ASSERT_FALSE(parsed);
+            if (stops[s] != '"' || p) ASSERT_EQ(offset, 2 + p);
+        }
+    }
+}
+
+
+
+// Single spaces never stop the vector scanners, so the second of two is
+// found inside a block and across the edge of one
+TEST(ini_tests, value_scanning_spaces)
+{
+    static const unsigned lengths[] = { 15, 16, 17, 31, 32, 33, 47, 48, 49, 63, 64, 65 };
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(*lengths); l++)
+    for (unsigned p = 1; p + 1 < lengths[l]; p++)
+    {
+        char line[96] = "k=";
+        memset(line + 2, 'a', lengths[l]);
+        char value[96];
+        ptrdiff_t offset = -1;
+
+        line[2 + p] = ' ';
+        ASSERT_TRUE(ini_parse_value(line, value, sizeof(value), &offset));
+        ASSERT_STREQ(value, line + 2);
+
+        // Doubled, it ends the value and anything left is an error
+        line[3 + p] = ' ';
+        const bool parsed = ini_parse_value(line, value, sizeof(value), &offset);
+        if (p + 2 == lengths[l])
+        {
+            ASSERT_TRUE(parsed);
+            ASSERT_EQ(strlen(value), p);
+        }
+        else
+        {
+            ASSERT_FALSE(parsed);
+            ASSERT_EQ(offset, 4 + p);
+        }
+
+        // Unless it's quoted
+        char quoted[96];
+        snprintf(quoted, sizeof(quoted), "k=\"%s\"", line + 2);
+        ASSERT_TRUE(ini_parse_value(quoted, value, sizeof(value), &offset));
+        ASSERT_STREQ(value, line + 2);
+    }
+}
+
+
+
+TEST(ini_tests, key_scanning_boundaries)
+{
+    static const unsigned lengths[] = { 15, 16, 17, 31, 32, 33 };
+    static const char stops[] = { '-', '/', ':', '@', '[', '`', '{', ' ', (char)0x80, (char)0xdf };
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(*lengths); l++)
+    for (size_t s = 0; s < sizeof(stops) / sizeof(*stops); s++)
+    for (unsigned p = 1; p < lengths[l]; p++)
+    {
+        // Every kind of key character shows up in every position too
+        char line[64];
+        for (unsigned i = 0; i < lengths[l]; i++)
+            line[i] = "azAZ09_"[(i + p) % 7];
+        line[0] = 'k';
+        line[p] = stops[s];
+        strcpy(line + lengths[l], "=v");
+
+        char key[64];
+        ptrdiff_t offset = -1;
+        const bool parsed = ini_parse_key(line, key, sizeof(key), &offset);
+        if (stops[s] == ':' || (stops[s] == ' ' && p + 1 == lengths[l]))
+        {
+            ASSERT_TRUE(parsed);
+            ASSERT_EQ(strlen(key), p);
+        }
+        else
+        {
+            ASSERT_FALSE(parsed);
+            if (stops[s] != ' ') ASSERT_EQ(offset, p);
+        }
+    }
+}
+
+
+
+// Lines are split 64 bytes at a time, so newlines fall on every position of
+// a block, blocks hold several lines or none, and the last has none. A
+// comment of every length in front shifts all of them through the block.
+TEST(ini_tests, buffer_parsing_line_boundaries)
+{
+    char contents[16384];
+    for (unsigned shift = 0; shift < 64; shift++)
+    {
+        size_t length = (size_t)snprintf(contents, sizeof(contents), "[Section]\n;");
+        memset(contents + length, 'c', shift);
+        length += shift;
+        contents[length++] = '\n';
+        for (unsigned i = 0; i < 150; i++)
+        {
+            length += (size_t)snprintf(contents + length, sizeof(contents) - length, "k%u=", i);
+            memset(contents + length, 'v', i);
+            length += i;
+            contents[length++] = '\n';
+            if (i % 7 == 0) contents[length++] = '\n';
+        }
+        length += (size_t)snprintf(contents + length, sizeof(contents) - length, "last=%s", "value");
+
+        INIData_t *data = ini_read_buffer(contents, length, ini_create_data(), NULL, 0);
+        ASSERT_TRUE(data != NULL);
+        ASSERT_EQ(data->sections[0].pair_count, 151);
+        char key[16];
+        for (unsigned i = 0; i < 150; i++)
+        {
+            snprintf(key, sizeof(key), "k%u", i);
+            ASSERT_EQ(ini_get_view(data, "Section", key).length, i);
+        }
+        ASSERT_STREQ(ini_get_string(data, "Section", "last", NULL), "value");
+        ini_free_data(data);
+    }
+}
+
 
+
+TEST(ini_tests, buffer_parsing_duplicate_keys_overwrite)
+{
     const char contents[] = "[Section]\n"
-                            "key=value\n"
-                            "[OtherSection]\n"
-                            "other_key=other_value\n";
+                            "key=first\n"
+                            "key=second\n";
+
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer(contents, sizeof(contents) - 1, data, NULL, INI_DUPLICATE_KEYS_OVERWRITE) != NULL);
+    ASSERT_EQ(ini_has_section(data, "Section")->pair_count, 1);
+    ASSERT_STREQ(ini_get_string(data, "Section", "key", ""), "second");
+    ini_free_data(data);
+}
+
+
+
+#ifdef INI_COMPACT_STRINGS
+TEST(ini_tests, buffer_parsing_borrowed_strings)
+{
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n"
+                            "spaced=\"two  spaces\"\n"
+                            "[Section2]\n"
+                            "integer=5\n"
+                            "boolean=true";
+    const char *end = contents + sizeof(contents) - 1;
+#define IN_CONTENTS(str) ((str) >= contents && (str) < end)
+
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer(contents, sizeof(contents) - 1, data, NULL, INI_BORROW_STRINGS) != NULL);
+    ASSERT_TRUE(IN_CONTENTS(data->sections[0].name));
+    ASSERT_EQ(data->sections[0].name_length, 8);
+
+    const INIPair_t *pair = &data->sections[0].pairs[0];
+    ASSERT_TRUE(IN_CONTENTS(pair->key) && IN_CONTENTS(pair->value));
+    ASSERT_EQ(pair->value_length, 5);
+
+    // Values are only handed out as views, which carry their length
+    const INIView_t hello = ini_get_view(data, "Section1", "hello");
+    ASSERT_TRUE(hello.data == pair->value && hello.length == 5);
+    ASSERT_TRUE(ini_get_value(data, "Section1", "hello") == NULL);
+    ASSERT_STREQ(ini_get_string(data, "Section1", "hello", "none"), "none");
+
+    typedef struct
+    {
+        const char *hello;
+        INIView_t spaced;
+    } Bound;
+    static const INIBinding_t schema[] =
+    {
+        { "Section1", "hello",  INI_BIND_STRING, offsetof(Bound, hello),  { .str = "none" } },
+        { "Section1", "spaced", INI_BIND_VIEW,   offsetof(Bound, spaced), { .str = NULL } },
+    };
+    Bound bound;
+    INIError_t error;
+    ASSERT_EQ(ini_bind(data, schema, 2, &bound, &error), 1);
+    ASSERT_STREQ(bound.hello, "none");
+    ASSERT_STREQ(error.msg, "Value isn't null-terminated");
+    ASSERT_TRUE(bound.spaced.length == 11 && memcmp(bound.spaced.data, "two  spaces", 11) == 0);
+
+    // Typed getters don't need the values null-terminated, even the last
+    ASSERT_EQ(ini_get_signed(data, "Section2", "integer", 0), 5);
+    ASSERT_TRUE(ini_get_bool(data, "Section2", "boolean", false));
+
+    // Copies made of the database are null-terminated again
+    INIFrozen_t *frozen = ini_freeze(data);
+    ASSERT_TRUE(frozen != NULL);
+    ASSERT_STREQ(ini_frozen_get_value(frozen, "Section1", "hello"), "world");
+    ASSERT_STREQ(ini_frozen_get_value(frozen, "Section1", "spaced"), "two  spaces");
+    ini_free_frozen(frozen);
+
+    char written[256] = { 0 };
     FILE *file = tmpfile();
-    fputs(contents, file);
+    assert(file);
+    ini_write_file(file, data);
     rewind(file);
+    ASSERT_EQ(fread(written, 1, sizeof(written) - 1, file), 78);
+    fclose(file);
+    ASSERT_STREQ(written, "[Section1]\nhello=world\nspaced=\"two  spaces\"\n[Section2]\ninteger=5\nboolean=true\n");
+    ini_free_data(data);
 
-    const int max_sections = 1;
-    const int max_pairs = 2;
+    // Split across threads too
+    data = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer_parallel(contents, sizeof(contents) - 1, 2, data, NULL, INI_BORROW_STRINGS) != NULL);
+    ASSERT_EQ(data->section_count, 2);
+    ASSERT_TRUE(IN_CONTENTS(data->sections[1].name));
+    ASSERT_EQ(ini_get_unsigned(data, "Section2", "integer", 0), 5);
+    ini_free_data(data);
 
-    INISection_t sections[max_sections];
-    INIPair_t pairs[max_sections][max_pairs];
-    INIPair_t *row_ptrs[max_sections];
-    for (int i = 0; i < max_sections; i++)
-        row_ptrs[i] = pairs[i];
+    // A database on the stack then needs no space for strings at all
+    start_stack_use();
+    INISection_t sections[2];
+    INIPair_t pool[4];
     INIData_t ini;
-    ini_init_data(&ini, sections, row_ptrs, max_sections, max_pairs);
+    ini_init_pooled_data(&ini, sections, 2, pool, 4);
+    ASSERT_TRUE(ini_read_buffer(contents, sizeof(contents) - 1, &ini, NULL, INI_BORROW_STRINGS) != NULL);
+    ASSERT_EQ(ini_get_signed(&ini, "Section2", "integer", 0), 5);
+    end_stack_use();
+#undef IN_CONTENTS
+}
+#endif
 
-    ASSERT_TRUE(ini_read_file(file, &ini, NULL, 0) == NULL);
+
+
+TEST(ini_tests, file_mapping)
+{
+    const char path[] = "ini_file_mapping_test.ini";
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n"
+                            "[Section2]\n"
+                            "integer=5\n"
+                            "float=1.0";
+
+    FILE *file = fopen(path, "w");
+    assert(file);
+    fputs(contents, file);
     fclose(file);
 
-    end_stack_use();
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_map_file_path(path, data, NULL, 0) != NULL);
+    remove(path);
+    ASSERT_STREQ(ini_get_value(data, "Section1", "hello"), "world");
+    ASSERT_EQ(ini_get_signed(data, "Section2", "integer", 0), 5);
+    ASSERT_EQ(ini_get_float(data, "Section2", "float", INFINITY), 1.0f);
+    ini_free_data(data);
 }
 
 
 
-static void end_stack_use()
+#if defined(__unix__) || defined(__APPLE__)
+TEST(ini_tests, file_mapping_pipe)
 {
-    ini_set_allocator(malloc);
-    ini_set_free(free);
-    ini_set_reallocator(realloc);
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n";
+
+    // A pipe has no size to map, but is read all the same
+    int fds[2];
+    assert(pipe(fds) == 0);
+    assert(write(fds[1], contents, sizeof(contents) - 1) == (ssize_t)(sizeof(contents) - 1));
+    close(fds[1]);
+
+    char path[32];
+    snprintf(path, sizeof(path), "/dev/fd/%d", fds[0]);
+    INIData_t *data = ini_create_data();
+    INIError_t error;
+    ASSERT_TRUE(ini_map_file_path(path, data, &error, 0) != NULL);
+    close(fds[0]);
+    ASSERT_FALSE(error.encountered);
+    ASSERT_EQ(data->section_count, 1);
+    ASSERT_STREQ(ini_get_value(data, "Section1", "hello"), "world");
+    ini_free_data(data);
 }
+#endif
 
 
 
-static void start_stack_use()
+#ifdef INI_COMPACT_STRINGS
+TEST(ini_tests, file_mapping_borrowed_strings)
 {
-    ini_disable_heap();
-}
\ No newline at end of file
+    const char path[] = "ini_file_borrow_test.ini";
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n"
+                            "[Section2]\n"
+                            "integer=5";
+
+    FILE *file = fopen(path, "w");
+    assert(file);
+    fputs(contents, file);
+    fclose(file);
+
+    // The mapping, or the copy read through stdio, outlives the file
+    for (int mapped = 0; mapped < 2; mapped++)
+    {
+        INIData_t *data = ini_create_data();
+        if (mapped) ASSERT_TRUE(ini_map_file_path(path, data, NULL, INI_BORROW_STRINGS) != NULL);
+        else ASSERT_TRUE(ini_read_file_path(path, data, NULL, INI_BORROW_STRINGS) != NULL);
+        ASSERT_TRUE(data->sources != NULL);
+        ASSERT_TRUE(data->blocks == NULL);
+        ASSERT_TRUE(memcmp(ini_get_view(data, "Section1", "hello").data, "world", 5) == 0);
+        ASSERT_EQ(ini_get_signed(data, "Section2", "integer", 0), 5);
+        ini_free_data(data);
+    }
+    remove(path);
+}
+#endif
+
+
+
+TEST(ini_tests, compiled_image)
+{
+    const char path[] = "ini_compiled_image_test.bin";
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n"
+                            "[Section2]\n"
+                            "integer=5\n"
+                            "float=1.0";
+
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, 0) != NULL);
+    ASSERT_TRUE(ini_compile(data, path));
+    ini_free_data(data);
+
+    INIFrozen_t *frozen = ini_open_compiled(path);
+    ASSERT_TRUE(frozen != NULL);
+    ASSERT_STREQ(ini_frozen_get_value(frozen, "Section1", "hello"), "world");
+    ASSERT_EQ(ini_frozen_get_signed(frozen, "Section2", "integer", 0), 5);
+    ASSERT_EQ(ini_frozen_get_float(frozen, "Section2", "float", INFINITY), 1.0f);
+    ASSERT_TRUE(ini_frozen_get_value(frozen, "Section1", "integer") == NULL);
+    ini_free_frozen(frozen);
+
+    // Any change to the contents is caught by the checksum
+    FILE *file = fopen(path, "r+b");
+    assert(file);
+    fseek(file, -2, SEEK_END);
+    fputc('X', file);
+    fclose(file);
+    ASSERT_TRUE(ini_open_compiled(path) == NULL);
+    remove(path);
+
+    ASSERT_TRUE(ini_open_compiled(path) == NULL);
+}
+
+
+
+TEST(ini_tests, compiled_image_bounds)
+{
+    const char path[] = "ini_compiled_bounds_test.bin";
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n"
+                            "[Section2]\n"
+                            "integer=5\n";
+
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, 0) != NULL);
+    ASSERT_TRUE(ini_compile(data, path));
+    ini_free_data(data);
+
+    char image[1024];
+    FILE *file = fopen(path, "rb");
+    assert(file);
+    const size_t length = fread(image, 1, sizeof(image), file);
+    fclose(file);
+    ASSERT_TRUE(length < sizeof(image));
+
+    // The header holds the offsets of the pairs and strings as 64-bit
+    // fields after the magic, byte order, version, count and seed
+    uint64_t pairs, strings;
+    memcpy(&pairs, image + 32, sizeof(pairs));
+    memcpy(&strings, image + 40, sizeof(strings));
+    const uint32_t strings_size = (uint32_t)(length - strings);
+
+    // Resealed untouched, the image still opens
+    uint32_t value;
+    memcpy(&value, image + pairs + 16, sizeof(value));
+    write_resealed_image(path, image, length, pairs + 16, value);
+    INIFrozen_t *frozen = ini_open_compiled(path);
+    ASSERT_TRUE(frozen != NULL);
+    ASSERT_STREQ(ini_frozen_get_value(frozen, "Section1", "hello"), "world");
+    ini_free_frozen(frozen);
+
+    // Value, section and key past the strings, a string missing its
+    // terminator, and a slot past the pairs
+    write_resealed_image(path, image, length, pairs + 16, strings_size);
+    ASSERT_TRUE(ini_open_compiled(path) == NULL);
+    write_resealed_image(path, image, length, pairs, strings_size - 1);
+    ASSERT_TRUE(ini_open_compiled(path) == NULL);
+    write_resealed_image(path, image, length, pairs + 8, UINT32_MAX);
+    ASSERT_TRUE(ini_open_compiled(path) == NULL);
+    write_resealed_image(path, image, length, pairs + 12, 1);
+    ASSERT_TRUE(ini_open_compiled(path) == NULL);
+    write_resealed_image(path, image, length, 64, (uint32_t)-3);
+    ASSERT_TRUE(ini_open_compiled(path) == NULL);
+    remove(path);
+}
+
+
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(ini_tests, shared_memory)
+{
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n"
+                            "[Section2]\n"
+                            "integer=5\n";
+
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, 0) != NULL);
+    const int fd = ini_export_shared(data);
+    ini_free_data(data);
+    ASSERT_TRUE(fd >= 0);
+
+    INIFrozen_t *first = ini_attach_shared(fd);
+    INIFrozen_t *second = ini_attach_shared(fd);
+    ASSERT_TRUE(first != NULL && second != NULL);
+    ASSERT_STREQ(ini_frozen_get_value(first, "Section1", "hello"), "world");
+    ASSERT_EQ(ini_frozen_get_signed(second, "Section2", "integer", 0), 5);
+    ASSERT_TRUE(ini_frozen_get_value(second, "Section1", "integer") == NULL);
+    ini_free_frozen(first);
+    ini_free_frozen(second);
+
+#ifdef __linux__
+    // The memory is sealed, so it can't be changed once exported
+    ASSERT_TRUE(pwrite(fd, "X", 1, 0) == -1);
+    ASSERT_TRUE(ftruncate(fd, 0) == -1);
+#endif
+    close(fd);
+
+    ASSERT_TRUE(ini_attach_shared(-1) == NULL);
+}
+#endif
+
+
+
+TEST(ini_tests, buffer_parsing_lazy_sections)
+{
+    const char contents[] = "[Section1]\n"
+                            "hello=world\n"
+                            "bad pair\n"
+                            "[Section2]\n"
+                            "integer=5\n"
+                            "[Section1]\n"
+                            "hello=again\n";
+
+    INIData_t *data = ini_create_data();
+    const uint64_t flags = INI_LAZY_SECTIONS | INI_ALLOW_DUPLICATE_SECTIONS | INI_DUPLICATE_KEYS_OVERWRITE;
+    ASSERT_TRUE(ini_read_buffer(contents, sizeof(contents) - 1, data, NULL, flags) != NULL);
+    ASSERT_EQ(data->section_count, 2);
+    ASSERT_STREQ(ini_get_value(data, "Section1", "hello"), "again");
+
+    // Untouched until looked up
+    ASSERT_EQ(data->sections[1].pair_count, 0);
+    ASSERT_TRUE(data->sections[1].body != NULL);
+    ASSERT_EQ(ini_get_signed(data, "Section2", "integer", 0), 5);
+    ASSERT_EQ(data->sections[1].pair_count, 1);
+    ASSERT_TRUE(data->sections[1].body == NULL);
+    ini_free_data(data);
+
+    // Broken headers are still reported up front
+    INIError_t error;
+    data = ini_create_data();
+    const char broken[] = "[Section1]\nkey=value\n[Section 2\n";
+    ASSERT_TRUE(ini_read_buffer(broken, sizeof(broken) - 1, data, &error, INI_LAZY_SECTIONS) == NULL);
+    ASSERT_TRUE(error.encountered);
+    ASSERT_STREQ(error.line, "[Section 2\n");
+    ini_free_data(data);
+}
+
+
+
+TEST(ini_tests, file_reading_lazy_sections)
+{
+    const char path[] = "ini_file_lazy_test.ini";
+    FILE *file = fopen(path, "w");
+    assert(file);
+    for (int i = 0; i < 256; i++)
+        fprintf(file, "[Section%d]\nindex=%d\n", i, i);
+    fclose(file);
+
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_file_path(path, data, NULL, INI_LAZY_SECTIONS) != NULL);
+    ASSERT_EQ(data->section_count, 256);
+    ASSERT_EQ(ini_get_unsigned(data, "Section200", "index", 0), 200);
+    ini_free_data(data);
+
+    data = ini_create_data();
+    ASSERT_TRUE(ini_map_file_path(path, data, NULL, INI_LAZY_SECTIONS) != NULL);
+    remove(path);
+    ASSERT_EQ(data->section_count, 256);
+    ASSERT_EQ(ini_get_unsigned(data, "Section255", "index", 0), 255);
+    ASSERT_EQ(data->sections[0].pair_count, 0);
+    ini_free_data(data);
+}
+
+
+
+#if defined(__unix__) || defined(__APPLE__)
+static void write_test_file(const char *path, const char *contents)
+{
+    FILE *file = fopen(path, "w");
+    assert(file);
+    fputs(contents, file);
+    fclose(file);
+}
+
+
+
+TEST(ini_tests, directory_reading)
+{
+    const char *dir = "ini_directory_test";
+    mkdir(dir, 0700);
+    write_test_file("ini_directory_test/20-override.ini", "[Server]\nport=9090\n[Logging]\nlevel=debug\n");
+    write_test_file("ini_directory_test/10-base.ini", "[Server]\nport=8080\nhost=localhost\n");
+    write_test_file("ini_directory_test/.hidden.ini", "[Hidden]\nkey=value\n");
+    write_test_file("ini_directory_test/notes.txt", "not an ini file");
+
+    INIData_t *data = ini_create_data();
+    const uint64_t flags = INI_ALLOW_DUPLICATE_SECTIONS | INI_DUPLICATE_KEYS_OVERWRITE;
+    ASSERT_TRUE(ini_read_directory(dir, "*.ini", 4, data, NULL, flags) != NULL);
+    ASSERT_EQ(data->section_count, 2);
+    ASSERT_STREQ(data->sections[0].name, "Server");
+    ASSERT_EQ(ini_get_unsigned(data, "Server", "port", 0), 9090);
+    ASSERT_STREQ(ini_get_string(data, "Server", "host", ""), "localhost");
+    ASSERT_STREQ(ini_get_string(data, "Logging", "level", ""), "debug");
+    ASSERT_TRUE(ini_has_section(data, "Hidden") == NULL);
+    ini_free_data(data);
+
+    // Without the flags the second file is an error, as if read in turn
+    INIError_t error;
+    data = ini_create_data();
+    ASSERT_TRUE(ini_read_directory(dir, "*.ini", 4, data, &error, 0) == NULL);
+    ASSERT_TRUE(error.encountered);
+    ASSERT_STREQ(error.line, "[Server]\n");
+    ini_free_data(data);
+
+    data = ini_create_data();
+    ASSERT_TRUE(ini_read_directory("ini_directory_test_missing", NULL, 4, data, &error, 0) == NULL);
+    ASSERT_TRUE(error.encountered);
+    ini_free_data(data);
+
+    remove("ini_directory_test/20-override.ini");
+    remove("ini_directory_test/10-base.ini");
+    remove("ini_directory_test/.hidden.ini");
+    remove("ini_directory_test/notes.txt");
+    rmdir(dir);
+}
+#endif
+
+
+
+TEST(ini_tests, buffer_parsing_parallel)
+{
+    char contents[64 * 1024];
+    size_t length = 0;
+    for (int i = 0; i < 512; i++)
+        length += (size_t)snprintf(contents + length, sizeof(contents) - length,
+                                   "[Section%d]\nindex=%d\nname = section %d\n", i, i, i);
+
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer_parallel(contents, length, 4, data, NULL, 0) != NULL);
+    ASSERT_EQ(data->section_count, 512);
+    for (unsigned i = 0; i < data->section_count; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "Section%u", i);
+        ASSERT_STREQ(data->sections[i].name, name);
+        ASSERT_EQ(ini_get_unsigned(data, name, "index", 0), i);
+    }
+    ini_free_data(data);
+}
+
+
+
+TEST(ini_tests, buffer_parsing_parallel_duplicates)
+{
+    const char contents[] = "[Section1]\n"
+                            "key=first\n"
+                            "[Section2]\n"
+                            "key=value\n"
+                            "[Section1]\n"
+                            "key=second\n"
+                            "other=value\n";
+
+    INIData_t *data = ini_create_data();
+    const uint64_t flags = INI_ALLOW_DUPLICATE_SECTIONS | INI_DUPLICATE_KEYS_OVERWRITE;
+    ASSERT_TRUE(ini_read_buffer_parallel(contents, sizeof(contents) - 1, 3, data, NULL, flags) != NULL);
+    ASSERT_EQ(data->section_count, 2);
+    ASSERT_STREQ(ini_get_string(data, "Section1", "key", ""), "second");
+    ASSERT_STREQ(ini_get_string(data, "Section1", "other", ""), "value");
+    ini_free_data(data);
+
+    data = ini_create_data();
+    INIError_t error;
+    ASSERT_TRUE(ini_read_buffer_parallel(contents, sizeof(contents) - 1, 3, data, &error, INI_ALLOW_DUPLICATE_SECTIONS) == NULL);
+    ASSERT_TRUE(error.encountered);
+    ASSERT_STREQ(error.line, "key=second\n");
+    ini_free_data(data);
+}
+
+
+
+// Returns the seconds spent reading contents into a fresh indexed
+// database on nthreads threads
+static double time_indexed_read(const char *contents, size_t length, unsigned nthreads)
+{
+    INIData_t *data = ini_create_data();
+    ini_enable_index(data);
+
+    struct timespec start, end;
+    timespec_get(&start, TIME_UTC);
+    INIData_t *result = nthreads > 1 ? ini_read_buffer_parallel(contents, length, nthreads, data, NULL, 0)
+                                     : ini_read_buffer(contents, length, data, NULL, 0);
+    timespec_get(&end, TIME_UTC);
+
+    assert(result == data && data->section_count == 40000);
+    ini_free_data(data);
+    return (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+
+
+TEST(ini_tests, buffer_parsing_parallel_indexed)
+{
+    // Chunks checking their sections one by one take seconds here, ten
+    // times and more what one indexed pass does
+    const size_t size = 40000 * 32;
+    char *contents = malloc(size);
+    size_t length = 0;
+    for (unsigned i = 0; i < 40000; i++)
+        length += (size_t)snprintf(contents + length, size - length, "[Section%u]\nkey=%u\n", i, i);
+
+    const double sequential = time_indexed_read(contents, length, 1);
+    const double parallel = time_indexed_read(contents, length, 2);
+    ASSERT_TRUE(parallel < sequential * 4 + 0.05);
+    free(contents);
+}
+
+
+
+TEST(ini_tests, file_writing)
+{
+    const char contents[] = "[section]\n"
+                            "hello=world\n"
+                            "hi=true\n"
+                            "val=5\n"
+                            "this: is a string"
+                            "this_one=\"is a string with   consecutive spaces\"\n";
+
+    FILE *input_file = tmpfile();
+    assert(input_file);
+    fputs(contents, input_file);
+    rewind(input_file);
+
+    INIData_t *data = ini_create_data();
+    ini_read_file(input_file, data, NULL, 0);
+
+    FILE *output_file = tmpfile();
+    ini_write_file(output_file, data);
+    rewind(output_file);
+
+    INIData_t *copy = ini_create_data();
+    ini_read_file(output_file, copy, NULL, 0);
+    ASSERT_TRUE(copy != NULL);
+    ASSERT_TRUE(copy->sections != NULL);
+    ASSERT_EQ(data->section_count, copy->section_count);
+
+    for (unsigned i = 0; i < data->section_count; i++)
+    {
+        const INISection_t *section = &data->sections[i];
+        for (unsigned j = 0; j < section->pair_count; j++)
+        {
+            const char *key = section->pairs[j].key;
+            const char *value = section->pairs[j].value;
+
+            ASSERT_STREQ(value, ini_get_value(copy, section->name, key));
+
+        }
+    }
+
+    ini_free_data(data);
+    ini_free_data(copy);
+    fclose(input_file);
+    fclose(output_file);
+}
+
+
+
+TEST(ini_tests, file_long_lines)
+{
+    // Lines longer than INI_MAX_LINE_SIZE are read whole
+    const size_t n = INI_MAX_LINE_SIZE * 3;
+    char *comment = malloc(n + 1);
+    memset(comment, 'c', n);
+    comment[n] = '\0';
+
+    FILE *file = tmpfile();
+    fprintf(file, "[Section]\nkey=value ; %s\nother_key=other_value\n", comment);
+#ifdef INI_COMPACT_STRINGS
+    fprintf(file, "long_key=%s\n", comment);
+#endif
+    rewind(file);
+
+    INIMeasure_t measure;
+    ASSERT_TRUE(ini_measure_file(file, &measure, NULL, 0));
+    rewind(file);
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_read_file(file, data, NULL, 0) != NULL);
+    ASSERT_STREQ(ini_get_string(data, "Section", "key", ""), "value");
+    ASSERT_STREQ(ini_get_string(data, "Section", "other_key", ""), "other_value");
+#ifdef INI_COMPACT_STRINGS
+    ASSERT_EQ(measure.total_pairs, 3);
+    ASSERT_STREQ(ini_get_string(data, "Section", "long_key", ""), comment);
+#else
+    ASSERT_EQ(measure.total_pairs, 2);
+#endif
+    ini_free_data(data);
+
+    // Without the heap they can't be, and aren't read in pieces either
+    rewind(file);
+    start_stack_use();
+    INISection_t sections[1];
+    INIPair_t pool[4];
+    INIData_t ini;
+    ini_init_pooled_data(&ini, sections, 1, pool, 4);
+    char strings[INI_STRING_BUFFER_SIZE(64)];
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
+    INIError_t error;
+    ASSERT_TRUE(ini_read_file(file, &ini, &error, INI_CONTINUE_PAST_ERROR) == NULL);
+    ASSERT_TRUE(error.encountered);
+    ASSERT_EQ(ini.sections[0].pair_count, 0);
+    end_stack_use();
+
+    fclose(file);
+    free(comment);
+}
+
+
+
+TEST(ini_tests, stack)
+{
+    start_stack_use();
+
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "other_key=other_value\n"
+                            "[OtherSection]\n"
+                            "final_key=final_value\n";
+    FILE *file = tmpfile();
+    fputs(contents, file);
+    rewind(file);
+
+    const int max_sections = 32;
+    const int max_pairs = 32;
+
+    INISection_t sections[max_sections];
+    INIPair_t pairs[max_sections][max_pairs];
+    INIPair_t *row_ptrs[max_sections];
+    for (int i = 0; i < max_sections; i++)
+        row_ptrs[i] = pairs[i];
+    INIData_t ini;
+    ini_init_data(&ini, sections, row_ptrs, max_sections, max_pairs);
+    char strings[INI_STRING_BUFFER_SIZE(256)];
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
+
+    ASSERT_TRUE(ini_read_file(file, &ini, NULL, 0) != NULL);
+    fclose(file);
+
+    ASSERT_STREQ(ini_get_string(&ini, "Section", "key", ""), "value");
+    ASSERT_STREQ(ini_get_string(&ini, "Section", "other_key", ""), "other_value");
+    ASSERT_STREQ(ini_get_string(&ini, "OtherSection", "final_key", ""), "final_value");
+
+    end_stack_use();
+}
+
+
+
+TEST(ini_tests, stack_insufficient_pair_allocation)
+{
+    start_stack_use();
+
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "other_key=other_value\n";
+    FILE *file = tmpfile();
+    fputs(contents, file);
+    rewind(file);
+
+    const int max_sections = 8;
+    const int max_pairs = 1;
+
+    INISection_t sections[max_sections];
+    INIPair_t pairs[max_sections][max_pairs];
+    INIPair_t *row_ptrs[max_sections];
+    for (int i = 0; i < max_sections; i++)
+        row_ptrs[i] = pairs[i];
+    INIData_t ini;
+    ini_init_data(&ini, sections, row_ptrs, max_sections, max_pairs);
+    char strings[INI_STRING_BUFFER_SIZE(256)];
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
+
+    ASSERT_TRUE(ini_read_file(file, &ini, NULL, 0) == NULL);
+    fclose(file);
+
+    end_stack_use();
+}
+
+
+
+TEST(ini_tests, stack_insufficient_section_allocation)
+{
+    start_stack_use();
+
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "[OtherSection]\n"
+                            "other_key=other_value\n";
+    FILE *file = tmpfile();
+    fputs(contents, file);
+    rewind(file);
+
+    const int max_sections = 1;
+    const int max_pairs = 2;
+
+    INISection_t sections[max_sections];
+    INIPair_t pairs[max_sections][max_pairs];
+    INIPair_t *row_ptrs[max_sections];
+    for (int i = 0; i < max_sections; i++)
+        row_ptrs[i] = pairs[i];
+    INIData_t ini;
+    ini_init_data(&ini, sections, row_ptrs, max_sections, max_pairs);
+    char strings[INI_STRING_BUFFER_SIZE(256)];
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
+
+    ASSERT_TRUE(ini_read_file(file, &ini, NULL, 0) == NULL);
+    fclose(file);
+
+    end_stack_use();
+}
+
+
+
+TEST(ini_tests, stack_measured)
+{
+    start_stack_use();
+
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "other_key=other_value\n"
+                            "third_key=third_value\n"
+                            "[OtherSection]\n"
+                            "final_key=final_value\n";
+    FILE *file = tmpfile();
+    fputs(contents, file);
+    rewind(file);
+
+    INIMeasure_t measure;
+    ASSERT_TRUE(ini_measure_file(file, &measure, NULL, 0));
+    ASSERT_EQ(measure.sections, 2);
+    ASSERT_EQ(measure.max_pairs, 3);
+    ASSERT_EQ(measure.total_pairs, 4);
+    ASSERT_EQ(measure.string_bytes, strlen("Section") + strlen("OtherSection") + 2
+                                  + strlen("keyvalueother_keyother_valuethird_keythird_valuefinal_keyfinal_value") + 8);
+    rewind(file);
+
+    // Exactly enough, allocated once
+    INISection_t sections[measure.sections];
+    INIPair_t pairs[measure.sections][measure.max_pairs];
+    INIPair_t *row_ptrs[measure.sections];
+    for (unsigned i = 0; i < measure.sections; i++)
+        row_ptrs[i] = pairs[i];
+    INIData_t ini;
+    ini_init_data(&ini, sections, row_ptrs, measure.sections, measure.max_pairs);
+    char strings[INI_STRING_BUFFER_SIZE(measure.string_bytes)];
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
+
+    ASSERT_TRUE(ini_read_file(file, &ini, NULL, 0) != NULL);
+    fclose(file);
+    ASSERT_STREQ(ini_get_string(&ini, "Section", "third_key", ""), "third_value");
+    ASSERT_STREQ(ini_get_string(&ini, "OtherSection", "final_key", ""), "final_value");
+
+    INIError_t error;
+    const char broken[] = "[Section]\nkey=value\nbad pair\n";
+    ASSERT_FALSE(ini_measure_buffer(broken, strlen(broken), &measure, &error, 0));
+    ASSERT_TRUE(error.encountered);
+    ASSERT_STREQ(error.line, "bad pair\n");
+    ASSERT_TRUE(ini_measure_buffer(broken, strlen(broken), &measure, NULL, INI_CONTINUE_PAST_ERROR));
+    ASSERT_EQ(measure.total_pairs, 1);
+
+    end_stack_use();
+}
+
+
+
+TEST(ini_tests, stack_measured_merged)
+{
+    start_stack_use();
+
+    const char contents[] = "[a]\nx=1\n[b]\ny=1\n[a]\nz=1\n";
+    INIMeasure_t measure;
+    ASSERT_TRUE(ini_measure_buffer(contents, strlen(contents), &measure, NULL, 0));
+    ASSERT_EQ(measure.max_pairs, 1);
+    ASSERT_TRUE(ini_measure_buffer(contents, strlen(contents), &measure, NULL, INI_CONTINUE_PAST_ERROR));
+    ASSERT_EQ(measure.max_pairs, 2);
+    ASSERT_TRUE(ini_measure_buffer(contents, strlen(contents), &measure, NULL, INI_ALLOW_DUPLICATE_SECTIONS));
+    ASSERT_EQ(measure.sections, 3);
+    ASSERT_EQ(measure.max_pairs, 2);
+    ASSERT_EQ(measure.total_pairs, 3);
+
+    INISection_t sections[measure.sections];
+    INIPair_t pairs[measure.sections][measure.max_pairs];
+    INIPair_t *row_ptrs[measure.sections];
+    for (unsigned i = 0; i < measure.sections; i++)
+        row_ptrs[i] = pairs[i];
+    INIData_t ini;
+    ini_init_data(&ini, sections, row_ptrs, measure.sections, measure.max_pairs);
+    char strings[INI_STRING_BUFFER_SIZE(measure.string_bytes)];
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), &ini, NULL, INI_ALLOW_DUPLICATE_SECTIONS) != NULL);
+    ASSERT_STREQ(ini_get_string(&ini, "a", "z", ""), "1");
+
+    // More names than the measure keeps track of without a heap
+    char many[4096];
+    size_t length = 0;
+    for (int round = 0; round < 3; round++)
+        for (int i = 0; i < 100; i++)
+            length += (size_t)snprintf(many + length, sizeof(many) - length, "[s%d]\nk%d=v\n", i, round);
+    ASSERT_TRUE(ini_measure_buffer(many, length, &measure, NULL, INI_ALLOW_DUPLICATE_SECTIONS));
+    ASSERT_EQ(measure.sections, 300);
+    ASSERT_EQ(measure.total_pairs, 300);
+
+    // Without a heap, names past the first few can't be told apart
+    ASSERT_EQ(measure.max_pairs, 300);
+    end_stack_use();
+    ASSERT_TRUE(ini_measure_buffer(many, length, &measure, NULL, INI_ALLOW_DUPLICATE_SECTIONS));
+    ASSERT_EQ(measure.max_pairs, 3);
+}
+
+
+
+TEST(ini_tests, stack_pooled)
+{
+    start_stack_use();
+
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "other_key=other_value\n"
+                            "[OtherSection]\n"
+                            "final_key=final_value\n"
+                            "[Section]\n"
+                            "added_key=added_value\n"
+                            "[Empty]\n";
+
+    INISection_t sections[3];
+    INIPair_t pool[4];
+    INIData_t ini;
+    ini_init_pooled_data(&ini, sections, 3, pool, 4);
+    char strings[INI_STRING_BUFFER_SIZE(256)];
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
+
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), &ini, NULL, INI_ALLOW_DUPLICATE_SECTIONS) != NULL);
+    ASSERT_EQ(ini.section_count, 3);
+    ASSERT_EQ(ini.pool_used, 4);
+    ASSERT_STREQ(ini_get_string(&ini, "Section", "key", ""), "value");
+    ASSERT_STREQ(ini_get_string(&ini, "Section", "added_key", ""), "added_value");
+    ASSERT_STREQ(ini_get_string(&ini, "OtherSection", "final_key", ""), "final_value");
+    ASSERT_TRUE(ini.sections[1].pairs == &pool[3]);
+
+    // Both the pool and the sections are full
+    ASSERT_TRUE(ini_add_pair(&ini, "Empty", INI_PAIR("key", "value")) == NULL);
+    ASSERT_TRUE(ini_add_section(&ini, "Another") == NULL);
+
+    end_stack_use();
+}
+
+
+
+#ifdef INI_COMPACT_STRINGS
+TEST(ini_tests, stack_insufficient_string_space)
+{
+    const char contents[] = "[Section]\n"
+                            "key=a value longer than the space left for it\n";
+
+    INISection_t sections[2];
+    INIPair_t pool[2];
+    INIData_t ini;
+    ini_init_pooled_data(&ini, sections, 2, pool, 2);
+
+    // Without a buffer there's nowhere to put the strings, not even on
+    // the heap, as nothing could free it
+    INIError_t error;
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), &ini, &error, 0) == NULL);
+    ASSERT_STREQ(error.msg, "Failed to add section 'Section' to database. No buffer for strings, see ini_init_strings().");
+    ASSERT_TRUE(ini.blocks == NULL);
+
+    start_stack_use();
+    ini_init_pooled_data(&ini, sections, 2, pool, 2);
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), &ini, NULL, 0) == NULL);
+
+    char strings[INI_STRING_BUFFER_SIZE(16)];
+    ini_init_pooled_data(&ini, sections, 2, pool, 2);
+    ASSERT_FALSE(ini_init_strings(&ini, strings, 8));
+    ASSERT_TRUE(ini_init_strings(&ini, strings, sizeof(strings)));
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), &ini, NULL, 0) == NULL);
+    ASSERT_EQ(ini.section_count, 1);
+    ASSERT_EQ(ini.sections[0].pair_count, 0);
+
+    end_stack_use();
+}
+#endif
+
+
+
+TEST(ini_tests, arena)
+{
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "other_key=other_value\n"
+                            "[OtherSection]\n"
+                            "final_key=final_value\n";
+
+    INIData_t *data = ini_create_arena_data();
+    ASSERT_TRUE(data != NULL);
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, 0) != NULL);
+
+    // Enough sections and pairs to outgrow the first block
+    char name[32];
+    for (int i = 0; i < 64; i++)
+    {
+        snprintf(name, sizeof(name), "Added%d", i);
+        ASSERT_TRUE(ini_add_section(data, name) != NULL);
+        ASSERT_TRUE(ini_add_pair(data, name, INI_PAIR("key", "value")) != NULL);
+        ASSERT_TRUE(ini_add_pair(data, name, INI_PAIR("other_key", "other_value")) != NULL);
+    }
+
+    ASSERT_STREQ(ini_get_string(data, "Section", "key", ""), "value");
+    ASSERT_STREQ(ini_get_string(data, "Section", "other_key", ""), "other_value");
+    ASSERT_STREQ(ini_get_string(data, "OtherSection", "final_key", ""), "final_value");
+    ASSERT_STREQ(ini_get_string(data, "Added0", "key", ""), "value");
+    ASSERT_STREQ(ini_get_string(data, "Added63", "other_key", ""), "other_value");
+    ini_free_data(data);
+}
+
+
+
+TEST(ini_tests, arena_buffer)
+{
+    start_stack_use();
+
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "other_key=other_value\n"
+                            "[OtherSection]\n"
+                            "final_key=final_value\n";
+
+    static max_align_t buffer[64 * 1024 / sizeof(max_align_t)];
+    INIData_t *data = ini_init_arena_data(buffer, sizeof(buffer));
+    ASSERT_TRUE(data != NULL);
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, 0) != NULL);
+
+    ASSERT_STREQ(ini_get_string(data, "Section", "key", ""), "value");
+    ASSERT_STREQ(ini_get_string(data, "Section", "other_key", ""), "other_value");
+    ASSERT_STREQ(ini_get_string(data, "OtherSection", "final_key", ""), "final_value");
+    ini_free_data(data);
+
+    end_stack_use();
+}
+
+
+
+TEST(ini_tests, arena_buffer_small)
+{
+    start_stack_use();
+
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "other_key=other_value\n"
+                            "third_key=third_value\n"
+                            "[OtherSection]\n"
+                            "final_key=final_value\n";
+
+    // Sections only take the pairs they grow into
+    static max_align_t small[16 * 1024 / sizeof(max_align_t)];
+    INIData_t *data = ini_init_arena_data(small, sizeof(small));
+    ASSERT_TRUE(data != NULL);
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, 0) != NULL);
+    ASSERT_EQ(data->sections[0].pair_allocation, 4);
+    ASSERT_EQ(data->sections[1].pair_allocation, 1);
+    ASSERT_STREQ(ini_get_string(data, "Section", "third_key", ""), "third_value");
+
+    // Or all of them at once when measured up front
+    INIMeasure_t measure;
+    ASSERT_TRUE(ini_measure_buffer(contents, strlen(contents), &measure, NULL, 0));
+    static max_align_t smaller[8 * 1024 / sizeof(max_align_t)];
+    data = ini_init_arena_data(smaller, sizeof(smaller));
+    ASSERT_TRUE(data != NULL);
+    data->pair_reservation = measure.max_pairs;
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, 0) != NULL);
+    ASSERT_EQ(data->sections[0].pair_allocation, 3);
+    ASSERT_STREQ(ini_get_string(data, "OtherSection", "final_key", ""), "final_value");
+
+    end_stack_use();
+}
+
+
+
+TEST(ini_tests, arena_buffer_insufficient_space)
+{
+    start_stack_use();
+
+    max_align_t buffer[sizeof(INIData_t) / sizeof(max_align_t) + 1];
+    ASSERT_TRUE(ini_init_arena_data(buffer, sizeof(buffer)) == NULL);
+
+    static max_align_t small[4096 / sizeof(max_align_t)];
+    INIData_t *data = ini_init_arena_data(small, sizeof(small));
+    ASSERT_TRUE(data != NULL);
+
+    char name[32];
+    int added = 0;
+    while (added < 4096)
+    {
+        snprintf(name, sizeof(name), "Section%d", added);
+        if (!ini_add_section(data, name)) break;
+        added++;
+    }
+    ASSERT_TRUE(added > 0 && added < 4096);
+    ASSERT_TRUE(ini_has_section(data, "Section0") != NULL);
+
+    end_stack_use();
+}
+
+
+
+typedef struct
+{
+    unsigned allocations;
+    unsigned outstanding;
+} CountingAllocator_t;
+
+
+
+static void *counting_alloc(void *ctx, const size_t size)
+{
+    CountingAllocator_t *counts = ctx;
+    counts->allocations++;
+    counts->outstanding++;
+    return malloc(size);
+}
+
+
+
+static void *counting_realloc(void *ctx, void *ptr, const size_t size)
+{
+    CountingAllocator_t *counts = ctx;
+    counts->allocations++;
+    if (!ptr) counts->outstanding++;
+    return realloc(ptr, size);
+}
+
+
+
+static void counting_free(void *ctx, void *ptr)
+{
+    CountingAllocator_t *counts = ctx;
+    if (ptr) counts->outstanding--;
+    free(ptr);
+}
+
+
+
+TEST(ini_tests, own_allocator)
+{
+    const char contents[] = "[Section]\n"
+                            "key=value\n"
+                            "other_key=other_value\n"
+                            "[OtherSection]\n"
+                            "final_key=final_value\n";
+
+    CountingAllocator_t counts = { 0, 0 };
+    const INIAllocator_t allocator = { counting_alloc, counting_realloc, counting_free, &counts };
+
+    // The process-wide functions must not be touched
+    start_stack_use();
+    INIData_t *data = ini_create_data_with(&allocator);
+    ASSERT_TRUE(data != NULL);
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, 0) != NULL);
+    ASSERT_TRUE(ini_read_buffer_parallel(contents, strlen(contents), 4, data, NULL, INI_ALLOW_DUPLICATE_SECTIONS | INI_DUPLICATE_KEYS_OVERWRITE) != NULL);
+    end_stack_use();
+
+    ASSERT_TRUE(counts.allocations > 0);
+    ASSERT_STREQ(ini_get_string(data, "Section", "key", ""), "value");
+    ASSERT_STREQ(ini_get_string(data, "OtherSection", "final_key", ""), "final_value");
+
+    ini_free_data(data);
+    ASSERT_EQ(counts.outstanding, 0);
+
+    // Large enough to be split across threads, which take turns with it
+    const size_t size = 4 * INI_MIN_PARALLEL_CHUNK;
+    char *large = malloc(size);
+    size_t length = 0;
+    for (unsigned i = 0; length + 64 < size; i++)
+        length += (size_t)snprintf(large + length, size - length, "[Section%u]\nkey=%u\n", i, i);
+
+    start_stack_use();
+    data = ini_create_data_reserve_with(&allocator, 1024, 1);
+    ASSERT_TRUE(data != NULL);
+    ASSERT_TRUE(ini_read_buffer_parallel(large, length, 4, data, NULL, 0) != NULL);
+    ASSERT_EQ(ini_get_unsigned(data, "Section1000", "key", 0), 1000);
+
+    INIParser_t *parser = ini_parser_create(data, NULL, NULL, NULL, 0);
+    ASSERT_TRUE(parser != NULL);
+    ASSERT_TRUE(ini_parser_feed(parser, contents, strlen(contents)));
+    ASSERT_TRUE(ini_parser_finish(parser));
+    ini_parser_free(parser);
+    end_stack_use();
+    free(large);
+
+    ASSERT_STREQ(ini_get_string(data, "Section", "other_key", ""), "other_value");
+    ini_free_data(data);
+    ASSERT_EQ(counts.outstanding, 0);
+
+#if defined(__unix__) || defined(__APPLE__)
+    const char *dir = "ini_allocator_test";
+    mkdir(dir, 0700);
+    write_test_file("ini_allocator_test/1.ini", "[Server]\nport=8080\n");
+    write_test_file("ini_allocator_test/2.ini", "[Logging]\nlevel=debug\n");
+
+    start_stack_use();
+    data = ini_create_data_with(&allocator);
+    ASSERT_TRUE(ini_read_directory(dir, "*.ini", 2, data, NULL, 0) != NULL);
+    end_stack_use();
+    ASSERT_EQ(ini_get_unsigned(data, "Server", "port", 0), 8080);
+    ASSERT_STREQ(ini_get_string(data, "Logging", "level", ""), "debug");
+    ini_free_data(data);
+    ASSERT_EQ(counts.outstanding, 0);
+
+    remove("ini_allocator_test/1.ini");
+    remove("ini_allocator_test/2.ini");
+    rmdir(dir);
+#endif
+}
+
+
+
+static void end_stack_use()
+{
+    ini_set_allocator(malloc);
+    ini_set_free(free);
+    ini_set_reallocator(realloc);
+}
+
+
+
+static void start_stack_use()
+{
+    ini_disable_heap();
+}
+
+
+
+static void write_resealed_image(const char *path, const char *image, const size_t length, const size_t offset, const uint32_t field)
+{
+    char copy[1024];
+    memcpy(copy, image, length);
+    memcpy(copy + offset, &field, sizeof(field));
+
+    // FNV-1a over everything after the 64-byte header, eight bytes at a time
+    uint64_t checksum = 14695981039346656037ull;
+    size_t i = 64;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, copy + i, sizeof(word));
+        checksum = (checksum ^ word) * 1099511628211ull;
+    }
+    for (; i < length; i++)
+        checksum = (checksum ^ (unsigned char)copy[i]) * 1099511628211ull;
+    memcpy(copy + 56, &checksum, sizeof(checksum));
+
+    FILE *file = fopen(path, "wb");
+    assert(file);
+    fwrite(copy, 1, length, file);
+    fclose(file);
+}
@@ -3,10 +3,25 @@
 
 
 
+#include <string.h>
+
+
+
 INIPair_t pair;
 
 
 
+// Parsed keys and values point into the line with INI_COMPACT_STRINGS
+#ifdef INI_COMPACT_STRINGS
+#define ASSERT_KEY(expected)   ASSERT_TRUE(pair.key_length == strlen(expected) && memcmp(pair.key, expected, pair.key_length) == 0)
+#define ASSERT_VALUE(expected) ASSERT_TRUE(pair.value_length == strlen(expected) && memcmp(pair.value, expected, pair.value_length) == 0)
+#else
+#define ASSERT_KEY(expected)   ASSERT_STREQ(pair.key, expected)
+#define ASSERT_VALUE(expected) ASSERT_STREQ(pair.value, expected)
+#endif
+
+
+
 ///////////////////
 //  Valid Pairs  //
 ///////////////////
@@ -17,8 +32,8 @@ TEST(pairs, normal)
 {
     const char string[] = "key=value";
     ASSERT_TRUE(ini_parse_pair(string, &pair, NULL));
-    ASSERT_STREQ(pair.key, "key");
-    ASSERT_STREQ(pair.value, "value");
+    ASSERT_KEY("key");
+    ASSERT_VALUE("value");
 }
 
 
@@ -27,8 +42,8 @@ TEST(pairs, padded)
 {
     const char string[] = "  key  =  value  ";
     ASSERT_TRUE(ini_parse_pair(string, &pair, NULL));
-    ASSERT_STREQ(pair.key, "key");
-    ASSERT_STREQ(pair.value, "value");
+    ASSERT_KEY("key");
+    ASSERT_VALUE("value");
 }
 
 
@@ -37,8 +52,8 @@ TEST(pairs, comment)
 {
     const char string[] = "key=value  \t ; comment here";
     ASSERT_TRUE(ini_parse_pair(string, &pair, NULL));
-    ASSERT_STREQ(pair.key, "key");
-    ASSERT_STREQ(pair.value, "value");
+    ASSERT_KEY("key");
+    ASSERT_VALUE("value");
 }
 
 
@@ -47,8 +62,8 @@ TEST(pairs, unquoted_string)
 {
     const char string[] = "key=this is a value";
     ASSERT_TRUE(ini_parse_pair(string, &pair, NULL));
-    ASSERT_STREQ(pair.key, "key");
-    ASSERT_STREQ(pair.value, "this is a value");
+    ASSERT_KEY("key");
+    ASSERT_VALUE("this is a value");
 }
 
 
@@ -57,8 +72,24 @@ TEST(pairs, quoted_string)
 {
     const char string[] = "key=\"this is a value\"";
     ASSERT_TRUE(ini_parse_pair(string, &pair, NULL));
-    ASSERT_STREQ(pair.key, "key");
-    ASSERT_STREQ(pair.value, "this is a value");
+    ASSERT_KEY("key");
+    ASSERT_VALUE("this is a value");
+}
+
+
+
+TEST(pairs, add_parsed)
+{
+    const char string[] = "key=value ; comment";
+    ASSERT_TRUE(ini_parse_pair(string, &pair, NULL));
+
+    INIData_t *data = ini_create_data();
+    INISection_t *section = ini_add_section(data, "section");
+    const INIPair_t *added = ini_add_pair_to_section(section, pair);
+    ASSERT_TRUE(added != NULL);
+    ASSERT_STREQ(added->key, "key");
+    ASSERT_STREQ(added->value, "value");
+    ini_free_data(data);
 }
 
 
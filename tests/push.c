@@ -0,0 +1,116 @@
+#include "rktest.h"
+#include "../ini.h"
+
+
+
+#include <string.h>
+
+
+
+static const char contents[] = "[Section1]\n"
+                               "hello=world\n"
+                               "[Section2]\n"
+                               "boolean=true\n"
+                               "integer=5\n"
+                               "string=\"is a string\"\n"
+                               "[Section1]\n"
+                               "float=1.0";
+
+
+
+static bool count_pair(void *user, INIView_t section, INIView_t key, INIView_t value)
+{
+    (void)section; (void)key; (void)value;
+    (*(unsigned *)user)++;
+    return true;
+}
+
+
+
+TEST(push, every_chunk_size)
+{
+    for (size_t chunk = 1; chunk <= sizeof(contents); chunk++)
+    {
+        INIData_t *data = ini_create_data();
+        INIParser_t parser;
+        ASSERT_TRUE(ini_parser_init(&parser, data, NULL, NULL, NULL, INI_ALLOW_DUPLICATE_SECTIONS));
+
+        for (size_t i = 0; i < sizeof(contents) - 1; i += chunk)
+        {
+            const size_t n = sizeof(contents) - 1 - i < chunk ? sizeof(contents) - 1 - i : chunk;
+            ASSERT_TRUE(ini_parser_feed(&parser, contents + i, n));
+        }
+        ASSERT_TRUE(ini_parser_finish(&parser));
+
+        ASSERT_STREQ(ini_get_value(data, "Section1", "hello"), "world");
+        ASSERT_EQ(ini_get_signed(data, "Section2", "integer", 0), 5);
+        ASSERT_STREQ(ini_get_string(data, "Section2", "string", ""), "is a string");
+        ASSERT_STREQ(ini_get_string(data, "Section1", "float", ""), "1.0");
+        ini_free_data(data);
+    }
+}
+
+
+
+TEST(push, callbacks)
+{
+    unsigned pairs = 0;
+    const INICallbacks_t callbacks = { NULL, count_pair };
+    INIParser_t *parser = ini_parser_create(NULL, &callbacks, &pairs, NULL, 0);
+    ASSERT_TRUE(parser != NULL);
+
+    ASSERT_TRUE(ini_parser_feed(parser, contents, 15));
+    ASSERT_TRUE(ini_parser_feed(parser, contents + 15, sizeof(contents) - 1 - 15));
+    ASSERT_TRUE(ini_parser_finish(parser));
+    ASSERT_EQ(pairs, 5);
+    ini_parser_free(parser);
+}
+
+
+
+TEST(push, error)
+{
+    const char erroneous[] = "[Section]\nerroneous line\nkey=value\n";
+
+    INIData_t *data = ini_create_data();
+    INIError_t error;
+    INIParser_t parser;
+    ini_parser_init(&parser, data, NULL, NULL, &error, 0);
+    ASSERT_TRUE(ini_parser_feed(&parser, erroneous, 15));
+    ASSERT_FALSE(ini_parser_feed(&parser, erroneous + 15, sizeof(erroneous) - 1 - 15));
+    ASSERT_FALSE(ini_parser_finish(&parser));
+    ASSERT_TRUE(error.encountered);
+    ASSERT_STREQ(error.line, "erroneous line\n");
+    ASSERT_TRUE(ini_get_value(data, "Section", "key") == NULL);
+    ini_free_data(data);
+}
+
+
+
+TEST(push, line_too_long)
+{
+    char line[INI_MAX_LINE_SIZE + 16];
+    memset(line, 'a', sizeof(line));
+    memcpy(line, "key=", 4);
+    line[sizeof(line) - 1] = '\n';
+
+    INIData_t *data = ini_create_data();
+    INIParser_t parser;
+    ini_parser_init(&parser, data, NULL, NULL, NULL, 0);
+    ASSERT_TRUE(ini_parser_feed(&parser, "[Section]\n", 10));
+    ASSERT_TRUE(ini_parser_feed(&parser, line, 10));
+    ASSERT_FALSE(ini_parser_feed(&parser, line + 10, sizeof(line) - 10));
+    ini_free_data(data);
+}
+
+
+
+TEST(push, requires_one_destination)
+{
+    INIData_t *data = ini_create_data();
+    const INICallbacks_t callbacks = { NULL, NULL };
+    INIParser_t parser;
+    ASSERT_FALSE(ini_parser_init(&parser, NULL, NULL, NULL, NULL, 0));
+    ASSERT_FALSE(ini_parser_init(&parser, data, &callbacks, NULL, NULL, 0));
+    ini_free_data(data);
+}
@@ -3,6 +3,15 @@
 
 
 
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+
 /////////////////////
 //  Valid Queries  //
 /////////////////////
@@ -24,7 +33,7 @@ TEST(queries, add_pair)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    const INIPair_t *pair = ini_add_pair(data, "section", (INIPair_t){"key", "value"});
+    const INIPair_t *pair = ini_add_pair(data, "section", INI_PAIR("key", "value"));
     ASSERT_TRUE(pair != NULL);
     ASSERT_STREQ(pair->key, "key");
     ASSERT_STREQ(pair->value, "value");
@@ -37,7 +46,7 @@ TEST(queries, add_pair_to_section)
 {
     INIData_t *data = ini_create_data();
     INISection_t *section = ini_add_section(data, "section");
-    const INIPair_t *pair = ini_add_pair_to_section(section, (INIPair_t){"key", "value"});
+    const INIPair_t *pair = ini_add_pair_to_section(section, INI_PAIR("key", "value"));
     ASSERT_TRUE(pair != NULL);
     ASSERT_STREQ(pair->key, "key");
     ASSERT_STREQ(pair->value, "value");
@@ -50,7 +59,7 @@ TEST(queries, get_value)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "value"});
+    ini_add_pair(data, "section", INI_PAIR("key", "value"));
     const char *val = ini_get_value(data, "section", "key");
     ASSERT_TRUE(val != NULL);
     ASSERT_STREQ(val, "value");
@@ -63,7 +72,7 @@ TEST(queries, get_string)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "string value!"});
+    ini_add_pair(data, "section", INI_PAIR("key", "string value!"));
     const char *val = ini_get_string(data, "section", "key", "");
     ASSERT_STREQ(val, "string value!");
     ini_free_data(data);
@@ -75,7 +84,7 @@ TEST(queries, get_unsigned)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "1234567890"});
+    ini_add_pair(data, "section", INI_PAIR("key", "1234567890"));
     const unsigned long val = (unsigned long)ini_get_unsigned(data, "section", "key", 0);
     ASSERT_LONG_EQ(val, 1234567890);
     ini_free_data(data);
@@ -87,7 +96,7 @@ TEST(queries, get_signed)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "-1"});
+    ini_add_pair(data, "section", INI_PAIR("key", "-1"));
     const long val = (long)ini_get_signed(data, "section", "key", 0);
     ASSERT_LONG_EQ(val, -1);
     ini_free_data(data);
@@ -99,7 +108,7 @@ TEST(queries, get_hex_upper)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "0xDEADBEEF"});
+    ini_add_pair(data, "section", INI_PAIR("key", "0xDEADBEEF"));
     const long val = (long)ini_get_hex(data, "section", "key", 0);
     ASSERT_LONG_EQ(val, 0xdeadbeef);
     ini_free_data(data);
@@ -111,7 +120,7 @@ TEST(queries, get_hex_lower)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "0xdeadbeef"});
+    ini_add_pair(data, "section", INI_PAIR("key", "0xdeadbeef"));
     const long val = (long)ini_get_hex(data, "section", "key", 0);
     ASSERT_LONG_EQ(val, 0xdeadbeef);
     ini_free_data(data);
@@ -123,7 +132,7 @@ TEST(queries, get_float)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "3.14"});
+    ini_add_pair(data, "section", INI_PAIR("key", "3.14"));
     const float val = (float)ini_get_float(data, "section", "key", 0);
     ASSERT_LONG_EQ(val, 3.14);
     ini_free_data(data);
@@ -135,7 +144,7 @@ TEST(queries, get_bool_true)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "true"});
+    ini_add_pair(data, "section", INI_PAIR("key", "true"));
     ASSERT_TRUE(ini_get_bool(data, "section", "key", false));
     ini_free_data(data);
 }
@@ -146,13 +155,656 @@ TEST(queries, get_bool_false)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "false"});
+    ini_add_pair(data, "section", INI_PAIR("key", "false"));
     ASSERT_FALSE(ini_get_bool(data, "section", "key", true));
     ini_free_data(data);
 }
 
 
 
+TEST(queries, lazy_pairs)
+{
+    INIData_t *data = ini_create_data();
+    INISection_t *section = ini_add_section(data, "section");
+    ASSERT_TRUE(section->pairs == NULL);
+    ASSERT_TRUE(ini_get_value(data, "section", "key") == NULL);
+    ini_add_pair(data, "section", INI_PAIR("key", "value"));
+    ASSERT_STREQ(ini_get_value(data, "section", "key"), "value");
+    ini_free_data(data);
+
+    data = ini_create_data_reserve(4, 16);
+    ASSERT_EQ(data->section_allocation, 4);
+    char name[32];
+    for (int i = 0; i < 4; i++)
+    {
+        snprintf(name, sizeof(name), "section%d", i);
+        ini_add_section(data, name);
+    }
+    ASSERT_EQ(data->section_allocation, 4);
+
+    section = ini_has_section(data, "section2");
+    ASSERT_EQ(section->pair_allocation, 0);
+    ini_add_pair_to_section(section, INI_PAIR("key", "value"));
+    ASSERT_EQ(section->pair_allocation, 16);
+    ASSERT_EQ(data->sections[0].pair_allocation, 0);
+    ASSERT_STREQ(ini_get_value(data, "section2", "key"), "value");
+    ini_free_data(data);
+}
+
+
+
+TEST(queries, numeric_conversion)
+{
+    static const char *numbers[] =
+    {
+        "0.75", "0.1", "3.141592653589793", "-2.5e-3", "1e22", "1e23", "0.30000000000000004",
+        "9007199254740993", "2.2250738585072014e-308", "4.9e-324", "1.7976931348623157e308",
+        "123456789012345678901234567890", "0.000000000000000000000000000001", "0x1.8p1", "-0"
+    };
+
+    char contents[128];
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(*numbers); i++)
+    {
+        const int length = snprintf(contents, sizeof(contents), "[section]\nkey = %s\n", numbers[i]);
+        INIData_t *data = ini_read_buffer(contents, (size_t)length, ini_create_data(), NULL, 0);
+
+        int status = -1;
+        const double value = ini_get_double(data, "section", "key", 0, &status);
+        ASSERT_EQ(status, INI_CONVERTED);
+        ASSERT_TRUE(value == strtod(numbers[i], NULL));
+        ini_free_data(data);
+    }
+
+    INIData_t *data = ini_create_data();
+    INISection_t *section = ini_add_section(data, "section");
+    ini_add_pair_to_section(section, INI_PAIR("huge", "1e400"));
+    ini_add_pair_to_section(section, INI_PAIR("junk", "12abc"));
+    ini_add_pair_to_section(section, INI_PAIR("word", "abc"));
+    ini_add_pair_to_section(section, INI_PAIR("max", "9223372036854775808"));
+    ini_add_pair_to_section(section, INI_PAIR("min", "-9223372036854775808"));
+    ini_add_pair_to_section(section, INI_PAIR("hex", "0xff"));
+    ini_add_pair_to_section(section, INI_PAIR("negative", "-1"));
+
+    int status;
+    ASSERT_TRUE(ini_get_double(data, "section", "huge", 0, &status) > DBL_MAX);
+    ASSERT_EQ(status, INI_CONVERT_OVERFLOW);
+    ASSERT_TRUE(ini_get_double(data, "section", "junk", 0, &status) == 12);
+    ASSERT_EQ(status, INI_CONVERT_TRAILING);
+    ASSERT_TRUE(ini_get_double(data, "section", "word", 1.5, &status) == 1.5);
+    ASSERT_EQ(status, INI_CONVERT_INVALID);
+    ASSERT_TRUE(ini_get_double(data, "section", "missing", 2.5, &status) == 2.5);
+    ASSERT_EQ(status, INI_CONVERT_MISSING);
+
+    ASSERT_TRUE(ini_get_int64(data, "section", "max", 0, &status) == INT64_MAX);
+    ASSERT_EQ(status, INI_CONVERT_OVERFLOW);
+    ASSERT_TRUE(ini_get_int64(data, "section", "min", 0, &status) == INT64_MIN);
+    ASSERT_EQ(status, INI_CONVERTED);
+    ASSERT_TRUE(ini_get_int64(data, "section", "junk", 0, NULL) == 12);
+    ASSERT_TRUE(ini_get_int64(data, "section", "word", 7, &status) == 7);
+    ASSERT_EQ(status, INI_CONVERT_INVALID);
+
+    ASSERT_TRUE(ini_get_hex(data, "section", "hex", 0) == 0xff);
+    ASSERT_TRUE(ini_get_unsigned(data, "section", "negative", 0) == ULLONG_MAX);
+    ASSERT_TRUE(ini_get_unsigned(data, "section", "max", 0) == 9223372036854775808ull);
+    ASSERT_TRUE(ini_get_signed(data, "section", "max", 0) == LLONG_MAX);
+    ini_free_data(data);
+}
+
+
+
+TEST(queries, float_parsing)
+{
+    static const struct { const char *text; double value; int status; } numbers[] =
+    {
+        { "0x1.8p1", 3, INI_CONVERTED },
+        { "-0X.8P-1", -0.25, INI_CONVERTED },
+        { "0x1.00000000000008p0", 1, INI_CONVERTED },
+        { "0x1.00000000000018p0", 0x1.0000000000002p0, INI_CONVERTED },
+        { "0x1.000000000000080000000000000001p0", 0x1.0000000000001p0, INI_CONVERTED },
+        { "0x1p-1075", 0, INI_CONVERT_OVERFLOW },
+        { "0x1.0000000000001p-1075", 0x1p-1074, INI_CONVERTED },
+        { "0x1.fffffffffffffp1023", DBL_MAX, INI_CONVERTED },
+        { "9007199254740993", 9007199254740992.0, INI_CONVERTED },
+        { "9007199254740995", 9007199254740996.0, INI_CONVERTED },
+        { "18014398509481986", 18014398509481984.0, INI_CONVERTED },
+        { "0.30000000000000004", 0.30000000000000004, INI_CONVERTED },
+        { "1e23", 1e23, INI_CONVERTED },
+        { "1.7976931348623157e308", DBL_MAX, INI_CONVERTED },
+        { "1.7976931348623159e308", INFINITY, INI_CONVERT_OVERFLOW },
+        { "2.2250738585072011e-308", 0x0.fffffffffffffp-1022, INI_CONVERTED },
+        { "2.2250738585072014e-308", DBL_MIN, INI_CONVERTED },
+        { "4.9406564584124654e-324", 0x1p-1074, INI_CONVERTED },
+        { "-8.3333333333333333e-1", -0.83333333333333333, INI_CONVERTED },
+        { "2.470328229206232720882843964341106861825299013071623822127928412503377536351043759e-324", 0, INI_CONVERT_OVERFLOW },
+        { "2.470328229206232720882843964341106861825299013071623822127928412503377536351043760e-324", 0x1p-1074, INI_CONVERTED },
+        { "1e-400", 0, INI_CONVERT_OVERFLOW },
+        { "-1e-400", -0.0, INI_CONVERT_OVERFLOW },
+        { "0e999999", 0, INI_CONVERTED },
+        { "inf", INFINITY, INI_CONVERTED },
+        { "-Infinity", -INFINITY, INI_CONVERTED },
+        { "INFINIT", INFINITY, INI_CONVERT_TRAILING },
+        { "0x1p1024", INFINITY, INI_CONVERT_OVERFLOW },
+        { "1.5x", 1.5, INI_CONVERT_TRAILING },
+        { "1e", 1, INI_CONVERT_TRAILING },
+        { "0x", 0, INI_CONVERT_TRAILING },
+    };
+
+    char contents[256];
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(*numbers); i++)
+    {
+        const int length = snprintf(contents, sizeof(contents), "[section]\nkey = %s\n", numbers[i].text);
+        INIData_t *data = ini_read_buffer(contents, (size_t)length, ini_create_data(), NULL, 0);
+
+        int status = -1;
+        const double value = ini_get_double(data, "section", "key", -1, &status);
+        ASSERT_EQ(status, numbers[i].status);
+        ASSERT_TRUE(value == numbers[i].value);
+        ASSERT_TRUE(signbit(value) == signbit(numbers[i].value));
+        ASSERT_TRUE(ini_get_float(data, "section", "key", -1) == strtold(numbers[i].text, NULL));
+        ini_free_data(data);
+    }
+
+    INIData_t *data = ini_create_data();
+    INISection_t *section = ini_add_section(data, "section");
+    ini_add_pair_to_section(section, INI_PAIR("nan", "nan"));
+    ini_add_pair_to_section(section, INI_PAIR("payload", "-NaN(0x1f)"));
+    ini_add_pair_to_section(section, INI_PAIR("third", "0.333333333333333333333333333333"));
+    ini_add_pair_to_section(section, INI_PAIR("long_hex", "0x1.23456789abcdef0123456789abcdefp-16000"));
+    ini_add_pair_to_section(section, INI_PAIR("tiny", "-1e-99999"));
+
+    int status = -1;
+    ASSERT_TRUE(isnan(ini_get_double(data, "section", "nan", 0, &status)));
+    ASSERT_EQ(status, INI_CONVERTED);
+    ASSERT_TRUE(isnan(ini_get_double(data, "section", "payload", 0, &status)));
+    ASSERT_EQ(status, INI_CONVERTED);
+    ASSERT_TRUE(isnan(ini_get_float(data, "section", "nan", 0)));
+    ASSERT_TRUE(ini_get_float(data, "section", "third", 0) == strtold("0.333333333333333333333333333333", NULL));
+    ASSERT_TRUE(ini_get_float(data, "section", "long_hex", 0) == strtold("0x1.23456789abcdef0123456789abcdefp-16000", NULL));
+    ASSERT_TRUE(ini_get_float(data, "section", "tiny", 1) == 0);
+    ASSERT_TRUE(signbit(ini_get_float(data, "section", "tiny", 1)));
+    ini_free_data(data);
+
+    // Values well past any fixed parse buffer still round exactly
+    char text[201];
+    memset(text, '0', sizeof(text));
+    memcpy(text, "9007199254740993.", 17);
+    strcpy(text + sizeof(text) - 2, "1");
+    int length = snprintf(contents, sizeof(contents), "[section]\nkey = %s\n", text);
+    data = ini_read_buffer(contents, (size_t)length, ini_create_data(), NULL, 0);
+    ASSERT_TRUE(ini_get_double(data, "section", "key", 0, &status) == 9007199254740994.0);
+    ASSERT_EQ(status, INI_CONVERTED);
+    ini_free_data(data);
+
+    memset(text, '0', sizeof(text));
+    memcpy(text, "0.", 2);
+    memcpy(text + 150, "1e148", 6);
+    length = snprintf(contents, sizeof(contents), "[section]\nkey = %s\n", text);
+    data = ini_read_buffer(contents, (size_t)length, ini_create_data(), NULL, 0);
+    ASSERT_TRUE(ini_get_double(data, "section", "key", 0, &status) == 0.1);
+    ASSERT_EQ(status, INI_CONVERTED);
+    ASSERT_TRUE(ini_get_float(data, "section", "key", 0) == strtold(text, NULL));
+    ini_free_data(data);
+}
+
+
+
+TEST(queries, float_parsing_speed)
+{
+    // Shortest round trip output needs up to 17 digits, past the exact
+    // double fast path. Parsing it here should still beat strtod()
+    enum { COUNT = 100000 };
+    const size_t size = COUNT * 40;
+    char *contents = malloc(size);
+    size_t length = (size_t)snprintf(contents, size, "[section]\n");
+    srand(1);
+    for (int i = 0; i < COUNT; i++)
+    {
+        const double value = (double)rand() / RAND_MAX * pow(10, rand() % 600 - 300);
+        length += (size_t)snprintf(contents + length, size - length, "k%d = %.17g\n", i, value);
+    }
+
+    INIData_t *data = ini_create_data();
+    ini_enable_index(data);
+    data = ini_read_buffer(contents, length, data, NULL, 0);
+    ASSERT_TRUE(data != NULL);
+    char key[16];
+
+    double expected = 0, checksum = 0;
+    struct timespec start, end;
+    timespec_get(&start, TIME_UTC);
+    for (int i = 0; i < COUNT; i++)
+    {
+        snprintf(key, sizeof(key), "k%d", i);
+        expected += strtod(ini_get_value(data, "section", key), NULL);
+    }
+    timespec_get(&end, TIME_UTC);
+    const double library = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    timespec_get(&start, TIME_UTC);
+    for (int i = 0; i < COUNT; i++)
+    {
+        snprintf(key, sizeof(key), "k%d", i);
+        checksum += ini_get_double(data, "section", key, 0, NULL);
+    }
+    timespec_get(&end, TIME_UTC);
+    const double parsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    ini_free_data(data);
+    free(contents);
+    ASSERT_TRUE(checksum == expected);
+#ifndef __SANITIZE_ADDRESS__
+    // Instrumented code can't keep up with the C library
+    ASSERT_TRUE(parsed < library);
+#else
+    (void)parsed;
+    (void)library;
+#endif
+}
+
+
+
+TEST(queries, bind)
+{
+    typedef struct
+    {
+        const char *title;
+        int width;
+        unsigned height;
+        double volume;
+        bool fullscreen;
+        uint64_t mask;
+        int64_t missing;
+    } Config;
+
+    static const INIBinding_t schema[] =
+    {
+        { "window", "title",      INI_BIND_STRING,   offsetof(Config, title),      { .str = "" } },
+        { "window", "width",      INI_BIND_INT,      offsetof(Config, width),      { .s = 640 } },
+        { "window", "height",     INI_BIND_UNSIGNED, offsetof(Config, height),     { .u = 480 } },
+        { "window", "fullscreen", INI_BIND_BOOL,     offsetof(Config, fullscreen), { .b = true } },
+        { "audio",  "volume",     INI_BIND_DOUBLE,   offsetof(Config, volume),     { .d = 1.0 } },
+        { "audio",  "mask",       INI_BIND_HEX,      offsetof(Config, mask),       { .u = 0 } },
+        { "audio",  "missing",    INI_BIND_INT64,    offsetof(Config, missing),    { .s = -7 } },
+    };
+    const unsigned count = sizeof(schema) / sizeof(*schema);
+
+    const char contents[] =
+        "[window]\ntitle = Hello\nwidth = 1280\nheight = 720\nfullscreen = false\n"
+        "[audio]\nvolume = 0.75\nmask = 0xff\n"
+        "[other]\nkey = value\n";
+    INIData_t *data = ini_read_buffer(contents, sizeof(contents) - 1, ini_create_data(), NULL, 0);
+
+    Config config;
+    INIError_t error;
+    ASSERT_EQ(ini_bind(data, schema, count, &config, &error), 1);
+    ASSERT_STREQ(config.title, "Hello");
+    ASSERT_EQ(config.width, 1280);
+    ASSERT_EQ(config.height, 720);
+    ASSERT_FALSE(config.fullscreen);
+    ASSERT_TRUE(config.volume == 0.75);
+    ASSERT_TRUE(config.mask == 0xff);
+    ASSERT_TRUE(config.missing == -7);
+    ASSERT_TRUE(error.encountered);
+    ASSERT_STREQ(error.line, "[audio] missing");
+
+    // Unknown keys and bad values take the default and are reported
+    const char changed[] = "[window]\nwidth = wide\ndepth = 24\n";
+    ini_free_data(data);
+    data = ini_read_buffer(changed, sizeof(changed) - 1, ini_create_data(), NULL, 0);
+    ASSERT_EQ(ini_bind(data, schema, count, &config, &error), 8);
+    ASSERT_EQ(config.width, 640);
+    ASSERT_EQ(config.height, 480);
+    ASSERT_STREQ(error.line, "[window] width");
+    ASSERT_STREQ(error.msg, "Value has the wrong type");
+    ini_free_data(data);
+
+    // Without a heap the schema is scanned instead
+    data = ini_read_buffer(contents, sizeof(contents) - 1, ini_create_data(), NULL, 0);
+    ini_disable_heap();
+    ASSERT_EQ(ini_bind(data, schema, count, &config, NULL), 1);
+    ASSERT_EQ(config.width, 1280);
+    ASSERT_TRUE(config.mask == 0xff);
+    ini_set_allocator(malloc);
+    ini_set_free(free);
+    ini_set_reallocator(realloc);
+
+    // Views carry their length, and a missing one takes its default's
+    static const INIBinding_t views[] =
+    {
+        { "window", "title", INI_BIND_VIEW, 0,                 { .str = "" } },
+        { "window", "icon",  INI_BIND_VIEW, sizeof(INIView_t), { .str = "none" } },
+    };
+    INIView_t bound[2];
+    ASSERT_EQ(ini_bind(data, views, 2, bound, NULL), 4);
+    ASSERT_TRUE(bound[0].length == 5 && memcmp(bound[0].data, "Hello", 5) == 0);
+    ASSERT_TRUE(bound[0].data == ini_get_view(data, "window", "title").data);
+    ASSERT_TRUE(bound[1].length == 4 && strcmp(bound[1].data, "none") == 0);
+    ini_free_data(data);
+}
+
+
+
+TEST(queries, cached_values)
+{
+    INIData_t *data = ini_create_data();
+    INISection_t *section = ini_add_section(data, "section");
+    ini_add_pair_to_section(section, INI_PAIR("number", "42"));
+    ini_add_pair_to_section(section, INI_PAIR("word", "hello"));
+
+    ASSERT_EQ(ini_get_unsigned(data, "section", "number", 0), 42);
+    ASSERT_EQ(ini_get_unsigned(data, "section", "number", 0), 42);
+    ASSERT_EQ(ini_get_signed(data, "section", "number", 0), 42);
+    ASSERT_TRUE(ini_get_float(data, "section", "word", 1.5) == 1.5);
+    ASSERT_TRUE(ini_get_float(data, "section", "word", 2.5) == 2.5);
+    ASSERT_TRUE(ini_get_bool(data, "section", "word", true));
+#if defined(__GNUC__) || defined(__clang__)
+    ASSERT_EQ(section->cache[0].kind, INI_CACHED_SIGNED);
+    ASSERT_EQ(section->cache[1].kind, INI_CACHED_FLOAT);
+    ASSERT_EQ(section->cache[1].status, INI_CONVERT_INVALID);
+#endif
+
+    // Overwriting a pair forgets its converted value
+    const char contents[] = "[section]\nnumber = 7\n";
+    const uint64_t flags = INI_ALLOW_DUPLICATE_SECTIONS | INI_DUPLICATE_KEYS_OVERWRITE;
+    ASSERT_TRUE(ini_read_buffer(contents, sizeof(contents) - 1, data, NULL, flags) != NULL);
+    ASSERT_EQ(ini_get_unsigned(data, "section", "number", 0), 7);
+    section = ini_has_section(data, "section");
+    ASSERT_EQ(section->pair_count, 2);
+
+    // Values stay cached across growth of the section
+    for (int i = 0; i < 64; i++)
+        ini_add_pair_to_section(section, INI_PAIR("other", "1"));
+    ASSERT_EQ(ini_get_unsigned(data, "section", "number", 0), 7);
+    ini_free_data(data);
+}
+
+
+
+// Sibling kinds come from a pair's entry where it holds them exactly, as
+// changing it behind the getters' backs shows
+TEST(queries, cached_siblings)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    INIData_t *data = ini_create_data();
+    INISection_t *section = ini_add_section(data, "section");
+    ini_add_pair_to_section(section, INI_PAIR("number", "42"));
+    int status = -1;
+    ASSERT_EQ(ini_get_unsigned(data, "section", "number", 0), 42);
+    ini_add_pair_to_section(section, INI_PAIR("exact", "0.75"));
+    ini_add_pair_to_section(section, INI_PAIR("inexact", "0.1"));
+    ini_add_pair_to_section(section, INI_PAIR("negative", "-5"));
+    ini_add_pair_to_section(section, INI_PAIR("large", "18446744073709551615"));
+    ASSERT_TRUE(ini_get_float(data, "section", "exact", 0) == 0.75);
+    ASSERT_TRUE(ini_get_float(data, "section", "inexact", 0) == 0.1L);
+    ASSERT_TRUE(ini_get_unsigned(data, "section", "negative", 0) == 0 - 5ull);
+    ASSERT_TRUE(ini_get_unsigned(data, "section", "large", 0) == ULLONG_MAX);
+    section->cache[0].value.s = 43;
+    section->cache[1].value.f = 0.5;
+    ASSERT_EQ(ini_get_unsigned(data, "section", "number", 0), 43);
+    ASSERT_EQ(ini_get_signed(data, "section", "number", 0), 43);
+    ASSERT_TRUE(ini_get_double(data, "section", "exact", 0, &status) == 0.5);
+    ASSERT_EQ(status, INI_CONVERTED);
+    ASSERT_TRUE(ini_get_double(data, "section", "inexact", 0, &status) == 0.1);
+    ASSERT_EQ(ini_get_signed(data, "section", "negative", 0), -5);
+    ASSERT_TRUE(ini_get_int64(data, "section", "large", 0, &status) == LLONG_MAX);
+    ASSERT_EQ(status, INI_CONVERT_OVERFLOW);
+    ASSERT_EQ(section->cache[1].kind, INI_CACHED_FLOAT);
+    ASSERT_EQ(section->cache[2].kind, INI_CACHED_FLOAT);
+    ASSERT_EQ(section->cache[3].kind, INI_CACHED_SIGNED);
+    ASSERT_EQ(section->cache[4].kind, INI_CACHED_UNSIGNED);
+    ini_free_data(data);
+#endif
+}
+
+
+
+TEST(queries, indexed)
+{
+    INIData_t *data = ini_create_data();
+    ASSERT_TRUE(ini_enable_index(data));
+    ASSERT_TRUE(ini_has_section(data, "first") == NULL);
+    ini_disable_index(data);
+
+    ini_add_section(data, "first");
+    ASSERT_TRUE(ini_enable_index(data));
+    ASSERT_TRUE(ini_get_value(data, "first", "key") == NULL);
+    ini_add_pair(data, "first", INI_PAIR("key", "value"));
+
+    char name[32];
+    for (int i = 0; i < 1000; i++)
+    {
+        snprintf(name, sizeof(name), "section%d", i);
+        ASSERT_TRUE(ini_add_section(data, name) != NULL);
+        ASSERT_TRUE(ini_add_pair(data, name, INI_PAIR("key", "value")) != NULL);
+        ASSERT_TRUE(ini_add_pair(data, name, INI_PAIR("other_key", "other_value")) != NULL);
+    }
+
+    ASSERT_TRUE(ini_add_section(data, "section500") == NULL);
+    ASSERT_STREQ(ini_get_value(data, "first", "key"), "value");
+    ASSERT_STREQ(ini_get_value(data, "section0", "key"), "value");
+    ASSERT_STREQ(ini_get_value(data, "section999", "other_key"), "other_value");
+    ASSERT_TRUE(ini_get_value(data, "first", "other_key") == NULL);
+    ASSERT_TRUE(ini_get_value(data, "section1000", "key") == NULL);
+
+    const char contents[] = "[section42]\n"
+                            "key=changed\n"
+                            "[read]\n"
+                            "key=read\n";
+    ASSERT_TRUE(ini_read_buffer(contents, strlen(contents), data, NULL, INI_ALLOW_DUPLICATE_SECTIONS | INI_DUPLICATE_KEYS_OVERWRITE) != NULL);
+    ASSERT_STREQ(ini_get_value(data, "section42", "key"), "changed");
+    ASSERT_STREQ(ini_get_value(data, "read", "key"), "read");
+
+    ini_disable_index(data);
+    ASSERT_STREQ(ini_get_value(data, "section999", "key"), "value");
+    ini_free_data(data);
+}
+
+
+
+TEST(queries, keyed)
+{
+    const INIKey_t rate = ini_key("limits", "rate");
+    const INIKey_t missing = ini_key("limits", "burst");
+    ASSERT_EQ(rate.section_length, 6);
+    ASSERT_EQ(rate.key_length, 4);
+
+    const char contents[] = "[other]\nrate = 1\n[limits]\nrate = 250\nname = fast\nratio = 0.5\non = true\n";
+    for (int indexed = 0; indexed < 2; indexed++)
+    {
+        INIData_t *data = ini_read_buffer(contents, sizeof(contents) - 1, ini_create_data(), NULL, 0);
+        if (indexed) ASSERT_TRUE(ini_enable_index(data));
+
+        ASSERT_EQ(ini_get_unsigned_k(data, &rate, 0), 250);
+        ASSERT_EQ(ini_get_signed_k(data, &rate, 0), 250);
+        ASSERT_EQ(ini_get_hex_k(data, &rate, 0), 0x250);
+        ASSERT_TRUE(ini_get_int64_k(data, &rate, 0, NULL) == 250);
+        ASSERT_EQ(ini_get_unsigned_k(data, &missing, 7), 7);
+        ASSERT_TRUE(ini_get_value_k(data, &missing) == NULL);
+
+        const INIKey_t name = ini_key("limits", "name");
+        const INIKey_t ratio = ini_key("limits", "ratio");
+        const INIKey_t on = ini_key("limits", "on");
+        ASSERT_STREQ(ini_get_string_k(data, &name, ""), "fast");
+        ASSERT_TRUE(ini_get_double_k(data, &ratio, 0, NULL) == 0.5);
+        ASSERT_TRUE(ini_get_float_k(data, &ratio, 0) == 0.5);
+        ASSERT_TRUE(ini_get_bool_k(data, &on, false));
+        ini_free_data(data);
+    }
+
+    // Descriptors outlive the databases they were used with
+    const char reloaded[] = "[limits]\nrate = 500\n";
+    INIData_t *data = ini_read_buffer(reloaded, sizeof(reloaded) - 1, ini_create_data(), NULL, 0);
+    ASSERT_EQ(ini_get_unsigned_k(data, &rate, 0), 500);
+    ASSERT_TRUE(ini_get_value_k(NULL, &rate) == NULL);
+    ini_free_data(data);
+}
+
+
+
+TEST(queries, handles)
+{
+    INIData_t *data = ini_create_data();
+    INISection_t *section = ini_add_section(data, "limits");
+    ini_add_pair_to_section(section, INI_PAIR("rate", "250"));
+
+    INIHandle_t rate = ini_resolve(data, "limits", "rate");
+    INIHandle_t burst = ini_resolve(data, "limits", "burst");
+    ASSERT_TRUE(rate.pair != NULL);
+    ASSERT_TRUE(burst.pair == NULL);
+    ASSERT_EQ(ini_handle_get_unsigned(data, &rate, 0), 250);
+    ASSERT_EQ(ini_handle_get_unsigned(data, &burst, 5), 5);
+
+    // Growing the database moves pairs and sections, which handles follow
+    const uint64_t generation = data->generation;
+    char name[32];
+    for (int i = 0; i < 100; i++)
+    {
+        snprintf(name, sizeof(name), "section%d", i);
+        ini_add_section(data, name);
+    }
+    section = ini_has_section(data, "limits");
+    for (int i = 0; i < 100; i++)
+        ini_add_pair_to_section(section, INI_PAIR("other", "1"));
+    ini_add_pair_to_section(section, INI_PAIR("burst", "50"));
+    ASSERT_TRUE(data->generation != generation);
+
+    ASSERT_EQ(ini_handle_get_unsigned(data, &rate, 0), 250);
+    ASSERT_TRUE(rate.pair == &section->pairs[0]);
+    ASSERT_TRUE(rate.generation == data->generation);
+    ASSERT_EQ(ini_handle_get_signed(data, &burst, 5), 50);
+    ASSERT_STREQ(ini_handle_get_string(data, &burst, ""), "50");
+
+    // And so do reloads
+    const char contents[] = "[limits]\nrate = 500\nratio = 0.25\nenabled = true\n";
+    INIData_t *reloaded = ini_read_buffer(contents, sizeof(contents) - 1, ini_create_data(), NULL, INI_LAZY_SECTIONS);
+    ASSERT_EQ(ini_handle_get_unsigned(reloaded, &rate, 0), 500);
+    ASSERT_EQ(ini_handle_get_hex(reloaded, &rate, 0), 0x500);
+    ASSERT_TRUE(ini_handle_get_int64(reloaded, &rate, 0, NULL) == 500);
+    ASSERT_TRUE(ini_handle_get_value(reloaded, &burst) == NULL);
+    ASSERT_EQ(ini_handle_get_unsigned(data, &rate, 0), 250);
+
+    INIHandle_t ratio = ini_resolve(reloaded, "limits", "ratio");
+    INIHandle_t enabled = ini_resolve(reloaded, "limits", "enabled");
+    ASSERT_TRUE(ini_handle_get_double(reloaded, &ratio, 0, NULL) == 0.25);
+    ASSERT_TRUE(ini_handle_get_float(reloaded, &ratio, 0) == 0.25);
+    ASSERT_TRUE(ini_handle_get_bool(reloaded, &enabled, false));
+    ini_free_data(reloaded);
+    ini_free_data(data);
+}
+
+
+
+TEST(queries, frozen)
+{
+    INIData_t *data = ini_create_data();
+    ini_add_section(data, "section");
+    ini_add_pair(data, "section", INI_PAIR("string", "value"));
+    ini_add_pair(data, "section", INI_PAIR("unsigned", "42"));
+    ini_add_pair(data, "section", INI_PAIR("signed", "-42"));
+    ini_add_pair(data, "section", INI_PAIR("hex", "ff"));
+    ini_add_pair(data, "section", INI_PAIR("float", "1.5"));
+    ini_add_pair(data, "section", INI_PAIR("bool", "true"));
+    ini_add_pair(data, "section", INI_PAIR("string", "duplicate"));
+
+    char name[32];
+    for (int i = 0; i < 1000; i++)
+    {
+        snprintf(name, sizeof(name), "section%d", i);
+        ini_add_section(data, name);
+        ini_add_pair(data, name, INI_PAIR("key", "value"));
+    }
+    ini_add_section(data, "empty");
+
+    INIFrozen_t *frozen = ini_freeze(data);
+    ini_free_data(data);
+    ASSERT_TRUE(frozen != NULL);
+
+    ASSERT_STREQ(ini_frozen_get_value(frozen, "section", "string"), "value");
+    ASSERT_STREQ(ini_frozen_get_string(frozen, "section", "missing", "default"), "default");
+    ASSERT_EQ(ini_frozen_get_unsigned(frozen, "section", "unsigned", 0), 42);
+    ASSERT_EQ(ini_frozen_get_signed(frozen, "section", "signed", 0), -42);
+    ASSERT_EQ(ini_frozen_get_hex(frozen, "section", "hex", 0), 255);
+    ASSERT_TRUE(ini_frozen_get_float(frozen, "section", "float", 0) == 1.5);
+    ASSERT_TRUE(ini_frozen_get_bool(frozen, "section", "bool", false));
+    ASSERT_TRUE(ini_frozen_get_value(frozen, "empty", "key") == NULL);
+    ASSERT_TRUE(ini_frozen_get_value(frozen, "section1000", "key") == NULL);
+    ASSERT_TRUE(ini_frozen_get_value(frozen, "section", "key") == NULL);
+    for (int i = 0; i < 1000; i++)
+    {
+        snprintf(name, sizeof(name), "section%d", i);
+        ASSERT_STREQ(ini_frozen_get_string(frozen, name, "key", ""), "value");
+    }
+
+    ini_free_frozen(frozen);
+}
+
+
+
+TEST(queries, frozen_empty)
+{
+    INIData_t *data = ini_create_data();
+    INIFrozen_t *frozen = ini_freeze(data);
+    ini_free_data(data);
+    ASSERT_TRUE(frozen != NULL);
+    ASSERT_TRUE(ini_frozen_get_value(frozen, "section", "key") == NULL);
+    ini_free_frozen(frozen);
+}
+
+
+
+#ifdef INI_TEST_INI2C
+#include "ini_test_defaults.h"
+
+TEST(queries, generated)
+{
+    const INIData_t *data = &ini_test_defaults;
+    ASSERT_EQ(data->section_count, 4);
+    ASSERT_STREQ(data->sections[0].name, "audio");
+    ASSERT_STREQ(data->sections[0].pairs[0].key, "device");
+
+    ASSERT_STREQ(ini_get_value(data, "window", "title"), "Hello, world?");
+    ASSERT_EQ(ini_get_unsigned(data, "window", "width", 0), 1280);
+    ASSERT_EQ(ini_get_signed(data, "window", "height", 0), 720);
+    ASSERT_FALSE(ini_get_bool(data, "window", "fullscreen", true));
+    ASSERT_TRUE(ini_get_float(data, "audio", "volume", 0) == 0.75);
+    ASSERT_TRUE(ini_get_double(data, "audio", "volume", 0, NULL) == 0.75);
+    ASSERT_STREQ(ini_get_string(data, "audio", "device", ""), "default");
+    ASSERT_TRUE(ini_has_section(data, "empty") != NULL);
+    ASSERT_TRUE(ini_get_value(data, "empty", "key") == NULL);
+    ASSERT_TRUE(ini_get_value(data, "audio", "width") == NULL);
+    ASSERT_TRUE(ini_has_section(data, "missing") == NULL);
+
+    // Numbers and booleans come converted
+    ASSERT_EQ(data->sections[3].cache[0].kind, INI_CACHED_BOOL);
+    ASSERT_EQ(data->sections[3].cache[3].kind, INI_CACHED_SIGNED);
+    ASSERT_EQ(data->sections[3].cache[2].kind, INI_CACHED_BUSY);
+    ASSERT_EQ(ini_get_hex(data, "window", "width", 0), 0x1280);
+    ASSERT_EQ(ini_get_signed(data, "numbers", "zero", 1), 0);
+    ASSERT_TRUE(ini_get_signed(data, "numbers", "min", 0) == LLONG_MIN);
+
+    // Conversions report the same as they do for the section read at runtime
+    const char numbers[] = "[numbers]\n"
+                           "huge = -99999999999999999999\n"
+                           "zero = -0\n"
+                           "min = -9223372036854775808\n";
+    const char *const keys[] = { "huge", "min", "zero" };
+    INIData_t *read = ini_create_data();
+    ASSERT_TRUE(ini_read_buffer(numbers, strlen(numbers), read, NULL, 0) != NULL);
+    int generated_status, read_status;
+    for (unsigned i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    {
+        ASSERT_TRUE(ini_get_int64(data, "numbers", keys[i], 1, &generated_status)
+                 == ini_get_int64(read, "numbers", keys[i], 1, &read_status));
+        ASSERT_EQ(generated_status, read_status);
+    }
+    ini_get_int64(data, "numbers", "huge", 0, &generated_status);
+    ASSERT_EQ(generated_status, INI_CONVERT_OVERFLOW);
+    ini_free_data(read);
+}
+#endif
+
+
+
 ///////////////////////
 //  Invalid Queries  //
 ///////////////////////
@@ -191,7 +843,7 @@ TEST(queries, duplicate_section)
 TEST(queries, add_pair_to_nonexistent_section)
 {
     INIData_t *data = ini_create_data();
-    const INIPair_t *pair = ini_add_pair(data, "section", (INIPair_t){"key", "value"});
+    const INIPair_t *pair = ini_add_pair(data, "section", INI_PAIR("key", "value"));
     ASSERT_TRUE(pair == NULL);
     ini_free_data(data);
 }
@@ -246,7 +898,7 @@ TEST(queries, get_invalid_unsigned)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "not unsigned"});
+    ini_add_pair(data, "section", INI_PAIR("key", "not unsigned"));
     const int val = (int)ini_get_unsigned(data, "section", "key", -1);
     ASSERT_EQ(val, -1);
     ini_free_data(data);
@@ -273,7 +925,7 @@ TEST(queries, get_invalid_signed)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "not signed"});
+    ini_add_pair(data, "section", INI_PAIR("key", "not signed"));
     const unsigned val = (unsigned)ini_get_signed(data, "section", "key", UINT_MAX);
     ASSERT_EQ(val, UINT_MAX);
     ini_free_data(data);
@@ -296,7 +948,7 @@ TEST(queries, get_invalid_hex)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "not hex"});
+    ini_add_pair(data, "section", INI_PAIR("key", "not hex"));
     const unsigned val = (unsigned)ini_get_hex(data, "section", "key", 0xDEADBEEF);
     ASSERT_EQ(val, 0xDEADBEEF);
     ini_free_data(data);
@@ -319,7 +971,7 @@ TEST(queries, get_invalid_float)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "not float"});
+    ini_add_pair(data, "section", INI_PAIR("key", "not float"));
     const float val = (float)ini_get_float(data, "section", "key", 9.18f);
     ASSERT_EQ(val, 9.18f);
     ini_free_data(data);
@@ -342,7 +994,7 @@ TEST(queries, get_invalid_bool_true)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "not bool"});
+    ini_add_pair(data, "section", INI_PAIR("key", "not bool"));
     const bool val = ini_get_bool(data, "section", "key", true);
     ASSERT_TRUE(val);
     ini_free_data(data);
@@ -365,7 +1017,7 @@ TEST(queries, get_invalid_bool_false)
 {
     INIData_t *data = ini_create_data();
     ini_add_section(data, "section");
-    ini_add_pair(data, "section", (INIPair_t){"key", "not bool"});
+    ini_add_pair(data, "section", INI_PAIR("key", "not bool"));
     const bool val = ini_get_bool(data, "section", "key", false);
     ASSERT_FALSE(val);
     ini_free_data(data);
@@ -0,0 +1,199 @@
+#include "rktest.h"
+#include "../ini.h"
+
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+
+typedef struct
+{
+    unsigned sections;
+    unsigned pairs;
+    char last_section[64];
+    char found[64];
+} StreamCounts_t;
+
+
+
+static bool count_section(void *user, INIView_t name)
+{
+    StreamCounts_t *counts = user;
+    counts->sections++;
+    snprintf(counts->last_section, sizeof(counts->last_section), "%.*s", (int)name.length, name.data);
+    return true;
+}
+
+
+
+static bool count_pair(void *user, INIView_t section, INIView_t key, INIView_t value)
+{
+    StreamCounts_t *counts = user;
+    counts->pairs++;
+    if (section.length == 8 && memcmp(section.data, "Section2", 8) == 0
+    &&  key.length == 6 && memcmp(key.data, "string", 6) == 0)
+        snprintf(counts->found, sizeof(counts->found), "%.*s", (int)value.length, value.data);
+    return true;
+}
+
+
+
+static bool stop_at_first_pair(void *user, INIView_t section, INIView_t key, INIView_t value)
+{
+    (void)section; (void)key; (void)value;
+    ((StreamCounts_t *)user)->pairs++;
+    return false;
+}
+
+
+
+static const INICallbacks_t callbacks = { count_section, count_pair };
+
+
+
+static const char contents[] = "[Section1]\n"
+                               "hello=world\n"
+                               "[Section2]\n"
+                               "boolean=true\n"
+                               "string=\"is a string\"  ; comment\n"
+                               "[Section1]\n"
+                               "float=1.0";
+
+
+
+TEST(stream, buffer)
+{
+    StreamCounts_t counts = {0};
+    ASSERT_TRUE(ini_stream_buffer(contents, sizeof(contents) - 1, &callbacks, &counts, NULL, 0));
+    ASSERT_EQ(counts.sections, 3);
+    ASSERT_EQ(counts.pairs, 4);
+    ASSERT_STREQ(counts.found, "is a string");
+    ASSERT_STREQ(counts.last_section, "Section1");
+}
+
+
+
+TEST(stream, file)
+{
+    FILE *file = tmpfile();
+    assert(file);
+    fputs(contents, file);
+    rewind(file);
+
+    StreamCounts_t counts = {0};
+    ASSERT_TRUE(ini_stream_file_pointer(file, &callbacks, &counts, NULL, 0));
+    fclose(file);
+    ASSERT_EQ(counts.sections, 3);
+    ASSERT_EQ(counts.pairs, 4);
+    ASSERT_STREQ(counts.found, "is a string");
+}
+
+
+
+TEST(stream, stop_early)
+{
+    const INICallbacks_t stopping = { NULL, stop_at_first_pair };
+    StreamCounts_t counts = {0};
+    ASSERT_TRUE(ini_stream_buffer(contents, sizeof(contents) - 1, &stopping, &counts, NULL, 0));
+    ASSERT_EQ(counts.pairs, 1);
+}
+
+
+
+TEST(stream, error)
+{
+    const char erroneous[] = "[Section]\n"
+                             "erroneous line\n"
+                             "key=value\n";
+
+    StreamCounts_t counts = {0};
+    INIError_t error;
+    ASSERT_FALSE(ini_stream_buffer(erroneous, sizeof(erroneous) - 1, &callbacks, &counts, &error, 0));
+    ASSERT_TRUE(error.encountered);
+    ASSERT_STREQ(error.line, "erroneous line\n");
+    ASSERT_EQ(counts.pairs, 0);
+}
+
+
+
+TEST(stream, continue_past_error)
+{
+    const char erroneous[] = "orphan=pair\n"
+                             "[Section]\n"
+                             "erroneous line\n"
+                             "key=value\n";
+
+    StreamCounts_t counts = {0};
+    ASSERT_TRUE(ini_stream_buffer(erroneous, sizeof(erroneous) - 1, &callbacks, &counts, NULL, INI_CONTINUE_PAST_ERROR));
+    ASSERT_EQ(counts.sections, 1);
+    ASSERT_EQ(counts.pairs, 1);
+}
+
+
+
+static bool count_value_bytes(void *user, INIView_t section, INIView_t key, INIView_t value)
+{
+    (void)section; (void)key;
+    *(size_t *)user += value.length;
+    return true;
+}
+
+
+
+static double seconds_since(const struct timespec *start)
+{
+    struct timespec end;
+    timespec_get(&end, TIME_UTC);
+    return (double)(end.tv_sec - start->tv_sec) + (double)(end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+
+// Buffers have their newlines found in bulk and their keys and values
+// scanned in blocks, against the same lines read one by one through
+// stdio. That includes the stdio read, yet it's the figure to beat.
+TEST(stream, buffer_speed)
+{
+    const size_t size = 16 << 20;
+    char *contents = malloc(size);
+    size_t length = 0;
+    for (unsigned i = 0; length + 256 < size; i++)
+    {
+        if (i % 40 == 0)
+            length += (size_t)snprintf(contents + length, size - length, "[section_%u]\n", i / 40);
+        length += (size_t)snprintf(contents + length, size - length, i % 2 ? "option_%u = %u\n"
+                                   : "option_%u = \"a longer value, %u of them\" ; a comment\n", i, i);
+    }
+
+    FILE *file = tmpfile();
+    assert(file);
+    fwrite(contents, 1, length, file);
+    rewind(file);
+
+    const INICallbacks_t counting = { NULL, count_value_bytes };
+    size_t buffered = 0, streamed = 0;
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+    ASSERT_TRUE(ini_stream_buffer(contents, length, &counting, &buffered, NULL, 0));
+    const double buffer = seconds_since(&start);
+
+    timespec_get(&start, TIME_UTC);
+    ASSERT_TRUE(ini_stream_file_pointer(file, &counting, &streamed, NULL, 0));
+    const double stdio = seconds_since(&start);
+
+    fclose(file);
+    free(contents);
+    ASSERT_EQ(buffered, streamed);
+#if defined(__OPTIMIZE__) && !defined(__SANITIZE_ADDRESS__)
+    // Built without optimizations or instrumented, the scanners lose
+    // the edge they have, and the figures say nothing
+    ASSERT_TRUE(buffer < stdio);
+#else
+    (void)buffer;
+    (void)stdio;
+#endif
+}
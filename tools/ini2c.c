@@ -0,0 +1,312 @@
+#include <ctype.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../ini.h"
+
+/*
+ * Generates a C source and header defining a database read from an .ini
+ * file at build time, so that it's queried with the ini_get_* functions
+ * without being parsed, allocated or indexed at startup:
+ *
+ *     ini2c <input.ini> <name> <output.c> <output.h>
+ *
+ * The header declares `extern const INIData_t name;`. Sections are sorted
+ * by name, pairs by key, and the hash index ini_enable_index() would build
+ * is written out with its hashes already computed. Values that are
+ * booleans or numbers are converted up front by the ini_get_* functions
+ * themselves, so they find them as if they had been asked for before. The generated
+ * source works with or without INI_COMPACT_STRINGS.
+ */
+
+
+
+static int compare_sections(const void *a, const void *b);
+static int compare_pairs(const void *a, const void *b);
+static bool is_identifier(const char *str);
+static void write_string(FILE *file, const char *str);
+static void write_slots(FILE *file, const char *name, const char *table, const INIIndexSlot_t *slots, size_t capacity);
+static void write_cached(FILE *file, const INIData_t *data, const INISection_t *section, unsigned pair);
+static bool write_header(const char *path, const char *name, const char *input);
+static bool write_source(const char *path, const char *header, const char *name, const char *input, const INIData_t *data);
+
+
+
+int main(int argc, char **argv)
+{
+    if (argc != 5 || !is_identifier(argv[2]))
+    {
+        fprintf(stderr, "usage: %s <input.ini> <name> <output.c> <output.h>\n", argv[0]);
+        return 2;
+    }
+
+    const char *input = argv[1];
+    const char *name = argv[2];
+
+    INIData_t *data = ini_create_data();
+    INIError_t error;
+    if (!data || !ini_read_file_path(input, data, &error, 0) || error.encountered)
+    {
+        if (data && error.encountered)
+            fprintf(stderr, "%s: %s\n%s\n%*s^\n", input, error.msg, error.line, (int)error.offset, "");
+        else
+            fprintf(stderr, "%s: couldn't be read\n", input);
+        ini_free_data(data);
+        return 1;
+    }
+
+    // Index positions are baked into the hashes, so sort first. Sections
+    // without pairs have no array to sort.
+    if (data->section_count)
+        qsort(data->sections, data->section_count, sizeof(INISection_t), compare_sections);
+    for (unsigned i = 0; i < data->section_count; i++)
+        if (data->sections[i].pair_count)
+            qsort(data->sections[i].pairs, data->sections[i].pair_count, sizeof(INIPair_t), compare_pairs);
+
+    if (!ini_enable_index(data))
+    {
+        fprintf(stderr, "%s: couldn't be indexed\n", input);
+        ini_free_data(data);
+        return 1;
+    }
+
+    // The source includes the header by name, expecting them side by side
+    const char *header = strrchr(argv[4], '/');
+    header = header ? header + 1 : argv[4];
+
+    const bool written = write_header(argv[4], name, input)
+                      && write_source(argv[3], header, name, input, data);
+    ini_free_data(data);
+    if (!written)
+    {
+        fprintf(stderr, "%s: couldn't write %s or %s\n", argv[0], argv[3], argv[4]);
+        return 1;
+    }
+    return 0;
+}
+
+
+
+static int compare_sections(const void *a, const void *b)
+{
+    return strcmp(((const INISection_t *)a)->name, ((const INISection_t *)b)->name);
+}
+
+
+
+static int compare_pairs(const void *a, const void *b)
+{
+    return strcmp(((const INIPair_t *)a)->key, ((const INIPair_t *)b)->key);
+}
+
+
+
+static bool is_identifier(const char *str)
+{
+    if (!isalpha((unsigned char)*str) && *str != '_') return false;
+    for (; *str; str++)
+        if (!isalnum((unsigned char)*str) && *str != '_')
+            return false;
+    return true;
+}
+
+
+
+// Writes str as a C string literal. Octal escapes are always three digits
+// so that they never run into the characters after them.
+static void write_string(FILE *file, const char *str)
+{
+    fputc('"', file);
+    for (; *str; str++)
+    {
+        const unsigned char c = (unsigned char)*str;
+        if (c == '"' || c == '\\' || c == '?')
+            fprintf(file, "\\%c", c);
+        else if (isprint(c))
+            fputc(c, file);
+        else
+            fprintf(file, "\\%03o", c);
+    }
+    fputc('"', file);
+}
+
+
+
+static void write_slots(FILE *file, const char *name, const char *table, const INIIndexSlot_t *slots, const size_t capacity)
+{
+    if (!capacity) return;
+
+    fprintf(file, "static const INIIndexSlot_t %s_%s_[] =\n{\n", name, table);
+    for (size_t i = 0; i < capacity; i++)
+        fprintf(file, "    { 0x%016llxull, %u, %u },\n", (unsigned long long)slots[i].hash, slots[i].section, slots[i].pair);
+    fprintf(file, "};\n\n");
+}
+
+
+
+// The database lives in read-only memory, so values that aren't converted
+// here are marked busy for the getters to convert them every time instead
+// of writing them back. The others are converted by the getters themselves
+// and written the way they cached them, status included, so the generated
+// database answers exactly like one read at runtime.
+static void write_cached(FILE *file, const INIData_t *data, const INISection_t *section, const unsigned pair)
+{
+    static const char *const statuses[] = { "CONVERTED", "CONVERT_TRAILING", "CONVERT_OVERFLOW" };
+
+    const char *key = section->pairs[pair].key;
+    const char *value = section->pairs[pair].value;
+    const char *digits = value + (value[0] == '-');
+
+    if (strcmp(value, "true") == 0 || strcmp(value, "false") == 0)
+        ini_get_bool(data, section->name, key, false);
+    else if (*digits && !digits[strspn(digits, "0123456789")])
+    {
+        if (digits != value) ini_get_signed(data, section->name, key, 0);
+        else ini_get_unsigned(data, section->name, key, 0);
+    }
+    else
+        ini_get_float(data, section->name, key, 0);
+
+    // Without a cache, or for values that aren't numbers, there's nothing
+    // to write
+    const INICachedValue_t *cached = section->cache ? &section->cache[pair] : NULL;
+    if (!cached || cached->kind == INI_CACHED_NONE || cached->kind == INI_CACHED_BUSY
+    ||  cached->status >= sizeof(statuses) / sizeof(statuses[0])
+    ||  (cached->kind == INI_CACHED_FLOAT && !isfinite(cached->value.f)))
+    {
+        fprintf(file, "    { .kind = INI_CACHED_BUSY },\n");
+        return;
+    }
+
+    const char *status = statuses[cached->status];
+    switch (cached->kind)
+    {
+        case INI_CACHED_BOOL:
+            fprintf(file, "    INI2C_CACHED_(BOOL, %s, b, %s),\n", status, cached->value.b ? "true" : "false");
+            break;
+
+        case INI_CACHED_UNSIGNED:
+            fprintf(file, "    INI2C_CACHED_(UNSIGNED, %s, u, %lluULL),\n", status, cached->value.u);
+            break;
+
+        // LLONG_MIN has no literal of its own, so it's written as -LLONG_MAX - 1
+        case INI_CACHED_SIGNED:
+            if (cached->value.s == LLONG_MIN)
+                fprintf(file, "    INI2C_CACHED_(SIGNED, %s, s, -%lldLL - 1),\n", status, LLONG_MAX);
+            else
+                fprintf(file, "    INI2C_CACHED_(SIGNED, %s, s, %lldLL),\n", status, cached->value.s);
+            break;
+
+        // Hexadecimal floats are exact
+        default:
+            fprintf(file, "    INI2C_CACHED_(FLOAT, %s, f, %LaL),\n", status, cached->value.f);
+            break;
+    }
+}
+
+
+
+static bool write_header(const char *path, const char *name, const char *input)
+{
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "// Generated by ini2c from %s. Do not edit.\n\n", input);
+    fprintf(file, "#ifndef INI2C_%s_H\n#define INI2C_%s_H\n\n", name, name);
+    fprintf(file, "#include \"ini.h\"\n\n");
+    fprintf(file, "// Only for the query functions, never to be modified or free'd\n");
+    fprintf(file, "extern const INIData_t %s;\n\n", name);
+    fprintf(file, "#endif\n");
+    return fclose(file) == 0;
+}
+
+
+
+static bool write_source(const char *path, const char *header, const char *name, const char *input, const INIData_t *data)
+{
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "// Generated by ini2c from %s. Do not edit.\n\n", input);
+    fprintf(file, "#include \"%s\"\n\n", header);
+
+    // The database is read-only, so the casts only satisfy the types of
+    // the structs
+    fprintf(file,
+            "#ifdef INI_COMPACT_STRINGS\n"
+            "    #define INI2C_PAIR_(k, v) { .key = k, .value = v, .key_length = sizeof(k) - 1, .value_length = sizeof(v) - 1 }\n"
+            "    #define INI2C_NAME_(n) .name = n, .name_length = sizeof(n) - 1\n"
+            "#else\n"
+            "    #define INI2C_PAIR_(k, v) { .key = k, .value = v }\n"
+            "    #define INI2C_NAME_(n) .name = n\n"
+            "#endif\n"
+            "#define INI2C_SECTION_(n, p, v, c) { INI2C_NAME_(n), .data = (INIData_t *)&%s, .pairs = (INIPair_t *)(p), .cache = (INICachedValue_t *)(v), .pair_count = c, .pair_allocation = c }\n"
+            "#define INI2C_CACHED_(k, s, m, v) { .kind = INI_CACHED_##k, .status = INI_##s, .value.m = v }\n\n",
+            name);
+
+    for (unsigned i = 0; i < data->section_count; i++)
+    {
+        const INISection_t *section = &data->sections[i];
+        if (!section->pair_count) continue;
+
+        fprintf(file, "static const INIPair_t %s_pairs_%u_[] =\n{\n", name, i);
+        for (unsigned j = 0; j < section->pair_count; j++)
+        {
+            fprintf(file, "    INI2C_PAIR_(");
+            write_string(file, section->pairs[j].key);
+            fprintf(file, ", ");
+            write_string(file, section->pairs[j].value);
+            fprintf(file, "),\n");
+        }
+        fprintf(file, "};\n\n");
+
+        fprintf(file, "static const INICachedValue_t %s_cache_%u_[] =\n{\n", name, i);
+        for (unsigned j = 0; j < section->pair_count; j++)
+            write_cached(file, data, section, j);
+        fprintf(file, "};\n\n");
+    }
+
+    if (data->section_count)
+    {
+        fprintf(file, "static const INISection_t %s_sections_[] =\n{\n", name);
+        for (unsigned i = 0; i < data->section_count; i++)
+        {
+            const INISection_t *section = &data->sections[i];
+            fprintf(file, "    INI2C_SECTION_(");
+            write_string(file, section->name);
+            if (section->pair_count)
+                fprintf(file, ", %s_pairs_%u_, %s_cache_%u_, %u),\n", name, i, name, i, section->pair_count);
+            else
+                fprintf(file, ", NULL, NULL, 0),\n");
+        }
+        fprintf(file, "};\n\n");
+    }
+
+    const INIIndex_t *index = data->index;
+    write_slots(file, name, "section_slots", index->sections, index->section_capacity);
+    write_slots(file, name, "pair_slots", index->pairs, index->pair_capacity);
+
+    fprintf(file, "static const INIIndex_t %s_index_ =\n{\n", name);
+    if (index->section_capacity)
+        fprintf(file, "    (INIIndexSlot_t *)%s_section_slots_, %zu, %zu,\n", name, index->section_capacity, index->section_count);
+    else
+        fprintf(file, "    NULL, 0, 0,\n");
+    if (index->pair_capacity)
+        fprintf(file, "    (INIIndexSlot_t *)%s_pair_slots_, %zu, %zu,\n", name, index->pair_capacity, index->pair_count);
+    else
+        fprintf(file, "    NULL, 0, 0,\n");
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "const INIData_t %s =\n{\n", name);
+    if (data->section_count)
+        fprintf(file, "    .sections = (INISection_t *)%s_sections_,\n", name);
+    fprintf(file, "    .section_count = %u,\n", data->section_count);
+    fprintf(file, "    .section_allocation = %u,\n", data->section_count);
+    fprintf(file, "    .index = (INIIndex_t *)&%s_index_,\n", name);
+    fprintf(file, "};\n");
+
+    return fclose(file) == 0;
+}